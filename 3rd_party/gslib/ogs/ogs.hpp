@@ -242,8 +242,8 @@ void *ogsHostMallocPinned(occa::device &device, size_t size, void *source, occa:
 
 #define USE_OOGS
 
-enum oogs_mode { OOGS_LOCAL, OOGS_DEFAULT, OOGS_HOSTMPI, OOGS_DEVICEMPI, OOGS_AUTO };
-enum oogs_modeExchange { OOGS_EX_PW, OOGS_EX_NBC };
+enum oogs_mode { OOGS_LOCAL, OOGS_DEFAULT, OOGS_HOSTMPI, OOGS_DEVICEMPI, OOGS_HIERARCHICAL, OOGS_AUTO };
+enum oogs_modeExchange { OOGS_EX_PW, OOGS_EX_NBC, OOGS_EX_PERSISTENT };
 
 typedef struct {
   int* sendcounts;
@@ -253,6 +253,17 @@ typedef struct {
   MPI_Comm comm;
 } nbc_t;
 
+typedef struct {
+  MPI_Request* reqs; // recvs followed by sends
+  int nRecv;
+  int nSend;
+  unsigned char* bufSend;
+  unsigned char* bufRecv;
+  int unitSize;
+} persistent_t;
+
+struct oogsHier_t;
+
 typedef struct {
 
   ogs_t *ogs;
@@ -274,6 +285,9 @@ typedef struct {
   oogs_modeExchange modeExchange;
 
   nbc_t nbc;
+  persistent_t persistent;
+
+  oogsHier_t *hier; // node aware exchange schedule (OOGS_HIERARCHICAL)
 
 } oogs_t;
 
@@ -1,5 +1,14 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <list>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include <unistd.h>
 #include <occa.hpp>
 
 #include "ogstypes.h"
@@ -203,6 +212,461 @@ static void pairwiseExchange(int unit_size, oogs_t *gs)
   MPI_CHECK(MPI_Waitall(pwd->comm[send].n + pwd->comm[recv].n, pwd->req, MPI_STATUSES_IGNORE));
 }
 
+static void persistentFree(oogs_t *gs)
+{
+  persistent_t *pc = &gs->persistent;
+  for (int i = 0; i < pc->nRecv + pc->nSend; i++) {
+    MPI_Request_free(&pc->reqs[i]);
+  }
+  free(pc->reqs);
+  pc->reqs = nullptr;
+  pc->nRecv = 0;
+  pc->nSend = 0;
+  pc->bufSend = nullptr;
+  pc->bufRecv = nullptr;
+  pc->unitSize = 0;
+}
+
+// (re)build the persistent requests if the buffers or the unit size changed
+static void persistentSetup(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  struct gs_data *hgs = (gs_data *)ogs->haloGshSym;
+  const void *execdata = hgs->r.data;
+  const struct pw_data *pwd = (pw_data *)execdata;
+
+  unsigned char *bufRecv = (unsigned char *)gs->o_bufRecv.ptr();
+  unsigned char *bufSend = (unsigned char *)gs->o_bufSend.ptr();
+  if (gs->mode != OOGS_DEVICEMPI) {
+    bufRecv = (unsigned char *)gs->bufRecv;
+    bufSend = (unsigned char *)gs->bufSend;
+  }
+
+  persistent_t *pc = &gs->persistent;
+  if (pc->reqs && pc->bufSend == bufSend && pc->bufRecv == bufRecv && pc->unitSize == unit_size) {
+    return;
+  }
+  persistentFree(gs);
+
+  pc->nRecv = pwd->comm[recv].n;
+  pc->nSend = pwd->comm[send].n;
+  pc->reqs = (MPI_Request *)calloc(pc->nRecv + pc->nSend + 1, sizeof(MPI_Request));
+  pc->bufSend = bufSend;
+  pc->bufRecv = bufRecv;
+  pc->unitSize = unit_size;
+
+  MPI_Request *req = pc->reqs;
+  {
+    unsigned char *buf = bufRecv;
+    const struct pw_comm_data *c = &pwd->comm[recv];
+    const uint *p, *pe, *size = c->size;
+    for (p = c->p, pe = p + c->n; p != pe; ++p) {
+      const int len = *(size++) * unit_size;
+      MPI_CHECK(MPI_Recv_init((void *)buf, len, MPI_UNSIGNED_CHAR, *p, *p, gs->comm, req++));
+      buf += len;
+    }
+  }
+  {
+    unsigned char *buf = bufSend;
+    const struct pw_comm_data *c = &pwd->comm[send];
+    const uint *p, *pe, *size = c->size;
+    for (p = c->p, pe = p + c->n; p != pe; ++p) {
+      const int len = *(size++) * unit_size;
+      MPI_CHECK(MPI_Send_init((void *)buf, len, MPI_UNSIGNED_CHAR, *p, gs->rank, gs->comm, req++));
+      buf += len;
+    }
+  }
+}
+
+static void persistentExchange(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  persistentSetup(unit_size, gs);
+  persistent_t *pc = &gs->persistent;
+
+  if (!gs->earlyPrepostRecv) {
+    MPI_CHECK(MPI_Startall(pc->nRecv, pc->reqs));
+  }
+
+  if (gs->mode != OOGS_DEVICEMPI) {
+    ogs->device.finish(); // waiting for send buffers to be ready
+  }
+
+  if (OGS_SYNC_RECV) {
+    MPI_Barrier(gs->comm);
+  }
+
+  MPI_CHECK(MPI_Startall(pc->nSend, pc->reqs + pc->nRecv));
+  MPI_CHECK(MPI_Waitall(pc->nRecv + pc->nSend, pc->reqs, MPI_STATUSES_IGNORE));
+}
+
+// two-level (node aware) exchange
+//   1. every rank hands its off-node messages to a gateway rank on its node (one message per gateway)
+//   2. gateways exchange one aggregated message per remote node pair
+//   3. gateways redistribute the received segments to the destination ranks on their node
+// on-node messages are exchanged directly, all counts and offsets are in units of unit_size
+struct oogsHier_t {
+  struct copy_t {
+    int from;
+    int to;
+    int n;
+  };
+
+  struct exchange_t {
+    std::vector<int> ranks;
+    std::vector<int> counts;
+    std::vector<int> offsets;
+    int total = 0;
+
+    void add(int rank, int count, int offset)
+    {
+      ranks.push_back(rank);
+      counts.push_back(count);
+      offsets.push_back(offset);
+      total += count;
+    }
+  };
+
+  MPI_Comm comm;
+  MPI_Comm nodeComm;
+  int nNodes;
+
+  exchange_t directSend, directRecv;
+
+  std::vector<copy_t> stage1Pack;
+  exchange_t stage1Send, stage1Recv; // nodeComm
+
+  std::vector<copy_t> stage2Pack;
+  exchange_t stage2Send, stage2Recv; // comm (gateway to gateway)
+
+  std::vector<copy_t> stage3Pack, stage3Unpack;
+  exchange_t stage3Send, stage3Recv; // nodeComm
+
+  std::vector<unsigned char> buf1Send, buf1Recv, buf2Send, buf2Recv, buf3Send, buf3Recv;
+  std::vector<MPI_Request> reqDirect, reqStage;
+};
+
+static oogsHier_t *hierarchicalSetup(oogs_t *gs, const struct pw_data *pwd)
+{
+  auto h = new oogsHier_t();
+
+  int rank, size;
+  MPI_Comm_rank(gs->comm, &rank);
+  MPI_Comm_size(gs->comm, &size);
+  MPI_Comm_dup(gs->comm, &h->comm);
+  MPI_Comm_split_type(gs->comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &h->nodeComm);
+
+  int localSize;
+  MPI_Comm_size(h->nodeComm, &localSize);
+
+  // node id and node local rank of every rank (nodes are numbered by their lowest rank)
+  int leader = rank;
+  MPI_Bcast(&leader, 1, MPI_INT, 0, h->nodeComm);
+  std::vector<int> leaders(size);
+  MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, gs->comm);
+
+  std::vector<int> nodeId(size);
+  std::vector<std::vector<int>> nodeRanks;
+  {
+    std::map<int, int> ids;
+    for (int p = 0; p < size; p++) {
+      auto it = ids.find(leaders[p]);
+      if (it == ids.end()) {
+        it = ids.emplace(leaders[p], nodeRanks.size()).first;
+        nodeRanks.emplace_back();
+      }
+      nodeId[p] = it->second;
+      nodeRanks[it->second].push_back(p);
+    }
+  }
+  h->nNodes = nodeRanks.size();
+  const int myNode = nodeId[rank];
+
+  // gateway handling the traffic of node <from> with node <to> (local rank on <from>)
+  auto gateway = [&](int from, int to) { return to % (int)nodeRanks[from].size(); };
+
+  // off-node message segment, node is the remote node
+  struct segment_t {
+    int gateway, node, src, dst, n, off;
+  };
+  std::vector<segment_t> sendSegs, recvSegs;
+
+  {
+    int off = 0;
+    const struct pw_comm_data *c = &pwd->comm[send];
+    for (int i = 0; i < c->n; i++) {
+      const int p = c->p[i];
+      const int n = c->size[i];
+      if (nodeId[p] == myNode) {
+        h->directSend.add(p, n, off);
+      } else {
+        sendSegs.push_back({gateway(myNode, nodeId[p]), nodeId[p], rank, p, n, off});
+      }
+      off += n;
+    }
+  }
+  {
+    int off = 0;
+    const struct pw_comm_data *c = &pwd->comm[recv];
+    for (int i = 0; i < c->n; i++) {
+      const int p = c->p[i];
+      const int n = c->size[i];
+      if (nodeId[p] == myNode) {
+        h->directRecv.add(p, n, off);
+      } else {
+        recvSegs.push_back({gateway(myNode, nodeId[p]), nodeId[p], p, rank, n, off});
+      }
+      off += n;
+    }
+  }
+
+  std::sort(sendSegs.begin(), sendSegs.end(), [](const segment_t &a, const segment_t &b) {
+    return std::tie(a.gateway, a.node, a.dst) < std::tie(b.gateway, b.node, b.dst);
+  });
+  std::sort(recvSegs.begin(), recvSegs.end(), [](const segment_t &a, const segment_t &b) {
+    return std::tie(a.gateway, a.node, a.src) < std::tie(b.gateway, b.node, b.src);
+  });
+
+  // hand the segment lists to the gateways
+  constexpr int Nmeta = 4;
+  auto sendToGateways = [&](const std::vector<segment_t> &segs) {
+    std::vector<int> sendCounts(localSize, 0), sendDispls(localSize, 0);
+    std::vector<int> meta;
+    for (auto &s : segs) {
+      sendCounts[s.gateway] += Nmeta;
+      meta.insert(meta.end(), {s.node, s.src, s.dst, s.n});
+    }
+    for (int i = 1; i < localSize; i++) {
+      sendDispls[i] = sendDispls[i - 1] + sendCounts[i - 1];
+    }
+
+    std::vector<int> recvCounts(localSize), recvDispls(localSize, 0);
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, h->nodeComm);
+    for (int i = 1; i < localSize; i++) {
+      recvDispls[i] = recvDispls[i - 1] + recvCounts[i - 1];
+    }
+
+    std::vector<int> recvMeta(recvDispls[localSize - 1] + recvCounts[localSize - 1]);
+    MPI_Alltoallv(meta.data(),
+                  sendCounts.data(),
+                  sendDispls.data(),
+                  MPI_INT,
+                  recvMeta.data(),
+                  recvCounts.data(),
+                  recvDispls.data(),
+                  MPI_INT,
+                  h->nodeComm);
+
+    // off is the segment position within the local rank's stage message
+    std::vector<segment_t> out;
+    for (int r = 0; r < localSize; r++) {
+      int off = 0;
+      for (int i = recvDispls[r]; i < recvDispls[r] + recvCounts[r]; i += Nmeta) {
+        out.push_back({r, recvMeta[i], recvMeta[i + 1], recvMeta[i + 2], recvMeta[i + 3], off});
+        off += recvMeta[i + 3];
+      }
+    }
+    return out;
+  };
+
+  // stage 1: pack off-node segments by gateway
+  {
+    int off = 0;
+    for (auto &s : sendSegs) {
+      if (h->stage1Send.ranks.empty() || h->stage1Send.ranks.back() != s.gateway) {
+        h->stage1Send.add(s.gateway, 0, off);
+      }
+      h->stage1Send.counts.back() += s.n;
+      h->stage1Send.total += s.n;
+      h->stage1Pack.push_back({s.off, off, s.n});
+      off += s.n;
+    }
+  }
+  auto gwSendSegs = sendToGateways(sendSegs);
+  {
+    int off = 0;
+    for (auto &s : gwSendSegs) {
+      if (h->stage1Recv.ranks.empty() || h->stage1Recv.ranks.back() != s.gateway) {
+        h->stage1Recv.add(s.gateway, 0, off);
+      }
+      h->stage1Recv.counts.back() += s.n;
+      h->stage1Recv.total += s.n;
+      s.off += h->stage1Recv.offsets.back();
+      off += s.n;
+    }
+  }
+
+  // stage 2: one message per node pair, both gateways order the segments by (src, dst)
+  auto gwRecvSegs = sendToGateways(recvSegs);
+  {
+    auto byNodeSrcDst = [](const segment_t &a, const segment_t &b) {
+      return std::tie(a.node, a.src, a.dst) < std::tie(b.node, b.src, b.dst);
+    };
+    std::sort(gwSendSegs.begin(), gwSendSegs.end(), byNodeSrcDst);
+
+    int off = 0;
+    for (auto &s : gwSendSegs) {
+      const int peer = nodeRanks[s.node][gateway(s.node, myNode)];
+      if (h->stage2Send.ranks.empty() || h->stage2Send.ranks.back() != peer) {
+        h->stage2Send.add(peer, 0, off);
+      }
+      h->stage2Send.counts.back() += s.n;
+      h->stage2Send.total += s.n;
+      h->stage2Pack.push_back({s.off, off, s.n});
+      off += s.n;
+    }
+
+    // remember the stage 3 position (local destination, offset) before reordering
+    std::vector<segment_t> segs = gwRecvSegs;
+    for (int i = 0; i < segs.size(); i++) {
+      segs[i].gateway = i;
+    }
+    std::sort(segs.begin(), segs.end(), byNodeSrcDst);
+
+    std::vector<int> pos(segs.size());
+    off = 0;
+    for (auto &s : segs) {
+      const int peer = nodeRanks[s.node][gateway(s.node, myNode)];
+      if (h->stage2Recv.ranks.empty() || h->stage2Recv.ranks.back() != peer) {
+        h->stage2Recv.add(peer, 0, off);
+      }
+      h->stage2Recv.counts.back() += s.n;
+      h->stage2Recv.total += s.n;
+      pos[s.gateway] = off;
+      off += s.n;
+    }
+
+    // stage 3: redistribute to the local destinations in the order they were announced
+    off = 0;
+    for (int i = 0; i < gwRecvSegs.size(); i++) {
+      const auto &s = gwRecvSegs[i];
+      if (h->stage3Send.ranks.empty() || h->stage3Send.ranks.back() != s.gateway) {
+        h->stage3Send.add(s.gateway, 0, off);
+      }
+      h->stage3Send.counts.back() += s.n;
+      h->stage3Send.total += s.n;
+      h->stage3Pack.push_back({pos[i], off, s.n});
+      off += s.n;
+    }
+  }
+  {
+    int off = 0;
+    for (auto &s : recvSegs) {
+      if (h->stage3Recv.ranks.empty() || h->stage3Recv.ranks.back() != s.gateway) {
+        h->stage3Recv.add(s.gateway, 0, off);
+      }
+      h->stage3Recv.counts.back() += s.n;
+      h->stage3Recv.total += s.n;
+      h->stage3Unpack.push_back({off, s.off, s.n});
+      off += s.n;
+    }
+  }
+
+  return h;
+}
+
+static void hierarchicalFree(oogsHier_t *h)
+{
+  MPI_Comm_free(&h->comm);
+  MPI_Comm_free(&h->nodeComm);
+  delete h;
+}
+
+static void hierarchicalPost(const oogsHier_t::exchange_t &ex,
+                             unsigned char *buf,
+                             int unit_size,
+                             int tag,
+                             MPI_Comm comm,
+                             bool isSend,
+                             std::vector<MPI_Request> &reqs)
+{
+  for (int i = 0; i < ex.ranks.size(); i++) {
+    MPI_Request req;
+    void *ptr = (void *)(buf + (size_t)ex.offsets[i] * unit_size);
+    const int len = ex.counts[i] * unit_size;
+    if (isSend) {
+      MPI_CHECK(MPI_Isend(ptr, len, MPI_UNSIGNED_CHAR, ex.ranks[i], tag, comm, &req));
+    } else {
+      MPI_CHECK(MPI_Irecv(ptr, len, MPI_UNSIGNED_CHAR, ex.ranks[i], tag, comm, &req));
+    }
+    reqs.push_back(req);
+  }
+}
+
+static void hierarchicalCopy(const std::vector<oogsHier_t::copy_t> &copies,
+                             const unsigned char *src,
+                             unsigned char *dst,
+                             int unit_size)
+{
+  for (auto &c : copies) {
+    memcpy(dst + (size_t)c.to * unit_size, src + (size_t)c.from * unit_size, (size_t)c.n * unit_size);
+  }
+}
+
+static void hierarchicalExchange(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  oogsHier_t *h = gs->hier;
+
+  auto resize = [unit_size](std::vector<unsigned char> &buf, int n) {
+    if (buf.size() < (size_t)n * unit_size) {
+      buf.resize((size_t)n * unit_size);
+    }
+  };
+  resize(h->buf1Send, h->stage1Send.total);
+  resize(h->buf1Recv, h->stage1Recv.total);
+  resize(h->buf2Send, h->stage2Send.total);
+  resize(h->buf2Recv, h->stage2Recv.total);
+  resize(h->buf3Send, h->stage3Send.total);
+  resize(h->buf3Recv, h->stage3Recv.total);
+
+  h->reqDirect.clear();
+  hierarchicalPost(h->directRecv, gs->bufRecv, unit_size, 0, h->comm, false, h->reqDirect);
+
+  h->reqStage.clear();
+  hierarchicalPost(h->stage1Recv, h->buf1Recv.data(), unit_size, 1, h->nodeComm, false, h->reqStage);
+
+  ogs->device.finish(); // waiting for send buffers to be ready
+
+  if (OGS_SYNC_RECV) {
+    MPI_Barrier(gs->comm);
+  }
+
+  hierarchicalPost(h->directSend, gs->bufSend, unit_size, 0, h->comm, true, h->reqDirect);
+
+  hierarchicalCopy(h->stage1Pack, gs->bufSend, h->buf1Send.data(), unit_size);
+  hierarchicalPost(h->stage1Send, h->buf1Send.data(), unit_size, 1, h->nodeComm, true, h->reqStage);
+  MPI_CHECK(MPI_Waitall(h->reqStage.size(), h->reqStage.data(), MPI_STATUSES_IGNORE));
+
+  h->reqStage.clear();
+  hierarchicalPost(h->stage2Recv, h->buf2Recv.data(), unit_size, 2, h->comm, false, h->reqStage);
+  hierarchicalCopy(h->stage2Pack, h->buf1Recv.data(), h->buf2Send.data(), unit_size);
+  hierarchicalPost(h->stage2Send, h->buf2Send.data(), unit_size, 2, h->comm, true, h->reqStage);
+  MPI_CHECK(MPI_Waitall(h->reqStage.size(), h->reqStage.data(), MPI_STATUSES_IGNORE));
+
+  h->reqStage.clear();
+  hierarchicalPost(h->stage3Recv, h->buf3Recv.data(), unit_size, 3, h->nodeComm, false, h->reqStage);
+  hierarchicalCopy(h->stage3Pack, h->buf2Recv.data(), h->buf3Send.data(), unit_size);
+  hierarchicalPost(h->stage3Send, h->buf3Send.data(), unit_size, 3, h->nodeComm, true, h->reqStage);
+  MPI_CHECK(MPI_Waitall(h->reqStage.size(), h->reqStage.data(), MPI_STATUSES_IGNORE));
+  hierarchicalCopy(h->stage3Unpack, h->buf3Recv.data(), gs->bufRecv, unit_size);
+
+  MPI_CHECK(MPI_Waitall(h->reqDirect.size(), h->reqDirect.data(), MPI_STATUSES_IGNORE));
+}
+
+static void exchange(int unit_size, oogs_t *gs)
+{
+  if (gs->mode == OOGS_HIERARCHICAL && gs->hier) {
+    hierarchicalExchange(unit_size, gs);
+  } else if (gs->modeExchange == OOGS_EX_NBC) {
+    neighborAllToAll(unit_size, gs);
+  } else if (gs->modeExchange == OOGS_EX_PERSISTENT) {
+    persistentExchange(unit_size, gs);
+  } else {
+    pairwiseExchange(unit_size, gs);
+  }
+}
+
 void occaGatherScatterLocal(const dlong NlocalGather,
                             const dlong NrowBlocks,
                             const occa::memory &o_bstart,
@@ -368,6 +832,171 @@ size_t typeBytes(const char *type)
   }
 }
 
+// persistent OOGS_AUTO decisions (rank 0 only), one line per setting:
+// <key> <mode> <modeExchange> <earlyPrepostRecv> <time>
+struct tuningRecord_t {
+  int mode;
+  int modeExchange;
+  int earlyPrepostRecv;
+  double time;
+};
+
+// numeric environment flag, unset or non-numeric values are 0
+static int envFlag(const char *name)
+{
+  const char *value = getenv(name);
+  return (value) ? std::atoi(value) : 0;
+}
+
+static std::string tuningDatabaseFile()
+{
+  return (getenv("NEKRS_CACHE_DIR")) ? std::string(getenv("NEKRS_CACHE_DIR")) + "/oogsTuning.db" : "";
+}
+
+static std::map<std::string, tuningRecord_t> &tuningDatabase()
+{
+  static std::map<std::string, tuningRecord_t> db;
+  static bool loaded = false;
+
+  if (!loaded) {
+    loaded = true;
+    std::ifstream f(tuningDatabaseFile());
+    std::string line;
+    while (std::getline(f, line)) {
+      std::istringstream is(line);
+      std::string key;
+      tuningRecord_t record;
+      if (is >> key >> record.mode >> record.modeExchange >> record.earlyPrepostRecv >> record.time) {
+        db[key] = record;
+      }
+    }
+  }
+
+  return db;
+}
+
+static void writeTuningDatabase()
+{
+  const auto fileName = tuningDatabaseFile();
+  // unique per job, other jobs may share the cache directory
+  char hostName[256] = {0};
+  gethostname(hostName, sizeof(hostName) - 1);
+  const auto tmpFileName = fileName + ".tmp." + std::string(hostName) + "." + std::to_string(getpid());
+  {
+    std::ofstream f(tmpFileName, std::ios::trunc);
+    f.precision(6);
+    for (const auto &[key, record] : tuningDatabase()) {
+      f << key << " " << record.mode << " " << record.modeExchange << " " << record.earlyPrepostRecv << " "
+        << std::scientific << record.time << "\n";
+    }
+  }
+  std::rename(tmpFileName.c_str(), fileName.c_str());
+}
+
+// the decision depends on the job layout, the communication pattern and the candidate set
+static std::string tuningKey(oogs_t *gs,
+                             const struct pw_data *pwd,
+                             int nVec,
+                             size_t Nbytes,
+                             bool overlap,
+                             const std::list<oogs_mode> &modes,
+                             const std::list<oogs_modeExchange> &modeExchanges)
+{
+  int size;
+  MPI_Comm_size(gs->comm, &size);
+
+  int nodes;
+  {
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(gs->comm, MPI_COMM_TYPE_SHARED, gs->rank, MPI_INFO_NULL, &nodeComm);
+    int localRank;
+    MPI_Comm_rank(nodeComm, &localRank);
+    MPI_Comm_free(&nodeComm);
+    nodes = (localRank == 0);
+    MPI_Allreduce(MPI_IN_PLACE, &nodes, 1, MPI_INT, MPI_SUM, gs->comm);
+  }
+
+  // global histogram of the message sizes in log2 bins
+  constexpr int Nbins = 32;
+  long long hist[Nbins] = {0};
+  {
+    const struct pw_comm_data *c = &pwd->comm[send];
+    for (int i = 0; i < c->n; i++) {
+      int bin = 0;
+      while (bin < Nbins - 1 && (1u << (bin + 1)) <= c->size[i]) {
+        bin++;
+      }
+      hist[bin]++;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, hist, Nbins, MPI_LONG_LONG_INT, MPI_SUM, gs->comm);
+
+  std::ostringstream key;
+  key << "np=" << size << ",nodes=" << nodes << ",nVec=" << nVec << ",wordSize=" << Nbytes
+      << ",overlap=" << overlap << ",device=" << gs->ogs->device.mode() << ",modes=";
+  for (auto const &mode : modes) {
+    key << mode;
+  }
+  key << "/";
+  for (auto const &modeExchange : modeExchanges) {
+    key << modeExchange;
+  }
+  key << ",hist=";
+  for (int bin = 0; bin < Nbins; bin++) {
+    if (hist[bin]) {
+      key << bin << ":" << hist[bin] << ";";
+    }
+  }
+  return key.str();
+}
+
+// returns true and applies the decision if a previous run has tuned the same setting
+static bool lookupTuning(const std::string &key,
+                         const std::list<oogs_mode> &modes,
+                         const std::list<oogs_modeExchange> &modeExchanges,
+                         oogs_t *gs)
+{
+  const int retune = envFlag("OOGS_RETUNE") > 0;
+  if (tuningDatabaseFile().empty() || retune) {
+    return false;
+  }
+
+  // rank 0 decides to keep the choice consistent across ranks
+  int record[3] = {-1, -1, -1};
+  if (gs->rank == 0 && tuningDatabase().count(key)) {
+    const auto &entry = tuningDatabase().at(key);
+    const bool validMode =
+        entry.mode == OOGS_DEFAULT || std::find(modes.begin(), modes.end(), entry.mode) != modes.end();
+    const bool validExchange =
+        std::find(modeExchanges.begin(), modeExchanges.end(), entry.modeExchange) != modeExchanges.end();
+    if (validMode && validExchange) {
+      record[0] = entry.mode;
+      record[1] = entry.modeExchange;
+      record[2] = entry.earlyPrepostRecv;
+    }
+  }
+  MPI_Bcast(record, 3, MPI_INT, 0, gs->comm);
+
+  if (record[0] < 0) {
+    return false;
+  }
+
+  gs->mode = (oogs_mode)record[0];
+  gs->modeExchange = (oogs_modeExchange)record[1];
+  gs->earlyPrepostRecv = record[2];
+  return true;
+}
+
+static void storeTuning(const std::string &key, oogs_t *gs, double time)
+{
+  if (tuningDatabaseFile().empty() || gs->rank != 0) {
+    return;
+  }
+
+  tuningDatabase()[key] = {gs->mode, gs->modeExchange, gs->earlyPrepostRecv, time};
+  writeTuningDatabase();
+}
+
 oogs_t *oogs::setup(ogs_t *ogs,
                     int nVec,
                     dlong stride,
@@ -393,17 +1022,14 @@ oogs_t *oogs::setup(ogs_t *ogs,
   MPI_Comm_rank(gs->comm, &rank);
   gs->rank = rank;
   gs->mode = gsMode;
+  gs->hier = nullptr;
+  gs->persistent = {};
 
   if (gsMode == OOGS_DEFAULT) {
     return gs;
   }
 
-  int nbcDeviceEnabled = 0;
-  if (getenv("OOGS_ENABLE_NBC_DEVICE")) {
-    if (std::stoi(getenv("OOGS_ENABLE_NBC_DEVICE")) > 0) {
-      nbcDeviceEnabled = 1;
-    }
-  }
+  const int nbcDeviceEnabled = envFlag("OOGS_ENABLE_NBC_DEVICE") > 0;
 
   std::list<oogs_mode> oogs_mode_list;
   oogs_mode_list.push_back(OOGS_LOCAL);
@@ -476,6 +1102,14 @@ oogs_t *oogs::setup(ogs_t *ogs,
       }
     }
     oogs_modeExchange_list.push_back(OOGS_EX_NBC);
+    oogs_modeExchange_list.push_back(OOGS_EX_PERSISTENT);
+
+    if (gsMode == OOGS_AUTO || gsMode == OOGS_HIERARCHICAL) {
+      gs->hier = hierarchicalSetup(gs, pwd);
+      if (gs->hier->nNodes > 1) {
+        oogs_mode_list.push_back(OOGS_HIERARCHICAL);
+      }
+    }
   }
 
   const auto ogsModeEnv = (getenv("OOGS_MODE")) ? std::string(getenv("OOGS_MODE")) : "";
@@ -496,9 +1130,16 @@ oogs_t *oogs::setup(ogs_t *ogs,
         oogs_modeExchange_list.push_back(OOGS_EX_PW);
       } else if (ogsModeEnv == "OOGS_HOSTMPI+OOGS_EX_NBC") {
         oogs_modeExchange_list.push_back(OOGS_EX_NBC);
+      } else if (ogsModeEnv == "OOGS_HOSTMPI+OOGS_EX_PERSISTENT") {
+        oogs_modeExchange_list.push_back(OOGS_EX_PERSISTENT);
       } else {
         err++;
       }
+    } else if (ogsModeEnv == "OOGS_HIERARCHICAL") {
+      if (gs->hier) {
+        oogs_mode_list.push_back(OOGS_HIERARCHICAL);
+      }
+
     } else if (ogsModeEnv.find("OOGS_DEVICEMPI") != std::string::npos) {
       oogs_mode_list.push_back(OOGS_DEVICEMPI);
 
@@ -507,6 +1148,8 @@ oogs_t *oogs::setup(ogs_t *ogs,
         oogs_modeExchange_list.push_back(OOGS_EX_PW);
       } else if (ogsModeEnv == "OOGS_DEVICEMPI+OOGS_EX_NBC") {
         oogs_modeExchange_list.push_back(OOGS_EX_NBC);
+      } else if (ogsModeEnv == "OOGS_DEVICEMPI+OOGS_EX_PERSISTENT") {
+        oogs_modeExchange_list.push_back(OOGS_EX_PERSISTENT);
       } else {
         err++;
       }
@@ -520,8 +1163,28 @@ oogs_t *oogs::setup(ogs_t *ogs,
     }
   }
 
-  if (gsMode == OOGS_AUTO) {
-    auto knlOverlapStr = (callback) ? "userKnlOverlap" : ""; 
+  const auto knlOverlapStr = (callback) ? "userKnlOverlap" : "";
+  const auto tuningKeyStr = (gsMode == OOGS_AUTO) ? tuningKey(gs,
+                                                              pwd,
+                                                              nVec,
+                                                              Nbytes,
+                                                              static_cast<bool>(callback),
+                                                              oogs_mode_list,
+                                                              oogs_modeExchange_list)
+                                                  : "";
+
+  const bool cachedTuning =
+      gsMode == OOGS_AUTO && lookupTuning(tuningKeyStr, oogs_mode_list, oogs_modeExchange_list, gs);
+  if (cachedTuning) {
+    if (gs->rank == 0) {
+      printf("using cached gs setting for wordSize=%d nFields=%d %s (mode=%d exchange=%d)\n",
+             (int)Nbytes,
+             nVec,
+             knlOverlapStr,
+             gs->mode,
+             gs->modeExchange);
+    }
+  } else if (gsMode == OOGS_AUTO) {
     if (gs->rank == 0) {
       printf("autotuning gs for wordSize=%d nFields=%d %s\n", Nbytes, nVec, knlOverlapStr);
     }
@@ -550,14 +1213,17 @@ oogs_t *oogs::setup(ogs_t *ogs,
         if (gs->mode == OOGS_DEFAULT && gs->modeExchange != OOGS_EX_PW) {
           continue;
         }
+        if (gs->mode == OOGS_HIERARCHICAL && gs->modeExchange != OOGS_EX_PW) {
+          continue;
+        }
         if (gs->modeExchange == OOGS_EX_NBC && gs->mode == OOGS_DEVICEMPI) {
           if (!nbcDeviceEnabled) {
             continue; // not supported yet by all MPI implementations
           }
         }
 
-        if ((gs->mode == OOGS_DEVICEMPI || gs->mode == OOGS_HOSTMPI) && 
-            gs->modeExchange == OOGS_EX_PW) {
+        if ((gs->mode == OOGS_DEVICEMPI || gs->mode == OOGS_HOSTMPI) &&
+            (gs->modeExchange == OOGS_EX_PW || gs->modeExchange == OOGS_EX_PERSISTENT)) {
           gs->earlyPrepostRecv = 1;
         } else {
           gs->earlyPrepostRecv = 0;
@@ -571,13 +1237,21 @@ oogs_t *oogs::setup(ogs_t *ogs,
             printf("pack/unpack host + hostBuffer MPI using pw:");
           }
 
-          const auto exchangeMethod = (gs->modeExchange == OOGS_EX_NBC) ? "nbc" : "pw";
+          auto exchangeMethod = "pw";
+          if (gs->modeExchange == OOGS_EX_NBC) {
+            exchangeMethod = "nbc";
+          } else if (gs->modeExchange == OOGS_EX_PERSISTENT) {
+            exchangeMethod = "persistent pw";
+          }
           if (gs->mode == OOGS_HOSTMPI) {
             printf("pack/unpack device + hostBuffer MPI using %s:", exchangeMethod);
           }
           if (gs->mode == OOGS_DEVICEMPI) {
             printf("pack/unpack device + deviceBuffer MPI using %s:", exchangeMethod);
           }
+          if (gs->mode == OOGS_HIERARCHICAL) {
+            printf("pack/unpack device + hostBuffer MPI using node aggregation:");
+          }
           fflush(stdout);
         }
 
@@ -645,6 +1319,8 @@ oogs_t *oogs::setup(ogs_t *ogs,
     gs->modeExchange = fastestModeExchange;
     gs->earlyPrepostRecv = fastestPrepostRecv;
     o_q.free();
+
+    storeTuning(tuningKeyStr, gs, elapsedMin);
   } else {
     gs->mode = gsMode;
     gs->modeExchange = OOGS_EX_PW;
@@ -655,25 +1331,31 @@ oogs_t *oogs::setup(ogs_t *ogs,
     }
   }
 
-  double elapsedMinMPI = std::numeric_limits<double>::max();
-  {
+  // only needed by the selected mode (the AUTO candidate holds two communicators)
+  if (gs->hier && gs->mode != OOGS_HIERARCHICAL) {
+    hierarchicalFree(gs->hier);
+    gs->hier = nullptr;
+  }
+  if (gs->persistent.reqs && gs->modeExchange != OOGS_EX_PERSISTENT) {
+    persistentFree(gs);
+  }
+
+  const size_t unit_size = nVec * Nbytes;
+  reallocBuffers(unit_size, gs);
+
+  // a cached decision skips the exchange benchmark too
+  if (!cachedTuning) {
+    double elapsedMinMPI = std::numeric_limits<double>::max();
     const int earlyPrepostRecv = gs->earlyPrepostRecv;
     gs->earlyPrepostRecv = 0;
     const int Ntests = 10;
 
-    const size_t unit_size = nVec * Nbytes;
-    reallocBuffers(unit_size, gs);
-
     for (int test = 0; test < Ntests; ++test) {
       device.finish();
       MPI_Barrier(gs->comm);
       const double tStart = MPI_Wtime();
 
-      if (gs->modeExchange == OOGS_EX_NBC) {
-        neighborAllToAll(unit_size, gs);
-      } else {
-        pairwiseExchange(unit_size, gs);
-      }
+      exchange(unit_size, gs);
       elapsedMinMPI = std::min(elapsedMinMPI, MPI_Wtime() - tStart);
     }
     gs->earlyPrepostRecv = earlyPrepostRecv;
@@ -836,7 +1518,10 @@ void oogs::start(const occa::memory &o_v,
 
     ogs->device.finish(); // buffers (send/recv) ready for MPI
 
-    if (gs->earlyPrepostRecv) {
+    if (gs->earlyPrepostRecv && gs->modeExchange == OOGS_EX_PERSISTENT) {
+      persistentSetup(unit_size, gs);
+      MPI_CHECK(MPI_Startall(gs->persistent.nRecv, gs->persistent.reqs));
+    } else if (gs->earlyPrepostRecv) {
       unsigned char *buf = (unsigned char *)gs->o_bufRecv.ptr();
       if (gs->mode != OOGS_DEVICEMPI) {
         buf = (unsigned char *)gs->bufRecv;
@@ -895,7 +1580,7 @@ void oogs::finish(const occa::memory &o_v,
     ogs->device.finish();
   }
 
-  if (gs->mode == OOGS_HOSTMPI) {
+  if (gs->mode == OOGS_HOSTMPI || gs->mode == OOGS_HIERARCHICAL) {
     ogs->device.setStream(ogs::dataStream);
 
     struct gs_data *hgs = (gs_data *)ogs->haloGshSym;
@@ -907,11 +1592,7 @@ void oogs::finish(const occa::memory &o_v,
     }
 
     ogsHostTic(gs->comm, 1);
-    if (gs->modeExchange == OOGS_EX_NBC) {
-      neighborAllToAll(unit_size, gs);
-    } else {
-      pairwiseExchange(unit_size, gs);
-    }
+    exchange(unit_size, gs);
     ogsHostToc();
 
     if (pwd->comm[recv].total) {
@@ -924,11 +1605,7 @@ void oogs::finish(const occa::memory &o_v,
 
   if (gs->mode == OOGS_DEVICEMPI) {
     ogsHostTic(gs->comm, 1);
-    if (gs->modeExchange == OOGS_EX_NBC) {
-      neighborAllToAll(unit_size, gs);
-    } else {
-      pairwiseExchange(unit_size, gs);
-    }
+    exchange(unit_size, gs);
     ogsHostToc();
   }
 
@@ -978,5 +1655,13 @@ void oogs::destroy(oogs_t *gs)
   gs->o_bufRecv.free();
   gs->o_bufSend.free();
 
+  if (gs->hier) {
+    hierarchicalFree(gs->hier);
+  }
+
+  if (gs->persistent.reqs) {
+    persistentFree(gs);
+  }
+
   free(gs);
 }
@@ -246,6 +246,12 @@ c fluid elements
       do i = 1,nelv
          call i8copy(vertex(1,i),vtx8((iwork(i)-1)*nlv+1),nlv)
       enddo
+#ifdef DPROCMAP
+      if (iand(meshPartitioner,8).ne.0) then ! locality ordering
+         call freorderElements(lglel,vertex,nelv,nlv,ierr)
+         call err_chk(ierr,'reorderElements fluid failed!$')
+      endif
+#endif
 
       cnt=0
 c solid elements
@@ -298,6 +304,13 @@ c solid elements
          do i = 1,nel
             call i8copy(vertex(1,nelv+i),vtx8((iwork(i)-1)*nlv+1),nlv)
          enddo
+#ifdef DPROCMAP
+         if (iand(meshPartitioner,8).ne.0) then
+            call freorderElements(lglel(nelv+1),vertex(1,nelv+1),
+     $                            nel,nlv,ierr)
+            call err_chk(ierr,'reorderElements solid failed!$')
+         endif
+#endif
       endif
 
 #ifdef DPROCMAP
@@ -1,3 +1,8 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "gslib.h"
 
 #if defined(PARRSB)
@@ -314,6 +319,199 @@ int redistributeData(int *nel_, long long *vl, long long *el, int *part, int *se
   return 0;
 }
 
+#if defined(PARRSB)
+/* per element cost weights (one double per global element id, written by nekRS)
+   applied on top of the unweighted partition: the ranks form a chain and every
+   rank hands elements to its neighbours until the weight per rank is balanced */
+typedef struct {
+  long long eid;
+  double w;
+  double x[3];
+  uint proc;
+} welem;
+
+static const long long *sortIds;
+
+static int cmpId(const void *a, const void *b)
+{
+  const long long ia = sortIds[*(const int *)a];
+  const long long ib = sortIds[*(const int *)b];
+  return (ia > ib) - (ia < ib);
+}
+
+static int cmpEid(const void *a, const void *b)
+{
+  const long long ia = ((const welem *)a)->eid;
+  const long long ib = ((const welem *)b)->eid;
+  return (ia > ib) - (ia < ib);
+}
+
+static const double *sortKeys;
+
+static int cmpKey(const void *a, const void *b)
+{
+  const double ka = sortKeys[*(const int *)a];
+  const double kb = sortKeys[*(const int *)b];
+  return (ka > kb) - (ka < kb);
+}
+
+/* collective, w[e] = weight of global element el[e], returns 1 if the file does not fit */
+static int readCostWeights(double *w, const long long *el, int nel, const char *file, struct comm *c)
+{
+  MPI_File fh;
+  MPI_Offset size;
+  MPI_Datatype view;
+  MPI_Aint *displs;
+  double *buf;
+  int *idx;
+  long long elMax = 0;
+  int e, ierr;
+
+  if (MPI_File_open(c->c, (char *)file, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+    return 1;
+
+  for (e = 0; e < nel; ++e)
+    if (el[e] > elMax) elMax = el[e];
+  MPI_Allreduce(MPI_IN_PLACE, &elMax, 1, MPI_LONG_LONG, MPI_MAX, c->c);
+  MPI_File_get_size(fh, &size);
+  if (size < elMax * (MPI_Offset)sizeof(double)) {
+    MPI_File_close(&fh);
+    return 1;
+  }
+
+  /* file views need increasing displacements */
+  idx = (int *)malloc((nel + 1) * sizeof(int));
+  displs = (MPI_Aint *)malloc((nel + 1) * sizeof(MPI_Aint));
+  buf = (double *)malloc((nel + 1) * sizeof(double));
+  for (e = 0; e < nel; ++e) idx[e] = e;
+  sortIds = el;
+  qsort(idx, nel, sizeof(int), cmpId);
+  for (e = 0; e < nel; ++e) displs[e] = (el[idx[e]] - 1) * sizeof(double);
+
+  MPI_Type_create_hindexed_block(nel, 1, displs, MPI_DOUBLE, &view);
+  MPI_Type_commit(&view);
+  MPI_File_set_view(fh, 0, MPI_DOUBLE, view, "native", MPI_INFO_NULL);
+  ierr = MPI_File_read_all(fh, buf, nel, MPI_DOUBLE, MPI_STATUS_IGNORE) != MPI_SUCCESS;
+  MPI_Type_free(&view);
+  MPI_File_close(&fh);
+
+  for (e = 0; e < nel; ++e) w[idx[e]] = buf[e];
+
+  free(idx);
+  free(displs);
+  free(buf);
+
+  MPI_Allreduce(MPI_IN_PLACE, &ierr, 1, MPI_INT, MPI_MAX, c->c);
+  return ierr;
+}
+
+/* collective, wel holds weight and centroid of the input elements el, part their owner
+   from the unweighted partitioner, on return part is the owner after rebalancing the
+   elements el (already moved to part) */
+static int costWeightedPart(int *part, const long long *el, int nel, welem *wel, int nelIn,
+                            struct comm *c)
+{
+  const int np = c->np, id = c->id;
+  struct crystal cr;
+  struct array arr;
+  welem *we;
+  double sum[2], mean, wMin, wMax, local, offset = 0, total, target, cum;
+  double cNbr[2][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}}, cOwn[4] = {0, 0, 0, 0};
+  double *key;
+  int *order;
+  int e, i, d;
+
+  /* weights relative to the mean of this element set, the clamp bounds the number of
+     elements per rank by twice the average (lelt is sized for it) */
+  sum[0] = sum[1] = 0;
+  for (e = 0; e < nelIn; ++e) {
+    if (!(wel[e].w > 0)) wel[e].w = 1;
+    sum[0] += wel[e].w;
+    sum[1] += 1;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, c->c);
+  mean = sum[0] / sum[1];
+  wMin = mean / sqrt(2.0);
+  wMax = mean * sqrt(2.0);
+  for (e = 0; e < nelIn; ++e) {
+    wel[e].w = (wel[e].w < wMin) ? wMin : (wel[e].w > wMax) ? wMax : wel[e].w;
+    wel[e].proc = part[e];
+  }
+
+  /* follow the elements to their owner */
+  array_init(welem, &arr, nelIn), arr.n = nelIn;
+  memcpy(arr.ptr, wel, nelIn * sizeof(welem));
+  crystal_init(&cr, c);
+  sarray_transfer(welem, &arr, proc, 0, &cr);
+  crystal_free(&cr);
+  if (arr.n != (uint)nel) {
+    array_free(&arr);
+    return 1;
+  }
+  we = (welem *)arr.ptr;
+  qsort(we, nel, sizeof(welem), cmpEid);
+
+  for (e = 0; e < nel; ++e) {
+    for (d = 0; d < 3; ++d) cOwn[d] += we[e].x[d];
+    cOwn[3] += 1;
+  }
+  if (cOwn[3] > 0)
+    for (d = 0; d < 3; ++d) cOwn[d] /= cOwn[3];
+
+  /* centroids of the neighbours in the chain */
+  MPI_Sendrecv(cOwn, 4, MPI_DOUBLE, (id + 1 < np) ? id + 1 : MPI_PROC_NULL, 0,
+               cNbr[0], 4, MPI_DOUBLE, (id > 0) ? id - 1 : MPI_PROC_NULL, 0, c->c, MPI_STATUS_IGNORE);
+  MPI_Sendrecv(cOwn, 4, MPI_DOUBLE, (id > 0) ? id - 1 : MPI_PROC_NULL, 1,
+               cNbr[1], 4, MPI_DOUBLE, (id + 1 < np) ? id + 1 : MPI_PROC_NULL, 1, c->c, MPI_STATUS_IGNORE);
+
+  /* order the local elements from the side of rank id-1 to the side of rank id+1 */
+  key = (double *)malloc((nel + 1) * sizeof(double));
+  order = (int *)malloc((nel + 1) * sizeof(int));
+  for (e = 0; e < nel; ++e) {
+    double dPrev = 0, dNext = 0;
+    for (d = 0; d < 3; ++d) {
+      dPrev += (we[e].x[d] - cNbr[0][d]) * (we[e].x[d] - cNbr[0][d]);
+      dNext += (we[e].x[d] - cNbr[1][d]) * (we[e].x[d] - cNbr[1][d]);
+    }
+    key[e] = ((cNbr[0][3] > 0) ? sqrt(dPrev) : 0) - ((cNbr[1][3] > 0) ? sqrt(dNext) : 0);
+    order[e] = e;
+  }
+  sortKeys = key;
+  qsort(order, nel, sizeof(int), cmpKey);
+
+  local = 0;
+  for (e = 0; e < nel; ++e) local += we[e].w;
+  MPI_Exscan(&local, &offset, 1, MPI_DOUBLE, MPI_SUM, c->c);
+  if (id == 0) offset = 0;
+  MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, c->c);
+  target = total / np;
+
+  /* cut the chain into np pieces of equal weight, key is reused for the new owner */
+  cum = offset;
+  for (i = 0; i < nel; ++i) {
+    const double w = we[order[i]].w;
+    int p = (int)((cum + 0.5 * w) / target);
+    key[order[i]] = (p < 0) ? 0 : (p >= np) ? np - 1 : p;
+    cum += w;
+  }
+
+  /* we is sorted by eid, part is indexed like el */
+  for (e = 0; e < nel; ++e) order[e] = e;
+  sortIds = el;
+  qsort(order, nel, sizeof(int), cmpId);
+  for (e = 0; e < nel; ++e) part[order[e]] = (int)key[e];
+
+  MPI_Allreduce(MPI_IN_PLACE, &local, 1, MPI_DOUBLE, MPI_MAX, c->c);
+  if (id == 0)
+    printf("cost weighted rebalance (max/avg rank weight was %.2f)\n", local / target);
+
+  free(key);
+  free(order);
+  array_free(&arr);
+  return 0;
+}
+#endif
+
 #define fpartMesh FORTRAN_UNPREFIXED(fpartmesh,FPARTMESH)
 void fpartMesh(long long *el, long long *vl, double *xyz, const int *lelt, int *nell, const int *nve,
                int *fcomm, int *fpartitioner, int *falgo, int *loglevel, int *rtval)
@@ -372,6 +570,31 @@ void fpartMesh(long long *el, long long *vl, double *xyz, const int *lelt, int *
   if (*loglevel > 2)
     printPartStat(vl, nel, nv, cext);
 
+  const char *weightFile = getenv("NEKRS_PARTITION_WEIGHTS");
+  const int nelIn = nel;
+  welem *wel = NULL;
+  if (weightFile) {
+    const int ndim = (nv == 8) ? 3 : 2;
+    double *w = (double *)malloc((nel + 1) * sizeof(double));
+    wel = (welem *)calloc(nel + 1, sizeof(welem));
+    if (readCostWeights(w, el, nel, weightFile, &comm)) {
+      if (comm.id == 0)
+        printf("ignoring cost weights %s (does not match the mesh)\n", weightFile);
+      free(wel);
+      wel = NULL;
+    } else {
+      for (e = 0; e < nel; ++e) {
+        int d;
+        wel[e].eid = el[e];
+        wel[e].w = w[e];
+        for (n = 0; n < nv; ++n)
+          for (d = 0; d < ndim; ++d)
+            wel[e].x[d] += xyz[(e * nv + n) * ndim + d] / nv;
+      }
+    }
+    free(w);
+  }
+
   ierr = parrsb_part_mesh(part, seq, vl, xyz, nel, nv, options, comm.c);
   if (ierr != 0)
     goto err;
@@ -380,6 +603,15 @@ void fpartMesh(long long *el, long long *vl, double *xyz, const int *lelt, int *
   if (ierr != 0)
     goto err;
 
+  if (wel) {
+    ierr = costWeightedPart(part, el, nel, wel, nelIn, &comm);
+    free(wel);
+    if (ierr == 0)
+      ierr = redistributeData(&nel, vl, el, part, NULL, nv, *lelt, &comm);
+    if (ierr != 0)
+      goto err;
+  }
+
   if (*loglevel > 2)
     printPartStat(vl, nel, nv, cext);
 
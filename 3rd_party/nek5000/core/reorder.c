@@ -0,0 +1,209 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "name.h"
+#include "reorder.h"
+
+static const long long *sortKeys;
+
+static int cmpKey(const void *a, const void *b)
+{
+  const long long ka = sortKeys[*(const int *)a];
+  const long long kb = sortKeys[*(const int *)b];
+  if (ka != kb) return (ka < kb) ? -1 : 1;
+  return *(const int *)a - *(const int *)b;
+}
+
+static const int *sortDegree;
+
+static int cmpDegree(const void *a, const void *b)
+{
+  const int da = sortDegree[*(const int *)a];
+  const int db = sortDegree[*(const int *)b];
+  if (da != db) return da - db;
+  return *(const int *)a - *(const int *)b;
+}
+
+/* BFS over the elements not ordered yet, returns the number of visited elements,
+   the depth of the level structure and the min degree element of the last level */
+static int levelStructure(int root, const int *adjPtr, const int *adj, const int *deg,
+                          const int *done, int *level, int *queue, int *depth, int *last)
+{
+  int head = 0, tail = 0;
+  int i, j;
+
+  level[root] = 0;
+  queue[tail++] = root;
+  while (head < tail) {
+    const int e = queue[head++];
+    for (j = adjPtr[e]; j < adjPtr[e + 1]; j++) {
+      const int f = adj[j];
+      if (done[f] || level[f] >= 0) continue;
+      level[f] = level[e] + 1;
+      queue[tail++] = f;
+    }
+  }
+
+  *depth = level[queue[tail - 1]];
+  *last = queue[tail - 1];
+  for (i = tail - 1; i >= 0 && level[queue[i]] == *depth; i--)
+    if (deg[queue[i]] < deg[*last]) *last = queue[i];
+
+  for (i = 0; i < tail; i++) level[queue[i]] = -1;
+  return tail;
+}
+
+int reorderElements(int *perm, const long long *vtx, int nel, int nv)
+{
+  const int n = nel * nv;
+  int *slot, *groupOfSlot, *group, *mark, *adjPtr, *adj, *deg, *done, *level, *queue;
+  int i, j, k, e, g, nGroups, nOrdered;
+
+  if (nel <= 0) return 0;
+
+  slot        = (int *)malloc(n * sizeof(int));
+  groupOfSlot = (int *)malloc(n * sizeof(int));
+  group       = (int *)malloc((n + 1) * sizeof(int));
+  mark        = (int *)malloc(nel * sizeof(int));
+  adjPtr      = (int *)malloc((nel + 1) * sizeof(int));
+  deg         = (int *)malloc(nel * sizeof(int));
+  done        = (int *)calloc(nel, sizeof(int));
+  level       = (int *)malloc(nel * sizeof(int));
+  queue       = (int *)malloc(nel * sizeof(int));
+  adj         = NULL;
+  if (!slot || !groupOfSlot || !group || !mark || !adjPtr || !deg || !done || !level || !queue)
+    goto err;
+
+  /* group the element vertex slots by global vertex id */
+  for (i = 0; i < n; i++) slot[i] = i;
+  sortKeys = vtx;
+  qsort(slot, n, sizeof(int), cmpKey);
+
+  nGroups = 0;
+  for (i = 0; i < n; i++) {
+    if (i == 0 || vtx[slot[i]] != vtx[slot[i - 1]]) group[nGroups++] = i;
+    groupOfSlot[slot[i]] = nGroups - 1;
+  }
+  group[nGroups] = n;
+
+  /* element graph in CSR format, two passes (count + fill) */
+  for (e = 0; e < nel; e++) mark[e] = -1;
+  adjPtr[0] = 0;
+  for (e = 0; e < nel; e++) {
+    int cnt = 0;
+    for (k = 0; k < nv; k++) {
+      g = groupOfSlot[e * nv + k];
+      for (j = group[g]; j < group[g + 1]; j++) {
+        const int f = slot[j] / nv;
+        if (f == e || mark[f] == e) continue;
+        mark[f] = e;
+        cnt++;
+      }
+    }
+    deg[e] = cnt;
+    adjPtr[e + 1] = adjPtr[e] + cnt;
+  }
+
+  adj = (int *)malloc((adjPtr[nel] > 0 ? adjPtr[nel] : 1) * sizeof(int));
+  if (!adj) goto err;
+
+  for (e = 0; e < nel; e++) mark[e] = -1;
+  for (e = 0; e < nel; e++) {
+    int cnt = adjPtr[e];
+    for (k = 0; k < nv; k++) {
+      g = groupOfSlot[e * nv + k];
+      for (j = group[g]; j < group[g + 1]; j++) {
+        const int f = slot[j] / nv;
+        if (f == e || mark[f] == e) continue;
+        mark[f] = e;
+        adj[cnt++] = f;
+      }
+    }
+    /* visit neighbours in increasing degree */
+    sortDegree = deg;
+    qsort(adj + adjPtr[e], deg[e], sizeof(int), cmpDegree);
+  }
+
+  /* Cuthill-McKee per connected component starting from a pseudo-peripheral element */
+  for (e = 0; e < nel; e++) level[e] = -1;
+  nOrdered = 0;
+  while (nOrdered < nel) {
+    int root = -1;
+    for (e = 0; e < nel; e++)
+      if (!done[e] && (root < 0 || deg[e] < deg[root])) root = e;
+
+    int depth, last, it;
+    levelStructure(root, adjPtr, adj, deg, done, level, queue, &depth, &last);
+    for (it = 0; it < 8; it++) {
+      int newDepth, newLast;
+      levelStructure(last, adjPtr, adj, deg, done, level, queue, &newDepth, &newLast);
+      if (newDepth <= depth) break;
+      root = last;
+      depth = newDepth;
+      last = newLast;
+    }
+
+    int head = nOrdered;
+    perm[nOrdered++] = root;
+    done[root] = 1;
+    while (head < nOrdered) {
+      const int c = perm[head++];
+      for (j = adjPtr[c]; j < adjPtr[c + 1]; j++) {
+        const int f = adj[j];
+        if (done[f]) continue;
+        done[f] = 1;
+        perm[nOrdered++] = f;
+      }
+    }
+  }
+
+  /* reverse */
+  for (i = 0; i < nel / 2; i++) {
+    const int tmp = perm[i];
+    perm[i] = perm[nel - 1 - i];
+    perm[nel - 1 - i] = tmp;
+  }
+
+  free(slot); free(groupOfSlot); free(group); free(mark); free(adjPtr);
+  free(adj); free(deg); free(done); free(level); free(queue);
+  return 0;
+
+err:
+  free(slot); free(groupOfSlot); free(group); free(mark); free(adjPtr);
+  free(adj); free(deg); free(done); free(level); free(queue);
+  return 1;
+}
+
+/* permute lglel and vertex of the local elements in place */
+#define freorderElements FORTRAN_UNPREFIXED(freorderelements,FREORDERELEMENTS)
+void freorderElements(int *eg, long long *vtx, const int *nell, const int *nve, int *ierr)
+{
+  const int nel = *nell;
+  const int nv = *nve;
+  int *perm, *egOld;
+  long long *vtxOld;
+  int e;
+
+  *ierr = 0;
+  if (nel <= 1) return;
+
+  perm   = (int *)malloc(nel * sizeof(int));
+  egOld  = (int *)malloc(nel * sizeof(int));
+  vtxOld = (long long *)malloc((size_t)nel * nv * sizeof(long long));
+  if (!perm || !egOld || !vtxOld || reorderElements(perm, vtx, nel, nv)) {
+    free(perm); free(egOld); free(vtxOld);
+    *ierr = 1;
+    return;
+  }
+
+  memcpy(egOld, eg, nel * sizeof(int));
+  memcpy(vtxOld, vtx, (size_t)nel * nv * sizeof(long long));
+  for (e = 0; e < nel; e++) {
+    eg[e] = egOld[perm[e]];
+    memcpy(vtx + (size_t)e * nv, vtxOld + (size_t)perm[e] * nv, nv * sizeof(long long));
+  }
+
+  free(perm);
+  free(egOld);
+  free(vtxOld);
+}
@@ -0,0 +1,18 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* local element ordering improving memory locality (reverse Cuthill-McKee on
+   the element graph, two elements are neighbours if they share a vertex)
+     perm[i] = old local index of the element placed at position i
+     vtx     = global vertex ids, nv per element */
+int reorderElements(int *perm, const long long *vtx, int nel, int nv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,6 +10,14 @@ add_executable(fdm-bin src/bench/fdm/main.cpp)
 set_target_properties(fdm-bin PROPERTIES LINKER_LANGUAGE CXX OUTPUT_NAME nekrs-bench-fdm)
 target_link_libraries(fdm-bin PRIVATE nekrs-lib)
 
+add_executable(compression-bin src/bench/fldCompression/main.cpp)
+set_target_properties(compression-bin PROPERTIES LINKER_LANGUAGE CXX OUTPUT_NAME nekrs-bench-compression)
+target_link_libraries(compression-bin PRIVATE nekrs-lib)
+
+add_executable(gs-bin src/bench/gs/main.cpp 3rd_party/nek5000/core/reorder.c)
+set_target_properties(gs-bin PROPERTIES LINKER_LANGUAGE CXX OUTPUT_NAME nekrs-bench-gs)
+target_link_libraries(gs-bin PRIVATE nekrs-lib)
+
 set(BENCH_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/bench)
 set(BENCH_SOURCES
         ${BENCH_SOURCE_DIR}/fdm/benchmarkFDM.cpp
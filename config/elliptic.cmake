@@ -3,7 +3,9 @@ set(ELLIPTIC_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/solvers/elliptic)
 set(ELLIPTIC_SOURCES
         ${ELLIPTIC_SOURCE_DIR}/linearSolver/PCG.cpp
         ${ELLIPTIC_SOURCE_DIR}/linearSolver/PGMRES.cpp
+        ${ELLIPTIC_SOURCE_DIR}/linearSolver/GCRODR.cpp
         ${ELLIPTIC_SOURCE_DIR}/amgSolver/amgx/AMGX.cpp
+        ${ELLIPTIC_SOURCE_DIR}/amgSolver/sa/SAAMG.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticApplyMask.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticUpdateJacobi.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticBuildPreconditionerKernels.cpp
@@ -5,6 +5,7 @@ set(MESH_SOURCES
     ${MESH_SOURCE_DIR}/meshSurfaceIntegral.cpp
     ${MESH_SOURCE_DIR}/meshDistance.cpp
     ${MESH_SOURCE_DIR}/meshNekReader.cpp
+    ${MESH_SOURCE_DIR}/meshCostWeights.cpp
     ${MESH_SOURCE_DIR}/meshPhysicalNodesHex3D.cpp
     ${MESH_SOURCE_DIR}/meshGlobalIds.cpp
     ${MESH_SOURCE_DIR}/meshBasis1D.cpp
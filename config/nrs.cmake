@@ -6,6 +6,9 @@ include(config/gslib.cmake)
 set(NRS_SRC 
     src/lib/nekrs.cpp
     src/io/writeFld.cpp
+    src/io/fldWriter.cpp
+    src/io/fldReader.cpp
+    src/io/fldCompression.cpp
     src/io/fileUtils.cpp
     src/utils/sha1.cpp
     src/utils/inipp.cpp
@@ -114,6 +117,7 @@ set(NRS_INCLUDE
     PRIVATE
     ${ELLIPTIC_SOURCE_DIR}/amgSolver/hypre
     ${ELLIPTIC_SOURCE_DIR}/amgSolver/amgx
+    ${ELLIPTIC_SOURCE_DIR}/amgSolver/sa
     ${ELLIPTIC_SOURCE_DIR}/MG
 )
 
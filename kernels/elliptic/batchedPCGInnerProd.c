@@ -0,0 +1,16 @@
+// per field weighted inner products (x_fld, y_fld)
+extern "C" void FUNC(batchedPCGInnerProd)(const dlong &Nblock,
+                                          const dlong &N,
+                                          const dlong &offset,
+                                          const dfloat *__restrict__ weights,
+                                          const dfloat *__restrict__ x,
+                                          const dfloat *__restrict__ y,
+                                          dfloat *__restrict__ reduction)
+{
+  for (int fld = 0; fld < p_Nfields; ++fld) {
+    dfloat sum = 0;
+    for (dlong n = 0; n < N; ++n)
+      sum += weights[n] * x[n + fld * offset] * y[n + fld * offset];
+    reduction[fld] = sum;
+  }
+}
@@ -0,0 +1,24 @@
+// x_fld += alpha_fld p_fld, r_fld -= alpha_fld Ap_fld and per field (r_fld, r_fld)
+extern "C" void FUNC(batchedPCGUpdate)(const dlong &Nblock,
+                                       const dlong &N,
+                                       const dlong &offset,
+                                       const dfloat *__restrict__ weights,
+                                       const dfloat *__restrict__ alpha,
+                                       const dfloat *__restrict__ p,
+                                       const dfloat *__restrict__ Ap,
+                                       dfloat *__restrict__ x,
+                                       dfloat *__restrict__ r,
+                                       dfloat *__restrict__ reduction)
+{
+  for (int fld = 0; fld < p_Nfields; ++fld) {
+    dfloat sum = 0;
+    for (dlong n = 0; n < N; ++n) {
+      const dlong id = n + fld * offset;
+      const dfloat rn = r[id] - alpha[fld] * Ap[id];
+      x[id] += alpha[fld] * p[id];
+      r[id] = rn;
+      sum += weights[n] * rn * rn;
+    }
+    reduction[fld] = sum;
+  }
+}
@@ -0,0 +1,14 @@
+// p_fld = z_fld + beta_fld p_fld
+extern "C" void FUNC(batchedPCGUpdateP)(const dlong &N,
+                                        const dlong &offset,
+                                        const dfloat *__restrict__ beta,
+                                        const dfloat *__restrict__ z,
+                                        dfloat *__restrict__ p)
+{
+  for (int fld = 0; fld < p_Nfields; ++fld) {
+    for (dlong n = 0; n < N; ++n) {
+      const dlong id = n + fld * offset;
+      p[id] = z[id] + beta[fld] * p[id];
+    }
+  }
+}
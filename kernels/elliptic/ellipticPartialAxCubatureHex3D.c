@@ -0,0 +1,167 @@
+#if p_lambda == 1
+#ifdef p_poisson
+#define p_NcubFields 2
+#else
+#define p_NcubFields 3
+#endif
+#else
+#define p_NcubFields 1
+#endif
+
+extern "C" void FUNC(ellipticPartialAxCubatureHex3D)(const dlong & Nelements,
+                        const dlong & offset,
+                        const dlong & loffset,
+                        const dlong* __restrict__ elementList,
+                        const dfloat* __restrict__ cubvgeo,
+                        const dfloat* __restrict__ cubInterpT,
+                        const dfloat* __restrict__ cubD,
+                        const dfloat* __restrict__ lambda0,
+                        const dfloat* __restrict__ lambda1,
+                        const dfloat* __restrict__ q,
+                        dfloat* __restrict__ Aq )
+{
+  dfloat s_q[p_Nq][p_Nq][p_Nq];
+  dfloat s_tmp1[p_Nq][p_Nq][p_cubNq];
+  dfloat s_tmp2[p_Nq][p_cubNq][p_cubNq];
+  dfloat s_cub[p_NcubFields][p_cubNq][p_cubNq][p_cubNq];
+  dfloat s_Fr[p_cubNq][p_cubNq][p_cubNq];
+  dfloat s_Fs[p_cubNq][p_cubNq][p_cubNq];
+  dfloat s_Ft[p_cubNq][p_cubNq][p_cubNq];
+  dfloat s_V[p_cubNq][p_cubNq][p_cubNq];
+
+#ifdef __NEKRS__OMP__
+  #pragma omp parallel for private(s_q, s_tmp1, s_tmp2, s_cub, s_Fr, s_Fs, s_Ft, s_V)
+#endif
+  for(dlong e = 0; e < Nelements; ++e) {
+    const dlong element = elementList[e];
+
+    // interpolate q (and the coefficients) to the cubature points
+    for(int fld = 0; fld < p_NcubFields; ++fld) {
+      const dfloat* __restrict__ src = q;
+#if p_lambda == 1
+      if(fld == 1) src = lambda0;
+      if(fld == 2) src = lambda1;
+#endif
+      for(int c = 0; c < p_Nq; ++c)
+        for(int b = 0; b < p_Nq; ++b)
+          for(int a = 0; a < p_Nq; ++a)
+            s_q[c][b][a] = src[element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a];
+
+      for(int c = 0; c < p_Nq; ++c)
+        for(int b = 0; b < p_Nq; ++b)
+          for(int i = 0; i < p_cubNq; ++i) {
+            dfloat tmp = 0;
+            for(int a = 0; a < p_Nq; ++a)
+              tmp += cubInterpT[a * p_cubNq + i] * s_q[c][b][a];
+            s_tmp1[c][b][i] = tmp;
+          }
+
+      for(int c = 0; c < p_Nq; ++c)
+        for(int j = 0; j < p_cubNq; ++j)
+          for(int i = 0; i < p_cubNq; ++i) {
+            dfloat tmp = 0;
+            for(int b = 0; b < p_Nq; ++b)
+              tmp += cubInterpT[b * p_cubNq + j] * s_tmp1[c][b][i];
+            s_tmp2[c][j][i] = tmp;
+          }
+
+      for(int k = 0; k < p_cubNq; ++k)
+        for(int j = 0; j < p_cubNq; ++j)
+          for(int i = 0; i < p_cubNq; ++i) {
+            dfloat tmp = 0;
+            for(int c = 0; c < p_Nq; ++c)
+              tmp += cubInterpT[c * p_cubNq + k] * s_tmp2[c][j][i];
+            s_cub[fld][k][j][i] = tmp;
+          }
+    }
+
+    for(int k = 0; k < p_cubNq; ++k)
+      for(int j = 0; j < p_cubNq; ++j)
+        for(int i = 0; i < p_cubNq; ++i) {
+          dfloat Ur = 0, Us = 0, Ut = 0;
+          for(int n = 0; n < p_cubNq; ++n) {
+            Ur += cubD[i * p_cubNq + n] * s_cub[0][k][j][n];
+            Us += cubD[j * p_cubNq + n] * s_cub[0][k][n][i];
+            Ut += cubD[k * p_cubNq + n] * s_cub[0][n][j][i];
+          }
+
+          const dlong gid = element * p_cubNp * p_Nvgeo + k * p_cubNq * p_cubNq + j * p_cubNq + i;
+          const dfloat rx = cubvgeo[gid + p_RXID * p_cubNp];
+          const dfloat ry = cubvgeo[gid + p_RYID * p_cubNp];
+          const dfloat rz = cubvgeo[gid + p_RZID * p_cubNp];
+          const dfloat sx = cubvgeo[gid + p_SXID * p_cubNp];
+          const dfloat sy = cubvgeo[gid + p_SYID * p_cubNp];
+          const dfloat sz = cubvgeo[gid + p_SZID * p_cubNp];
+          const dfloat tx = cubvgeo[gid + p_TXID * p_cubNp];
+          const dfloat ty = cubvgeo[gid + p_TYID * p_cubNp];
+          const dfloat tz = cubvgeo[gid + p_TZID * p_cubNp];
+          const dfloat JW = cubvgeo[gid + p_JWID * p_cubNp];
+
+#if p_lambda == 1
+          const dfloat lbda0 = s_cub[1][k][j][i];
+#else
+          const dfloat lbda0 = lambda0[0];
+#endif
+
+          const dfloat Ux = rx * Ur + sx * Us + tx * Ut;
+          const dfloat Uy = ry * Ur + sy * Us + ty * Ut;
+          const dfloat Uz = rz * Ur + sz * Us + tz * Ut;
+
+          const dfloat scale = lbda0 * JW;
+          s_Fr[k][j][i] = scale * (rx * Ux + ry * Uy + rz * Uz);
+          s_Fs[k][j][i] = scale * (sx * Ux + sy * Uy + sz * Uz);
+          s_Ft[k][j][i] = scale * (tx * Ux + ty * Uy + tz * Uz);
+
+#ifdef p_poisson
+          s_V[k][j][i] = 0;
+#else
+#if p_lambda == 1
+          const dfloat lbda1 = s_cub[2][k][j][i];
+#else
+          const dfloat lbda1 = lambda1[0];
+#endif
+          s_V[k][j][i] = lbda1 * JW * s_cub[0][k][j][i];
+#endif
+        }
+
+    for(int k = 0; k < p_cubNq; ++k)
+      for(int j = 0; j < p_cubNq; ++j)
+        for(int i = 0; i < p_cubNq; ++i) {
+          dfloat tmp = 0;
+          for(int n = 0; n < p_cubNq; ++n) {
+            tmp += cubD[n * p_cubNq + i] * s_Fr[k][j][n];
+            tmp += cubD[n * p_cubNq + j] * s_Fs[k][n][i];
+            tmp += cubD[n * p_cubNq + k] * s_Ft[n][j][i];
+          }
+          s_V[k][j][i] += tmp;
+        }
+
+    // project back to the GLL points
+    for(int c = 0; c < p_Nq; ++c)
+      for(int j = 0; j < p_cubNq; ++j)
+        for(int i = 0; i < p_cubNq; ++i) {
+          dfloat tmp = 0;
+          for(int k = 0; k < p_cubNq; ++k)
+            tmp += cubInterpT[c * p_cubNq + k] * s_V[k][j][i];
+          s_tmp2[c][j][i] = tmp;
+        }
+
+    for(int c = 0; c < p_Nq; ++c)
+      for(int b = 0; b < p_Nq; ++b)
+        for(int i = 0; i < p_cubNq; ++i) {
+          dfloat tmp = 0;
+          for(int j = 0; j < p_cubNq; ++j)
+            tmp += cubInterpT[b * p_cubNq + j] * s_tmp2[c][j][i];
+          s_tmp1[c][b][i] = tmp;
+        }
+
+    for(int c = 0; c < p_Nq; ++c)
+      for(int b = 0; b < p_Nq; ++b)
+        for(int a = 0; a < p_Nq; ++a) {
+          dfloat tmp = 0;
+          for(int i = 0; i < p_cubNq; ++i)
+            tmp += cubInterpT[a * p_cubNq + i] * s_tmp1[c][b][i];
+          Aq[element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a] = tmp;
+        }
+  }
+}
@@ -1,12 +1,52 @@
+#include <string.h>
+
+// storage of the FDM operators: 0 = pfloat, 1 = FP16, 2 = BF16 (computed in pfloat)
+#ifndef p_fdmStorage
+#define p_fdmStorage 0
+#endif
+
+#if p_fdmStorage == 1
+#define pstorage unsigned short
+inline pfloat loadStorage(const unsigned short h)
+{
+  const unsigned int exponent = (h >> 10) & 0x1f;
+  const unsigned int mantissa = h & 0x3ff;
+  if (exponent == 0) {
+    const pfloat value = mantissa * 5.9604644775390625e-8f; // 2^-24
+    return (h & 0x8000) ? -value : value;
+  }
+  unsigned int bits = ((unsigned int)(h & 0x8000)) << 16;
+  if (exponent == 0x1f)
+    bits |= 0x7f800000 | (mantissa << 13);
+  else
+    bits |= ((exponent + 112) << 23) | (mantissa << 13);
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+#elif p_fdmStorage == 2
+#define pstorage unsigned short
+inline pfloat loadStorage(const unsigned short h)
+{
+  unsigned int bits = ((unsigned int)h) << 16;
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+#else
+#define pstorage pfloat
+#define loadStorage(a) (a)
+#endif
+
 #if p_knl == 0
 extern "C" void FUNC(fusedFDM_v0)(
   const dlong& Nelements,
   const dlong *elementList,
   pfloat* __restrict__ Su,
-  const pfloat* __restrict__ S_x,
-  const pfloat* __restrict__ S_y,
-  const pfloat* __restrict__ S_z,
-  const pfloat* __restrict__ inv_L,
+  const pstorage* __restrict__ S_x,
+  const pstorage* __restrict__ S_y,
+  const pstorage* __restrict__ S_z,
+  const pstorage* __restrict__ inv_L,
 #if p_restrict
   const pfloat* __restrict__ wts,
 #endif
@@ -78,9 +118,9 @@ extern "C" void FUNC(fusedFDM_v0)(
     for (int i = 0; i < p_Nq_e; i++){
       for (int j = 0; j < p_Nq_e; j++) {
         const int ij = j + i * p_Nq_e;
-        S_x_e[i][j] = S_x[ij + element * p_Nq_e * p_Nq_e];
-        S_y_e[i][j] = S_y[ij + element * p_Nq_e * p_Nq_e];
-        S_z_e[i][j] = S_z[ij + element * p_Nq_e * p_Nq_e];
+        S_x_e[i][j] = loadStorage(S_x[ij + element * p_Nq_e * p_Nq_e]);
+        S_y_e[i][j] = loadStorage(S_y[ij + element * p_Nq_e * p_Nq_e]);
+        S_z_e[i][j] = loadStorage(S_z[ij + element * p_Nq_e * p_Nq_e]);
         S_x_eT[j][i] = S_x_e[i][j];
         S_y_eT[j][i] = S_y_e[i][j];
         S_z_eT[j][i] = S_z_e[i][j];
@@ -115,7 +155,7 @@ extern "C" void FUNC(fusedFDM_v0)(
           pfloat value = 0.0;
           for (int l = 0; l < p_Nq_e; l++)
             value += S_z_e[l][k] * tmp[j][l][i];
-          work2[k][i][j] = value * inv_L[v + element * p_Nq_e * p_Nq_e * p_Nq_e];
+          work2[k][i][j] = value * loadStorage(inv_L[v + element * p_Nq_e * p_Nq_e * p_Nq_e]);
         }
       }
     }
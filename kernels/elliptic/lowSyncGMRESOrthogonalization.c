@@ -0,0 +1,33 @@
+// lagged reorthogonalization and normalization of the candidate u = V(:,j)
+//   V(:,j)   = (u - \sum_k^{j-1} a_k V(:,k)) / beta
+// followed by the (once orthogonalized) next candidate
+//   V(:,j+1) = (w - \sum_k^{j} y_k V(:,k)) / beta
+extern "C" void FUNC(lowSyncGMRESOrthogonalization)(const dlong &N,
+                                                    const dlong &offset,
+                                                    const dlong &j,
+                                                    const dfloat &invBeta,
+                                                    const dlong &computeNext,
+                                                    const dfloat *__restrict__ a,
+                                                    const dfloat *__restrict__ y,
+                                                    const dfloat *__restrict__ w,
+                                                    dfloat *__restrict__ V)
+{
+  for (int fld = 0; fld < p_Nfields; ++fld) {
+    for (dlong n = 0; n < N; ++n) {
+      const dlong id = n + fld * offset;
+
+      dfloat vj = V[id + j * offset * p_Nfields];
+      dfloat wn = w[id];
+      for (int k = 0; k < j; ++k) {
+        const dfloat Vk = V[id + k * offset * p_Nfields];
+        vj -= a[k] * Vk;
+        wn -= y[k] * Vk;
+      }
+      vj *= invBeta;
+      V[id + j * offset * p_Nfields] = vj;
+
+      if (computeNext)
+        V[id + (j + 1) * offset * p_Nfields] = (wn - y[j] * vj) * invBeta;
+    }
+  }
+}
@@ -0,0 +1,34 @@
+// all inner products of one low-synch Arnoldi step, u = V(:,j) is the unnormalized candidate
+//   (V(:,k),u) k < j, (V(:,k),w) k < j, (u,u), (u,w), (w,w)
+// single pass, u and w are read once and every V(:,k) is read once
+extern "C" void FUNC(lowSyncGMRESReductions)(const dlong &Nblock,
+                                             const dlong &N,
+                                             const dlong &offset,
+                                             const dlong &j,
+                                             const dfloat *__restrict__ weights,
+                                             const dfloat *__restrict__ V,
+                                             const dfloat *__restrict__ w,
+                                             dfloat *__restrict__ reduction)
+{
+  const dfloat *u = V + j * offset * p_Nfields;
+
+  for (int v = 0; v < 2 * j + 3; ++v)
+    reduction[v] = 0.0;
+
+  for (int fld = 0; fld < p_Nfields; ++fld) {
+    for (dlong n = 0; n < N; ++n) {
+      const dfloat weight = weights[n];
+      const dfloat un = weight * u[n + fld * offset];
+      const dfloat wn = w[n + fld * offset];
+
+      for (int k = 0; k < j; ++k) {
+        const dfloat vn = V[n + fld * offset + k * offset * p_Nfields];
+        reduction[k] += vn * un;
+        reduction[j + k] += weight * vn * wn;
+      }
+      reduction[2 * j] += un * u[n + fld * offset];
+      reduction[2 * j + 1] += un * wn;
+      reduction[2 * j + 2] += weight * wn * wn;
+    }
+  }
+}
@@ -0,0 +1,29 @@
+// weighted (r,u), (w,u) and (r,r) for pipelined PCG
+extern "C" void FUNC(pipelinedPCGReductions)(const dlong &N,
+                                             const dlong &fieldOffset,
+                                             const dfloat *__restrict__ weights,
+                                             const dfloat *__restrict__ r,
+                                             const dfloat *__restrict__ u,
+                                             const dfloat *__restrict__ w,
+                                             dfloat *__restrict__ reduction)
+{
+  dfloat sums[p_nReduction];
+  for (int i = 0; i < p_nReduction; ++i) {
+    sums[i] = 0.0;
+  }
+
+  for (int id = 0; id < N; ++id) {
+    const dfloat wt = weights[id];
+    for (int fld = 0; fld < p_Nfields; ++fld) {
+      const dlong n = id + fld * fieldOffset;
+      const dfloat rk = r[n];
+      const dfloat uk = u[n];
+      sums[p_gamma] += rk * uk * wt;
+      sums[p_delta] += w[n] * uk * wt;
+      sums[p_rdotr] += rk * rk * wt;
+    }
+  }
+  for (int i = 0; i < p_nReduction; ++i) {
+    reduction[i] = sums[i];
+  }
+}
@@ -0,0 +1,57 @@
+// recurrences of pipelined PCG (Ghysels and Vanroose 2014, Alg. 4)
+// fused with (r,u), (w,u) and (r,r) for the next iteration
+extern "C" void FUNC(pipelinedPCGUpdate)(const dlong &N,
+                                         const dlong &fieldOffset,
+                                         const dfloat &alpha,
+                                         const dfloat &beta,
+                                         const dfloat *__restrict__ weights,
+                                         const dfloat *__restrict__ m,
+                                         const dfloat *__restrict__ nv,
+                                         dfloat *__restrict__ z,
+                                         dfloat *__restrict__ q,
+                                         dfloat *__restrict__ s,
+                                         dfloat *__restrict__ p,
+                                         dfloat *__restrict__ x,
+                                         dfloat *__restrict__ r,
+                                         dfloat *__restrict__ u,
+                                         dfloat *__restrict__ w,
+                                         dfloat *__restrict__ reduction)
+{
+  dfloat sums[p_nReduction];
+  for (int i = 0; i < p_nReduction; ++i) {
+    sums[i] = 0.0;
+  }
+
+  for (int id = 0; id < N; ++id) {
+    const dfloat wt = weights[id];
+    for (int fld = 0; fld < p_Nfields; ++fld) {
+      const dlong n = id + fld * fieldOffset;
+      const dfloat zk = nv[n] + beta * z[n];
+      const dfloat qk = m[n] + beta * q[n];
+      const dfloat wk = w[n];
+      const dfloat uk = u[n];
+      const dfloat sk = wk + beta * s[n];
+      const dfloat pk = uk + beta * p[n];
+
+      const dfloat rk1 = r[n] - alpha * sk;
+      const dfloat uk1 = uk - alpha * qk;
+      const dfloat wk1 = wk - alpha * zk;
+
+      z[n] = zk;
+      q[n] = qk;
+      s[n] = sk;
+      p[n] = pk;
+      x[n] += alpha * pk;
+      r[n] = rk1;
+      u[n] = uk1;
+      w[n] = wk1;
+
+      sums[p_gamma] += rk1 * uk1 * wt;
+      sums[p_delta] += wk1 * uk1 * wt;
+      sums[p_rdotr] += rk1 * rk1 * wt;
+    }
+  }
+  for (int i = 0; i < p_nReduction; ++i) {
+    reduction[i] = sums[i];
+  }
+}
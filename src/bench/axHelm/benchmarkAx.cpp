@@ -18,6 +18,7 @@ struct CallParameters {
   int Nelements;
   int Nq;
   int Ng;
+  int cubNq;
   bool constCoeff;
   bool poisson;
   bool computeGeom;
@@ -36,6 +37,7 @@ template <> struct less<CallParameters> {
       return std::tie(v.Nelements,
                       v.Nq,
                       v.Ng,
+                      v.cubNq,
                       v.constCoeff,
                       v.poisson,
                       v.computeGeom,
@@ -57,6 +59,7 @@ template <typename T>
 occa::kernel benchmarkAx(int Nelements,
                          int Nq,
                          int Ng,
+                         int cubNq,
                          bool constCoeff,
                          bool poisson,
                          bool computeGeom,
@@ -73,7 +76,7 @@ occa::kernel benchmarkAx(int Nelements,
   }
 
   CallParameters
-      params{Nelements, Nq, Ng, constCoeff, poisson, computeGeom, wordSize, Ndim, stressForm, suffix};
+      params{Nelements, Nq, Ng, cubNq, constCoeff, poisson, computeGeom, wordSize, Ndim, stressForm, suffix};
 
   if (cachedResults.count(params) > 0) {
     return cachedResults.at(params);
@@ -100,12 +103,24 @@ occa::kernel benchmarkAx(int Nelements,
   else
     props["defines/p_lambda"] = 1;
 
+  // cubNq > Nq selects the operator integrated on cubature points
+  const bool cubature = cubNq > Nq;
+  const int cubNp = cubNq * cubNq * cubNq;
+  if (cubature) {
+    if (Ndim > 1 || Ng != N) {
+      printf("cubature Ax requires Ndim=1 and g-order == p-order!\n");
+      exit(1);
+    }
+    props["defines/p_cubNq"] = cubNq;
+    props["defines/p_cubNp"] = cubNp;
+  }
+
   std::string kernelName = "elliptic";
   if (Ndim > 1) {
     kernelName += stressForm ? "Stress" : "Block";
   }
   kernelName += "PartialAx";
-  kernelName += "Coeff";
+  kernelName += cubature ? "Cubature" : "Coeff";
   if (Ng != N) {
     if (computeGeom) {
       if (Ng == 1) {
@@ -131,7 +146,7 @@ occa::kernel benchmarkAx(int Nelements,
 
     std::vector<int> kernelVariants;
 
-    if (platform->serial) {
+    if (platform->serial || cubature) {
       const int Nkernels = 1;
       for (int knl = 0; knl < Nkernels; ++knl)
         kernelVariants.push_back(knl);
@@ -201,7 +216,8 @@ occa::kernel benchmarkAx(int Nelements,
     const std::string oklpath(getenv("NEKRS_KERNEL_DIR"));
 
     // only a single choice, no need to run benchmark
-    if ((kernelVariants.size() == 1 && !platform->serial) || !runAutotuner) {
+    // (cubature has a single variant but is timed to compare against the collocated kernel)
+    if ((kernelVariants.size() == 1 && !platform->serial && !cubature) || !runAutotuner) {
 
       auto newProps = props;
       newProps["defines/p_knl"] = kernelVariants.front();
@@ -221,6 +237,9 @@ occa::kernel benchmarkAx(int Nelements,
     auto gllwz = randomVector<FPType>(2 * Nq_g, 0, 1, true);
     auto lambda0 = randomVector<FPType>(Np * Nelements, 0, 1, true);
     auto lambda1 = randomVector<FPType>(Np * Nelements, 0, 1, true);
+    auto cubvgeo = randomVector<FPType>(cubNp * Nelements * p_Nvgeo, 0, 1, true);
+    auto cubInterpT = randomVector<FPType>(Nq * cubNq, 0, 1, true);
+    auto cubD = randomVector<FPType>(cubNq * cubNq, 0, 1, true);
 
     // elementList[e] = e
     std::vector<dlong> elementList(Nelements);
@@ -239,6 +258,13 @@ occa::kernel benchmarkAx(int Nelements,
     auto o_lambda0 = platform->device.malloc(Np * Nelements * wordSize, lambda0.data());
     auto o_lambda1 = platform->device.malloc(Np * Nelements * wordSize, lambda1.data());
 
+    occa::memory o_cubvgeo, o_cubInterpT, o_cubD;
+    if (cubature) {
+      o_cubvgeo = platform->device.malloc(cubNp * Nelements * p_Nvgeo * wordSize, cubvgeo.data());
+      o_cubInterpT = platform->device.malloc(Nq * cubNq * wordSize, cubInterpT.data());
+      o_cubD = platform->device.malloc(cubNq * cubNq * wordSize, cubD.data());
+    }
+
     occa::kernel referenceKernel;
     {
       auto newProps = props;
@@ -253,7 +279,10 @@ occa::kernel benchmarkAx(int Nelements,
     auto kernelRunner = [&](occa::kernel &kernel) {
       const int loffset = 0;
       const int offset = Nelements * Np;
-      if (computeGeom) {
+      if (cubature) {
+        kernel(Nelements, offset, loffset, o_elementList, o_cubvgeo, o_cubInterpT, o_cubD, o_lambda0, o_lambda1, o_q, o_Aq);
+      }
+      else if (computeGeom) {
         kernel(Nelements, offset, loffset, o_elementList, o_exyz, o_gllwz, o_D, o_S, o_lambda0, o_lambda1, o_q, o_Aq);
       }
       else {
@@ -318,6 +347,13 @@ occa::kernel benchmarkAx(int Nelements,
       if (stressForm)
         bytesMoved += 3 * Np_g * wordSize; 
 
+      if (cubature) {
+        bytesMoved = 2 * Np * wordSize;       // x, Ax
+        bytesMoved += 10 * cubNp * wordSize; // metrics, JW
+        if (!constCoeff)
+          bytesMoved += (poisson ? 1 : 2) * Np * wordSize;
+      }
+
       const double bw = (Nelements * bytesMoved / elapsed) / 1.e9;
 
       double flopCount = Np * 12 * Nq + 15 * Np;
@@ -332,6 +368,15 @@ occa::kernel benchmarkAx(int Nelements,
       if (stressForm)
         flopCount += 21 * Np;
 
+      if (cubature) {
+        const int NcubFields = constCoeff ? 1 : (poisson ? 2 : 3);
+        const double interpFlops = 2.0 * (Nq * Nq * Nq * cubNq + Nq * Nq * cubNq * cubNq + Nq * cubNp);
+        flopCount = (NcubFields + 1) * interpFlops; // interpolation + projection
+        flopCount += 12.0 * cubNp * cubNq + 37 * cubNp;
+        if (!poisson)
+          flopCount += 3 * cubNp;
+      }
+
       const double gflops = Ndim * (flopCount * Nelements / elapsed) / 1.e9;
 #ifdef _OPENMP
       const int Nthreads = omp_get_max_threads();
@@ -354,6 +399,8 @@ occa::kernel benchmarkAx(int Nelements,
           std::cout << " N=" << N;
           if (Ng != N)
             std::cout << " Ng=" << Ng;
+          if (cubature)
+            std::cout << " cubNq=" << cubNq;
 
           if (verbosity > 1)
             std::cout << " Nelements=" << Nelements;
@@ -396,6 +443,11 @@ occa::kernel benchmarkAx(int Nelements,
     free(o_lambda0);
     free(o_lambda1);
     free(o_elementList);
+    if (cubature) {
+      free(o_cubvgeo);
+      free(o_cubInterpT);
+      free(o_cubD);
+    }
 
     return kernelAndTime;
   };
@@ -421,6 +473,7 @@ occa::kernel benchmarkAx(int Nelements,
 template occa::kernel benchmarkAx<int>(int Nelements,
                                        int Nq,
                                        int Ng,
+                                       int cubNq,
                                        bool constCoeff,
                                        bool poisson,
                                        bool computeGeom,
@@ -435,6 +488,7 @@ template occa::kernel benchmarkAx<int>(int Nelements,
 template occa::kernel benchmarkAx<double>(int Nelements,
                                           int Nq,
                                           int Ng,
+                                          int cubNq,
                                           bool constCoeff,
                                           bool poisson,
                                           bool computeGeom,
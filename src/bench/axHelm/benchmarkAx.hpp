@@ -4,6 +4,7 @@ template <typename T>
 occa::kernel benchmarkAx(int Nelements,
                          int Nq,
                          int Ng,
+                         int cubNq,
                          bool constCoeff,
                          bool poisson,
                          bool computeGeom,
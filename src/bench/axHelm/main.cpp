@@ -31,6 +31,7 @@ int main(int argc, char** argv)
   int N;
   int Nelements;
   int Ng = -1;
+  int cubN = -1;
   int Ndim = 1;
   int okl = 1;
   int BKmode = 0;
@@ -44,6 +45,7 @@ int main(int argc, char** argv)
     {
       {"p-order", required_argument, 0, 'p'},
       {"g-order", required_argument, 0, 'g'},
+      {"cub-order", required_argument, 0, 'q'},
       {"computeGeom", no_argument, 0, 'c'},
       {"block-dim", required_argument, 0, 'd'},
       {"elements", required_argument, 0, 'e'},
@@ -70,6 +72,9 @@ int main(int argc, char** argv)
     case 'g':
       Ng = atoi(optarg); 
       break;
+    case 'q':
+      cubN = atoi(optarg);
+      break;
     case 'c':
       computeGeom = 1; 
       break;
@@ -108,7 +113,7 @@ int main(int argc, char** argv)
     if(rank == 0)
       printf("Usage: ./nekrs-axhelm  --p-order <n> --elements <n> --backend <CPU|CUDA|HIP|DPCPP|OPENCL>\n"
              "                    [--block-dim <n>]\n"
-             "                    [--g-order <n>] [--computeGeom]\n"
+             "                    [--g-order <n>] [--computeGeom] [--cub-order <n>]\n"
              "                    [--bk-mode] [--fp32] [--stress] [--iterations <n>]\n"); 
     exit(1); 
   }
@@ -117,6 +122,7 @@ int main(int argc, char** argv)
     Ndim = 3;
 
   if(Ng < 0) Ng = N; 
+  const int cubNq = (cubN > N) ? cubN + 1 : 0;
   Nelements = std::max(1, Nelements/size);
   constexpr int p_Nggeo {7};
   const int Nq = N + 1;
@@ -139,6 +145,7 @@ int main(int argc, char** argv)
     benchmarkAx(Nelements,
                 Nq,
                 Ng,
+                cubNq,
                 poisson,
                 constCoeff,
                 computeGeom,
@@ -155,6 +162,7 @@ int main(int argc, char** argv)
     benchmarkAx(Nelements,
                 Nq,
                 Ng,
+                cubNq,
                 poisson,
                 constCoeff,
                 computeGeom,
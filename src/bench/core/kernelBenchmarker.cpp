@@ -1,8 +1,176 @@
 #include "kernelBenchmarker.hpp"
 #include <limits>
+#include <map>
+#include <regex>
+#include <fstream>
 #include "nrs.hpp"
+#include "sha1.hpp"
+#include "fileUtils.hpp"
 
 namespace {
+
+// persistent autotuning results (rank 0 only), one line per tuned kernel:
+// <key> <variant> <time> <backend> <kernel name>
+struct tuningRecord_t {
+  int variant;
+  double time;
+  std::string description;
+};
+
+fs::path tuningDatabaseFile()
+{
+  return fs::path(getenv("NEKRS_CACHE_DIR")) / "kernelTuning.db";
+}
+
+std::map<std::string, tuningRecord_t> &tuningDatabase()
+{
+  static std::map<std::string, tuningRecord_t> db;
+  static bool loaded = false;
+
+  if (!loaded) {
+    loaded = true;
+    std::ifstream f(tuningDatabaseFile());
+    std::string line;
+    while (std::getline(f, line)) {
+      std::istringstream is(line);
+      std::string key;
+      tuningRecord_t record;
+      if (is >> key >> record.variant >> record.time) {
+        std::getline(is >> std::ws, record.description);
+        db[key] = record;
+      }
+    }
+  }
+
+  return db;
+}
+
+void writeTuningDatabase()
+{
+  const auto fileName = tuningDatabaseFile();
+  const auto tmpFileName = fs::path(std::string(fileName) + ".tmp");
+  {
+    std::ofstream f(tmpFileName, std::ios::trunc);
+    f.precision(6);
+    for (const auto &[key, record] : tuningDatabase())
+      f << key << " " << record.variant << " " << std::scientific << record.time << " " << record.description
+        << "\n";
+  }
+  fs::rename(tmpFileName, fileName);
+}
+
+// device model, occa's device hash covers the GPU arch (compute capability, gfx target,
+// OpenCL/SYCL device name) but is the same for all host CPUs
+std::string deviceModel()
+{
+  static std::string model;
+  if (!model.empty())
+    return model;
+
+  model = platform->device.occaDevice().hash().getFullString();
+  if (platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP") {
+    std::ifstream f("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(f, line)) {
+      if (line.rfind("model name", 0) == 0) {
+        model += " " + std::regex_replace(line.substr(line.find(':') + 1), std::regex("^\\s+"), "");
+        break;
+      }
+    }
+  }
+  return model;
+}
+
+// winner depends on backend, device model, kernel and its
+// properties (N, Ncub, dfloat/pfloat, compiler flags, ...) but not on the variant itself
+std::string tuningKey(occa::kernel &kernel, std::string &description)
+{
+  const std::string name = std::regex_replace(kernel.name(), std::regex("_v[0-9]+"), "");
+  occa::json props = kernel.properties();
+  if (props.has("defines/p_knl"))
+    props["defines"].remove("p_knl");
+
+  description = platform->device.mode() + " " + name;
+
+  SHA1 sha;
+  sha.update(description);
+  sha.update(deviceModel());
+  sha.update(props.dump(0));
+  return sha.final();
+}
+
+int kernelVariant(occa::kernel &kernel)
+{
+  return kernel.properties().has("defines/p_knl") ? static_cast<int>(kernel.properties()["defines/p_knl"])
+                                                  : -1;
+}
+
+bool tuningDatabaseEnabled(const std::vector<int> &kernelVariants)
+{
+  const bool enabled = platform->options.compareArgs("KERNEL TUNING", "CACHED") ||
+                       platform->options.compareArgs("KERNEL TUNING", "RETUNE");
+  return enabled && kernelVariants.size() > 1 && platform->options.compareArgs("BUILD ONLY", "FALSE");
+}
+
+// returns the previously tuned kernel if the database has an entry for the request
+std::pair<occa::kernel, double> lookupTunedKernel(std::function<occa::kernel(int kernelVariant)> kernelBuilder,
+                                                  const std::vector<int> &kernelVariants,
+                                                  std::string &key,
+                                                  std::string &description)
+{
+  if (!tuningDatabaseEnabled(kernelVariants))
+    return {};
+
+  auto kernel = kernelBuilder(kernelVariants.front());
+  int valid = kernel.isInitialized();
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, platform->comm.mpiComm);
+  if (!valid)
+    return {};
+
+  // rank 0 decides to keep the variant choice consistent across ranks
+  int variant = -1;
+  double time = 0;
+  if (platform->comm.mpiRank == 0) {
+    key = tuningKey(kernel, description);
+    if (!platform->options.compareArgs("KERNEL TUNING", "RETUNE") && tuningDatabase().count(key)) {
+      variant = tuningDatabase().at(key).variant;
+      time = tuningDatabase().at(key).time;
+    }
+  }
+  MPI_Bcast(&variant, 1, MPI_INT, 0, platform->comm.mpiComm);
+  MPI_Bcast(&time, 1, MPI_DOUBLE, 0, platform->comm.mpiComm);
+
+  if (std::find(kernelVariants.begin(), kernelVariants.end(), variant) == kernelVariants.end())
+    return {};
+
+  if (variant != kernelVariants.front())
+    kernel = kernelBuilder(variant);
+
+  valid = kernel.isInitialized();
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, platform->comm.mpiComm);
+  if (!valid)
+    return {};
+
+  return {kernel, time};
+}
+
+void storeTunedKernel(const std::vector<int> &kernelVariants,
+                      const std::string &key,
+                      const std::string &description,
+                      occa::kernel &kernel,
+                      double time)
+{
+  if (!tuningDatabaseEnabled(kernelVariants) || platform->comm.mpiRank != 0 || key.empty())
+    return;
+
+  const int variant = kernelVariant(kernel);
+  if (variant < 0)
+    return;
+
+  tuningDatabase()[key] = {variant, time, description};
+  writeTuningDatabase();
+}
+
 double run(int Nsamples, std::function<void(occa::kernel &)> kernelRunner, occa::kernel &kernel)
 {
   platform->device.finish();
@@ -24,6 +192,11 @@ benchmarkKernel(std::function<occa::kernel(int kernelVariant)> kernelBuilder,
                 const std::vector<int> &kernelVariants,
                 int Ntests)
 {
+  std::string key, description;
+  auto tunedKernel = lookupTunedKernel(kernelBuilder, kernelVariants, key, description);
+  if (tunedKernel.first.isInitialized())
+    return tunedKernel;
+
   occa::kernel fastestKernel;
   double fastestTime = std::numeric_limits<double>::max();
 
@@ -62,6 +235,9 @@ benchmarkKernel(std::function<occa::kernel(int kernelVariant)> kernelBuilder,
     }
   }
 
+  if (fastestKernel.isInitialized())
+    storeTunedKernel(kernelVariants, key, description, fastestKernel, fastestTime);
+
   return std::make_pair(fastestKernel, fastestTime);
 }
 
@@ -72,6 +248,11 @@ benchmarkKernel(std::function<occa::kernel(int kernelVariant)> kernelBuilder,
                 const std::vector<int> &kernelVariants,
                 double targetTime)
 {
+  std::string key, description;
+  auto tunedKernel = lookupTunedKernel(kernelBuilder, kernelVariants, key, description);
+  if (tunedKernel.first.isInitialized())
+    return tunedKernel;
+
   occa::kernel fastestKernel;
   double fastestTime = std::numeric_limits<double>::max();
 
@@ -118,5 +299,7 @@ benchmarkKernel(std::function<occa::kernel(int kernelVariant)> kernelBuilder,
   nrsCheck(!fastestKernel.isInitialized(), MPI_COMM_SELF, EXIT_FAILURE, 
            "%s\n", "Cannot find valid kernel variant!");
 
+  storeTunedKernel(kernelVariants, key, description, fastestKernel, fastestTime);
+
   return std::make_pair(fastestKernel, fastestTime);
 }
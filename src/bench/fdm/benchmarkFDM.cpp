@@ -5,6 +5,7 @@
 #include "nrs.hpp"
 
 #include "randomVector.hpp"
+#include "halfPrecision.hpp"
 #include "kernelBenchmarker.hpp"
 #include <tuple>
 #include <map>
@@ -14,6 +15,7 @@ struct CallParameters {
   int Nelements;
   int Nq_e;
   size_t wordSize;
+  int fdmStorage;
   bool useRAS;
   std::string suffix;
 };
@@ -24,7 +26,7 @@ template <> struct less<CallParameters> {
   bool operator()(const CallParameters &lhs, const CallParameters &rhs) const
   {
     auto tier = [](const CallParameters &v) {
-      return std::tie(v.Nelements, v.Nq_e, v.wordSize, v.useRAS, v.suffix);
+      return std::tie(v.Nelements, v.Nq_e, v.wordSize, v.fdmStorage, v.useRAS, v.suffix);
     };
     return tier(lhs) < tier(rhs);
   }
@@ -39,6 +41,7 @@ template <typename T>
 occa::kernel benchmarkFDM(int Nelements,
                           int Nq_e,
                           size_t wordSize,
+                          int fdmStorage,
                           bool useRAS,
                           int verbosity,
                           T NtestsOrTargetTime,
@@ -49,7 +52,7 @@ occa::kernel benchmarkFDM(int Nelements,
     Nelements = 1;
   }
 
-  CallParameters params{Nelements, Nq_e, wordSize, useRAS, suffix};
+  CallParameters params{Nelements, Nq_e, wordSize, fdmStorage, useRAS, suffix};
 
   if (cachedResults.count(params) > 0) {
     return cachedResults.at(params);
@@ -68,6 +71,7 @@ occa::kernel benchmarkFDM(int Nelements,
 
   props["defines/p_Nq_e"] = Nq_e;
   props["defines/p_Np_e"] = Np_e;
+  props["defines/p_fdmStorage"] = fdmStorage;
 
   if (useRAS) {
     props["defines/p_restrict"] = 1;
@@ -108,6 +112,25 @@ occa::kernel benchmarkFDM(int Nelements,
     auto Sy = randomVector<FPType>(Nelements * Nq_e * Nq_e, 0, 1, true);
     auto Sz = randomVector<FPType>(Nelements * Nq_e * Nq_e, 0, 1, true);
     auto invL = randomVector<FPType>(Nelements * Np_e, 0, 1, true);
+
+    // operators in reduced precision storage
+    const auto storageWordSize = (fdmStorage) ? sizeof(uint16_t) : wordSize;
+    auto toStorage = [&](const std::vector<FPType> &v) {
+      std::vector<uint16_t> out(v.size());
+      for (size_t i = 0; i < v.size(); ++i)
+        out[i] = (fdmStorage == 1) ? floatToHalf(v[i]) : floatToBfloat16(v[i]);
+      return out;
+    };
+    std::vector<uint16_t> SxStorage, SyStorage, SzStorage, invLStorage;
+    if (fdmStorage) {
+      SxStorage = toStorage(Sx);
+      SyStorage = toStorage(Sy);
+      SzStorage = toStorage(Sz);
+      invLStorage = toStorage(invL);
+    }
+    auto storageData = [&](std::vector<FPType> &v, std::vector<uint16_t> &vStorage) -> void * {
+      return (fdmStorage) ? static_cast<void *>(vStorage.data()) : static_cast<void *>(v.data());
+    };
     auto Su = randomVector<FPType>(Nelements * Np_e, 0, 1, true);
     auto u = randomVector<FPType>(Nelements * Np_e, 0, 1, true);
     auto invDegree = randomVector<dfloat>(Nelements * Np_e, 0, 1, true);
@@ -117,10 +140,10 @@ occa::kernel benchmarkFDM(int Nelements,
     std::iota(elementList.begin(), elementList.end(), 0);
     auto o_elementList = platform->device.malloc(Nelements * sizeof(int), elementList.data());
 
-    auto o_Sx = platform->device.malloc(Nelements * Nq_e * Nq_e * wordSize, Sx.data());
-    auto o_Sy = platform->device.malloc(Nelements * Nq_e * Nq_e * wordSize, Sy.data());
-    auto o_Sz = platform->device.malloc(Nelements * Nq_e * Nq_e * wordSize, Sz.data());
-    auto o_invL = platform->device.malloc(Nelements * Np_e * wordSize, invL.data());
+    auto o_Sx = platform->device.malloc(Nelements * Nq_e * Nq_e * storageWordSize, storageData(Sx, SxStorage));
+    auto o_Sy = platform->device.malloc(Nelements * Nq_e * Nq_e * storageWordSize, storageData(Sy, SyStorage));
+    auto o_Sz = platform->device.malloc(Nelements * Nq_e * Nq_e * storageWordSize, storageData(Sz, SzStorage));
+    auto o_invL = platform->device.malloc(Nelements * Np_e * storageWordSize, storageData(invL, invLStorage));
     auto o_Su = platform->device.malloc(Nelements * Np_e * wordSize, Su.data());
     auto o_u = platform->device.malloc(Nelements * Np_e * wordSize, u.data());
     auto o_invDegree = platform->device.malloc(Nelements * Np_e * sizeof(dfloat), invDegree.data());
@@ -202,7 +225,7 @@ occa::kernel benchmarkFDM(int Nelements,
       // print statistics
       const double GDOFPerSecond = (Nelements * (N_e * N_e * N_e) / elapsed) / 1.e9;
 
-      size_t bytesPerElem = (3 * Np_e + 3 * Nq_e * Nq_e) * wordSize;
+      size_t bytesPerElem = 2 * Np_e * wordSize + (Np_e + 3 * Nq_e * Nq_e) * storageWordSize;
       const double bw = (Nelements * bytesPerElem / elapsed) / 1.e9;
 
       double flopsPerElem = 12 * Nq_e * Np_e + Np_e;
@@ -231,7 +254,10 @@ occa::kernel benchmarkFDM(int Nelements,
           if (verbosity > 1)
             std::cout << " elapsed time=" << elapsed;
 
-          std::cout << " wordSize=" << 8 * wordSize << " GDOF/s=" << GDOFPerSecond << " GB/s=" << bw
+          std::cout << " wordSize=" << 8 * wordSize;
+          if (fdmStorage)
+            std::cout << " storage=" << ((fdmStorage == 1) ? "FP16" : "BF16");
+          std::cout << " GDOF/s=" << GDOFPerSecond << " GB/s=" << bw
                     << " GFLOPS/s=" << gflops << " kernelVer=" << kernelVariant << "\n";
         }
       }
@@ -287,6 +313,7 @@ occa::kernel benchmarkFDM(int Nelements,
 template occa::kernel benchmarkFDM<int>(int Nelements,
                                         int Nq_e,
                                         size_t wordSize,
+                                        int fdmStorage,
                                         bool useRAS,
                                         int verbosity,
                                         int Ntests,
@@ -296,6 +323,7 @@ template occa::kernel benchmarkFDM<int>(int Nelements,
 template occa::kernel benchmarkFDM<double>(int Nelements,
                                            int Nq_e,
                                            size_t wordSize,
+                                           int fdmStorage,
                                            bool useRAS,
                                            int verbosity,
                                            double targetTime,
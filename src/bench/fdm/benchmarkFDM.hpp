@@ -4,6 +4,7 @@ template <typename T>
 occa::kernel benchmarkFDM(int Nelements,
                           int Nq_e,
                           size_t wordSize,
+                          int fdmStorage, // 0: wordSize, 1: FP16, 2: BF16 operators
                           bool useRAS,
                           int verbosity,
                           T NtestsOrTargetTime,
@@ -38,6 +38,7 @@ int main(int argc, char** argv)
   int N;
   int okl = 1;
   int Ntests = -1;
+  int fdmStorage = 0;
 
   while(1) {
     static struct option long_options[] =
@@ -49,6 +50,7 @@ int main(int argc, char** argv)
       {"fp32", no_argument, 0, 'f'},
       {"help", required_argument, 0, 'h'},
       {"iterations", required_argument, 0, 'i'},
+      {"storage", required_argument, 0, 's'},
       {0, 0, 0, 0}
     };
     int option_index = 0;
@@ -76,6 +78,14 @@ int main(int argc, char** argv)
     case 'i':
       Ntests = atoi(optarg);
       break;
+    case 's':
+      if (strcmp(optarg, "FP16") == 0 || strcmp(optarg, "fp16") == 0)
+        fdmStorage = 1;
+      else if (strcmp(optarg, "BF16") == 0 || strcmp(optarg, "bf16") == 0)
+        fdmStorage = 2;
+      else
+        err = 1;
+      break;
     case 'h':
       err = 1;
       break;
@@ -87,7 +97,7 @@ int main(int argc, char** argv)
   if(err || cmdCheck != 3) {
     if(rank == 0)
       printf("Usage: ./nekrs-fdm  --p-order <n> --elements <n> --backend <CPU|CUDA|HIP|DPCPP|OPENCL>\n"
-             "                    [--fp32] [--iterations <n>]\n"); 
+             "                    [--fp32] [--storage <FP16|BF16>] [--iterations <n>]\n"); 
     exit(1); 
   }
 
@@ -107,11 +117,11 @@ int main(int argc, char** argv)
 
   const int verbosity = 2;
   if (Ntests != -1) {
-    benchmarkFDM(Nelements, Nq, wordSize, false, verbosity, Ntests, true, "");
+    benchmarkFDM(Nelements, Nq, wordSize, fdmStorage, false, verbosity, Ntests, true, "");
   }
   else {
     const double targetTime = 10.0;
-    benchmarkFDM(Nelements, Nq, wordSize, false, verbosity, targetTime, true, "");
+    benchmarkFDM(Nelements, Nq, wordSize, fdmStorage, false, verbosity, targetTime, true, "");
   }
 
   MPI_Finalize();
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "mpi.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "nrssys.hpp"
+#include "mesh.h"
+#include "fldCompression.hpp"
+
+namespace {
+
+// smooth field on the GLL points of a structured brick with additive noise
+void syntheticField(int N, dlong Nelements, int rank, double noise, std::vector<dfloat> &u)
+{
+  const int Nq = N + 1;
+  const int Np = Nq * Nq * Nq;
+  std::vector<dfloat> r(Nq);
+  Nodes1D(N, r.data());
+
+  std::mt19937 gen(rank);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  const int nex = std::max(1, static_cast<int>(std::cbrt(Nelements)));
+  u.resize(Nelements * Np);
+  for (dlong e = 0; e < Nelements; e++) {
+    const double ex = e % nex;
+    const double ey = (e / nex) % nex;
+    const double ez = e / (nex * nex) + rank * std::ceil(static_cast<double>(Nelements) / (nex * nex));
+    for (int k = 0; k < Nq; k++)
+      for (int j = 0; j < Nq; j++)
+        for (int i = 0; i < Nq; i++) {
+          const double x = (ex + 0.5 * (r[i] + 1)) / nex;
+          const double y = (ey + 0.5 * (r[j] + 1)) / nex;
+          const double z = (ez + 0.5 * (r[k] + 1)) / nex;
+          u[e * Np + i + j * Nq + k * Nq * Nq] =
+              std::sin(2 * M_PI * x) * std::cos(2 * M_PI * y) * std::exp(-z) + noise * dist(gen);
+        }
+  }
+}
+
+void run(int N, dlong Nelements, fld::compression_t type, double tolerance, double noise, int Ntests)
+{
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const int Np = (N + 1) * (N + 1) * (N + 1);
+
+  std::vector<dfloat> u, v(Nelements * Np);
+  syntheticField(N, Nelements, rank, noise, u);
+
+  const fld::elementCodec_t codec(N, type, tolerance);
+  std::vector<unsigned char> out;
+  out.reserve(u.size() * sizeof(dfloat));
+
+  double tEncode = 0;
+  double tDecode = 0;
+  for (int test = 0; test < Ntests; test++) {
+    out.clear();
+    MPI_Barrier(MPI_COMM_WORLD);
+    double tStart = MPI_Wtime();
+    for (dlong e = 0; e < Nelements; e++)
+      codec.encode(u.data() + e * Np, out);
+    tEncode += MPI_Wtime() - tStart;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    tStart = MPI_Wtime();
+    size_t pos = 0;
+    for (dlong e = 0; e < Nelements; e++)
+      pos += codec.decode(out.data() + pos, out.size() - pos, v.data() + e * Np);
+    tDecode += MPI_Wtime() - tStart;
+  }
+  tEncode /= Ntests;
+  tDecode /= Ntests;
+
+  double maxErr = 0;
+  for (size_t n = 0; n < u.size(); n++)
+    maxErr = std::max(maxErr, static_cast<double>(std::abs(u[n] - v[n])));
+
+  const double rawBytes = u.size() * sizeof(dfloat);
+  const double ratio = rawBytes / out.size();
+  const double encodeGBs = rawBytes / 1e9 / tEncode;
+  const double decodeGBs = rawBytes / 1e9 / tDecode;
+
+  double minMax[6] = {-ratio, ratio, -encodeGBs, encodeGBs, -decodeGBs, decodeGBs};
+  MPI_Allreduce(MPI_IN_PLACE, minMax, 6, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &maxErr, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  if (rank == 0) {
+    printf("codec=%s tolerance=%g ranks=%d N=%d Nelements/rank=%d wordSize=%zu\n",
+           fld::compressionName(type).c_str(),
+           (type == fld::compression_t::modal) ? tolerance : 0.0,
+           size,
+           N,
+           Nelements,
+           sizeof(dfloat));
+    printf("  ratio:                %.2f (min) %.2f (max)\n", -minMax[0], minMax[1]);
+    printf("  encode [GB/s/rank]:   %.3f (min) %.3f (max)\n", -minMax[2], minMax[3]);
+    printf("  decode [GB/s/rank]:   %.3f (min) %.3f (max)\n", -minMax[4], minMax[5]);
+    printf("  max error:            %.4e\n", maxErr);
+    fflush(stdout);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int rank = 0, size = 1;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  int err = 0;
+  int cmdCheck = 0;
+
+  int N;
+  int Nelements;
+  double tolerance = 1e-6;
+  double noise = 0;
+  int Ntests = 10;
+  std::string codec = "ALL";
+
+  while(1) {
+    static struct option long_options[] =
+    {
+      {"p-order", required_argument, 0, 'p'},
+      {"elements", required_argument, 0, 'e'},
+      {"codec", required_argument, 0, 'c'},
+      {"tolerance", required_argument, 0, 't'},
+      {"noise", required_argument, 0, 'n'},
+      {"iterations", required_argument, 0, 'i'},
+      {"help", no_argument, 0, 'h'},
+      {0, 0, 0, 0}
+    };
+    int option_index = 0;
+    int c = getopt_long (argc, argv, "", long_options, &option_index);
+
+    if (c == -1)
+      break;
+
+    switch(c) {
+    case 'p':
+      N = atoi(optarg); 
+      cmdCheck++; 
+      break;
+    case 'e':
+      Nelements = atoi(optarg);
+      cmdCheck++;
+      break;
+    case 'c':
+      codec = std::string(optarg);
+      upperCase(codec);
+      break;
+    case 't':
+      tolerance = atof(optarg);
+      break;
+    case 'n':
+      noise = atof(optarg);
+      break;
+    case 'i':
+      Ntests = std::max(1, atoi(optarg));
+      break;
+    case 'h':
+      err = 1;
+      break;
+    default:
+      err = 1;
+    }
+  }
+
+  if(err || cmdCheck != 2) {
+    if(rank == 0)
+      printf("Usage: ./nekrs-bench-compression --p-order <n> --elements <n>\n"
+             "                                 [--codec <lossless|modal>] [--tolerance <float>]\n"
+             "                                 [--noise <float>] [--iterations <n>]\n"); 
+    exit(1); 
+  }
+
+  Nelements = std::max(1, Nelements/size);
+
+  if (codec == "ALL" || codec == "LOSSLESS")
+    run(N, Nelements, fld::compression_t::lossless, tolerance, noise, Ntests);
+  if (codec == "ALL" || codec == "MODAL")
+    run(N, Nelements, fld::compression_t::modal, tolerance, noise, Ntests);
+
+  MPI_Finalize();
+  exit(0);
+}
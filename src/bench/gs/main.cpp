@@ -0,0 +1,259 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "mpi.h"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "nrssys.hpp"
+#include "setupAide.hpp"
+#include "platform.hpp"
+#include "configReader.hpp"
+#include "ogs.hpp"
+#include "ogsKernels.hpp"
+
+// 3rd_party/nek5000/core/reorder.c
+extern "C" int reorderElements(int *perm, const long long *vtx, int nel, int nv);
+
+namespace {
+
+// structured brick of nex^3 elements per rank, ranks are stacked in z
+void brick(int N, int nex, int rank, std::vector<long long> &vtx, std::vector<hlong> &ids)
+{
+  const int Nq = N + 1;
+  const int Np = Nq * Nq * Nq;
+  const dlong Nelements = nex * nex * nex;
+  const long long nx = static_cast<long long>(nex) * N + 1;
+  const long long nvx = nex + 1;
+
+  vtx.resize(Nelements * 8);
+  ids.resize(Nelements * Np);
+  for (dlong e = 0; e < Nelements; e++) {
+    const long long ex = e % nex;
+    const long long ey = (e / nex) % nex;
+    const long long ez = e / (nex * nex) + static_cast<long long>(rank) * nex;
+
+    int n = 0;
+    for (int c = 0; c < 2; c++)
+      for (int b = 0; b < 2; b++)
+        for (int a = 0; a < 2; a++)
+          vtx[e * 8 + n++] = 1 + (ex + a) + nvx * ((ey + b) + nvx * (ez + c));
+
+    for (int k = 0; k < Nq; k++)
+      for (int j = 0; j < Nq; j++)
+        for (int i = 0; i < Nq; i++)
+          ids[e * Np + i + j * Nq + k * Nq * Nq] = 1 + (ex * N + i) + nx * ((ey * N + j) + nx * (ez * N + k));
+  }
+}
+
+double run(const std::string &label,
+           int N,
+           const std::vector<int> &order,
+           const std::vector<hlong> &ids,
+           size_t wordSize,
+           int Ntests)
+{
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const int Np = (N + 1) * (N + 1) * (N + 1);
+  const dlong Nelements = order.size();
+  const dlong Nlocal = Nelements * Np;
+
+  std::vector<hlong> idsOrdered(Nlocal);
+  for (dlong e = 0; e < Nelements; e++)
+    std::copy(ids.begin() + order[e] * Np, ids.begin() + (order[e] + 1) * Np, idsOrdered.begin() + e * Np);
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto ogs = ogsSetup(Nlocal, idsOrdered.data(), comm, 0, platform->device.occaDevice());
+
+  const char *type = (wordSize == sizeof(float)) ? ogsFloat : ogsDouble;
+  std::vector<double> u(Nlocal, 1);
+  std::vector<float> uFloat(Nlocal, 1);
+  auto o_u = platform->device.malloc(Nlocal, wordSize);
+  if (wordSize == sizeof(float))
+    o_u.copyFrom(uFloat.data());
+  else
+    o_u.copyFrom(u.data());
+
+  auto gs = [&]() {
+    if (ogs->NlocalGather)
+      occaGatherScatter(ogs->NlocalGather, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, ogsAdd, o_u);
+  };
+
+  gs(); // warm up
+  platform->device.finish();
+
+  double elapsed = std::numeric_limits<double>::max();
+  for (int test = 0; test < Ntests; test++) {
+    platform->device.finish();
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double tStart = MPI_Wtime();
+    gs();
+    platform->device.finish();
+    elapsed = std::min(elapsed, MPI_Wtime() - tStart);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  // same traffic model as the oogs tuner
+  double rowSizeSum = 0;
+  for (dlong i = 0; i < ogs->NlocalGather; i++)
+    rowSizeSum += ogs->localGatherOffsets[i + 1] - ogs->localGatherOffsets[i];
+  double bw = (2 * wordSize) * rowSizeSum + 2 * rowSizeSum * sizeof(int);
+  MPI_Allreduce(MPI_IN_PLACE, &bw, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+  bw /= elapsed;
+
+  if (rank == 0) {
+    printf("  %-22s %.3es  %.1f GB/s/rank\n", label.c_str(), elapsed, bw / 1e9);
+    fflush(stdout);
+  }
+
+  o_u.free();
+  ogsFree(ogs);
+
+  return bw;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int rank = 0, size = 1;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  configRead(MPI_COMM_WORLD);
+  setupAide options;
+
+  int err = 0;
+  int cmdCheck = 0;
+
+  int N;
+  int Nelements;
+  int Ntests = 50;
+  size_t wordSize = 8;
+
+  while(1) {
+    static struct option long_options[] =
+    {
+      {"p-order", required_argument, 0, 'p'},
+      {"elements", required_argument, 0, 'e'},
+      {"backend", required_argument, 0, 'b'},
+      {"fp32", no_argument, 0, 'f'},
+      {"iterations", required_argument, 0, 'i'},
+      {"help", no_argument, 0, 'h'},
+      {0, 0, 0, 0}
+    };
+    int option_index = 0;
+    int c = getopt_long (argc, argv, "", long_options, &option_index);
+
+    if (c == -1)
+      break;
+
+    switch(c) {
+    case 'p':
+      N = atoi(optarg);
+      cmdCheck++;
+      break;
+    case 'e':
+      Nelements = atoi(optarg);
+      cmdCheck++;
+      break;
+    case 'b':
+      options.setArgs("THREAD MODEL", std::string(optarg));
+      cmdCheck++;
+      break;
+    case 'f':
+      wordSize = 4;
+      break;
+    case 'i':
+      Ntests = std::max(1, atoi(optarg));
+      break;
+    case 'h':
+      err = 1;
+      break;
+    default:
+      err = 1;
+    }
+  }
+
+  if(err || cmdCheck != 3) {
+    if(rank == 0)
+      printf("Usage: ./nekrs-bench-gs --p-order <n> --elements <n> --backend <CPU|CUDA|HIP|DPCPP|OPENCL>\n"
+             "                        [--fp32] [--iterations <n>]\n");
+    exit(1);
+  }
+
+  platform = platform_t::getInstance(options, MPI_COMM_WORLD, MPI_COMM_WORLD);
+  platform->options.setArgs("BUILD ONLY", "FALSE");
+
+  {
+    auto &plat = platform;
+    ogsBuildKernel_t buildKernel =
+      [plat](const std::string &fileName, const std::string &kernelName, const occa::properties &props)
+      {
+        return plat->device.buildKernel(fileName, kernelName, props);
+      };
+    oogs::compile(platform->device.occaDevice(), buildKernel, platform->device.mode(), MPI_COMM_WORLD);
+  }
+
+  const int nex = std::max(1, static_cast<int>(std::cbrt(std::max(1, Nelements / size)) + 0.5));
+  Nelements = nex * nex * nex;
+
+  std::vector<long long> vtx;
+  std::vector<hlong> ids;
+  brick(N, nex, rank, vtx, ids);
+
+  // structured (lexicographic) order is the best case
+  std::vector<int> lexicographic(Nelements);
+  std::iota(lexicographic.begin(), lexicographic.end(), 0);
+
+  // partitioner output of an unstructured mesh has no particular local order
+  std::vector<int> shuffled(lexicographic);
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(rank));
+
+  std::vector<long long> vtxShuffled(vtx.size());
+  for (dlong e = 0; e < Nelements; e++)
+    std::copy(vtx.begin() + shuffled[e] * 8, vtx.begin() + (shuffled[e] + 1) * 8, vtxShuffled.begin() + e * 8);
+
+  std::vector<int> perm(Nelements);
+  const double tStart = MPI_Wtime();
+  nrsCheck(reorderElements(perm.data(), vtxShuffled.data(), Nelements, 8),
+           MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "reorderElements failed!");
+  double tReorder = MPI_Wtime() - tStart;
+  MPI_Allreduce(MPI_IN_PLACE, &tReorder, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  std::vector<int> locality(Nelements);
+  for (dlong e = 0; e < Nelements; e++)
+    locality[e] = shuffled[perm[e]];
+
+  if (rank == 0) {
+    printf("local gather-scatter ranks=%d N=%d Nelements/rank=%d wordSize=%zu (reorder %.2es)\n",
+           size,
+           N,
+           Nelements,
+           wordSize,
+           tReorder);
+    fflush(stdout);
+  }
+
+  run("lexicographic", N, lexicographic, ids, wordSize, Ntests);
+  const double bwShuffled = run("shuffled", N, shuffled, ids, wordSize, Ntests);
+  const double bwLocality = run("shuffled+locality", N, locality, ids, wordSize, Ntests);
+
+  if (rank == 0) {
+    printf("  speedup locality/shuffled: %.2f\n", bwLocality / bwShuffled);
+    fflush(stdout);
+  }
+
+  MPI_Finalize();
+  exit(0);
+}
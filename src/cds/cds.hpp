@@ -24,6 +24,11 @@ struct cds_t {
   dlong fieldOffsetSum;
   mesh_t* meshV;
   std::vector<elliptic_t*> solver;
+
+  // scalars solved as one multi-field system
+  std::vector<int> batchIds;
+  elliptic_t* batchSolver = nullptr;
+  occa::memory o_batchEllipticCoeff;
   neknek_t* neknek;
   cvode_t* cvode;
 
@@ -119,5 +124,9 @@ struct cds_t {
 };
 
 occa::memory cdsSolve(int i, cds_t *cds, double time, int stage);
+occa::memory cdsSolveBatch(cds_t *cds, double time, int stage);
+
+// ids of scalars requesting a batched solve (empty if less than two)
+std::vector<int> cdsBatchedScalars();
 
 #endif
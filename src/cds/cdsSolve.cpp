@@ -56,3 +56,84 @@ occa::memory cdsSolve(const int is, cds_t* cds, double time, int stage)
 }
 
 
+
+occa::memory cdsSolveBatch(cds_t* cds, double time, int stage)
+{
+  const int Nbatch = cds->batchIds.size();
+  const dlong fieldOffset = cds->fieldOffset[cds->batchIds[0]];
+  mesh_t* mesh = cds->meshV;
+  elliptic_t* solver = cds->batchSolver;
+  const std::string sid = scalarDigitStr(cds->batchIds[0]);
+
+  platform->timer.tic("scalar rhs", 1);
+
+  auto o_rhs = platform->o_memPool.reserve<dfloat>(Nbatch * fieldOffset);
+  auto o_S = platform->o_memPool.reserve<dfloat>(Nbatch * fieldOffset);
+
+  const bool extrapolate =
+      platform->options.compareArgs("SCALAR" + sid + " INITIAL GUESS", "EXTRAPOLATION") && stage == 1;
+
+  for (int fld = 0; fld < Nbatch; fld++) {
+    const int is = cds->batchIds[fld];
+    auto o_rhsField = o_rhs + fld * fieldOffset;
+
+    o_rhs.copyFrom(cds->o_BF, fieldOffset, fld * fieldOffset, cds->fieldOffsetScan[is]);
+
+    cds->neumannBCKernel(mesh->Nelements,
+                         1,
+                         mesh->o_sgeo,
+                         mesh->o_vmapM,
+                         mesh->o_EToB,
+                         is,
+                         time,
+                         fieldOffset,
+                         0,
+                         cds->EToBOffset,
+                         mesh->o_x,
+                         mesh->o_y,
+                         mesh->o_z,
+                         cds->o_Ue,
+                         cds->o_S,
+                         cds->o_EToB,
+                         cds->o_diff,
+                         cds->o_rho,
+                         *(cds->o_usrwrk),
+                         o_rhsField);
+
+    if (extrapolate)
+      o_S.copyFrom(cds->o_Se, fieldOffset, fld * fieldOffset, cds->fieldOffsetScan[is]);
+    else
+      o_S.copyFrom(cds->o_S, fieldOffset, fld * fieldOffset, cds->fieldOffsetScan[is]);
+  }
+
+  platform->timer.toc("scalar rhs");
+
+  ellipticSolve(solver, o_rhs, o_S);
+
+  // report per scalar
+  for (int fld = 0; fld < Nbatch; fld++) {
+    elliptic_t* scalarSolver = cds->solver[cds->batchIds[fld]];
+    scalarSolver->Niter = solver->NiterField[fld];
+    scalarSolver->res00Norm = solver->res0NormField[fld];
+    scalarSolver->res0Norm = solver->res0NormField[fld];
+    scalarSolver->resNorm = solver->resNormField[fld];
+  }
+
+  return o_S;
+}
+
+std::vector<int> cdsBatchedScalars()
+{
+  int Nscalar = 0;
+  platform->options.getArgs("NUMBER OF SCALARS", Nscalar);
+
+  std::vector<int> ids;
+  for (int is = 0; is < Nscalar; is++) {
+    if (platform->options.compareArgs("SCALAR" + scalarDigitStr(is) + " SOLVER", "BATCHED"))
+      ids.push_back(is);
+  }
+  if (ids.size() < 2)
+    ids.clear();
+
+  return ids;
+}
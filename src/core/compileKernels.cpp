@@ -3,6 +3,7 @@
 #include "compileKernels.hpp"
 #include "bcMap.hpp"
 #include "elliptic.h"
+#include "cds.hpp"
 #include "mesh.h"
 #include "ogs.hpp"
 #include "ogsKernels.hpp"
@@ -70,6 +71,11 @@ void compileKernels() {
         registerEllipticPreconditionerKernels(section, poisson);
       }
     }
+
+    const auto batchIds = cdsBatchedScalars();
+    if (batchIds.size()) {
+      registerEllipticBatchKernels("scalar" + scalarDigitStr(batchIds[0]), batchIds.size());
+    }
   }
 
   // Scalar section is omitted
@@ -135,6 +141,12 @@ void compileKernels() {
     ofs.open(occa::env::OCCA_CACHE_DIR + "cache/compile.timestamp", 
 	     std::ofstream::out | std::ofstream::trunc);
     ofs.close();
+
+    if (platform->cacheBundle && platform->options.compareArgs("BUILD ONLY", "TRUE")) {
+      const auto bundleFile = fs::path(occa::env::OCCA_CACHE_DIR) / "kernels.bundle";
+      fileBundle(occa::env::OCCA_CACHE_DIR, bundleFile);
+      printf("kernel bundle written to %s\n", std::string(bundleFile).c_str());
+    }
   }
  
   platform->timer.set("loadKernels", loadTime);
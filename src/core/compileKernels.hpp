@@ -13,6 +13,7 @@ void registerMeshKernels(occa::properties kernelInfoBC);
 void registerNrsKernels(occa::properties kernelInfoBC);
 void registerCdsKernels(occa::properties kernelInfoBC);
 void registerEllipticKernels(std::string section, int poissonEquation);
+void registerEllipticBatchKernels(std::string section, int Nfields);
 void registerEllipticPreconditionerKernels(std::string section, int poissonEquation);
 
 std::string createOptionsPrefix(std::string section);
@@ -78,9 +78,30 @@ bool atomicsAvailable(device_t &device, MPI_Comm comm)
 
   return atomicSupported;
 }
+
+std::string memoryCategoryName(memoryCategory_t category)
+{
+  switch (category) {
+  case memoryCategory_t::mesh:
+    return "mesh";
+  case memoryCategory_t::solver:
+    return "solver";
+  case memoryCategory_t::multigrid:
+    return "MG levels";
+  case memoryCategory_t::plugin:
+    return "udf/plugins";
+  case memoryCategory_t::scratch:
+    return "scratch pool";
+  case memoryCategory_t::pinnedHost:
+    return "pinned host";
+  default:
+    return "other";
+  }
+}
 } // namespace
 
-occa::kernel device_t::buildNativeKernel(const std::string &fileName,
+occa::kernel device_t::buildNativeKernel(occa::device &device,
+                                         const std::string &fileName,
                                          const std::string &kernelName,
                                          const occa::properties &props) const
 {
@@ -88,7 +109,7 @@ occa::kernel device_t::buildNativeKernel(const std::string &fileName,
   nativeProperties["okl/enabled"] = false;
   if (this->mode() == "OpenMP")
     nativeProperties["defines/__NEKRS__OMP__"] = 1;
-  return _device.buildKernel(fileName, kernelName, nativeProperties);
+  return device.buildKernel(fileName, kernelName, nativeProperties);
 }
 
 occa::kernel device_t::buildKernel(const std::string &fullPath, const occa::properties &props) const
@@ -100,6 +121,15 @@ occa::kernel device_t::buildKernel(const std::string &fullPath, const occa::prop
 occa::kernel device_t::buildKernel(const std::string &fullPath,
                                    const occa::properties &props,
                                    const std::string &suffix) const
+{
+  occa::device device = _device;
+  return this->buildKernel(device, fullPath, props, suffix);
+}
+
+occa::kernel device_t::buildKernel(occa::device &device,
+                                   const std::string &fullPath,
+                                   const occa::properties &props,
+                                   const std::string &suffix) const
 {
   const std::string fileName = fullPath;
   std::string kernelName;
@@ -123,7 +153,7 @@ occa::kernel device_t::buildKernel(const std::string &fullPath,
     }
   }
 
-  return this->buildKernel(fileName, kernelName, props, suffix);
+  return this->buildKernel(device, fileName, kernelName, props, suffix);
 }
 
 occa::kernel device_t::buildKernel(const std::string &fileName,
@@ -131,7 +161,16 @@ occa::kernel device_t::buildKernel(const std::string &fileName,
                                    const occa::properties &props,
                                    const std::string &suffix) const
 {
+  occa::device device = _device;
+  return this->buildKernel(device, fileName, kernelName, props, suffix);
+}
 
+occa::kernel device_t::buildKernel(occa::device &device,
+                                   const std::string &fileName,
+                                   const std::string &kernelName,
+                                   const occa::properties &props,
+                                   const std::string &suffix) const
+{
   if (fileName.find(".okl") != std::string::npos) {
     occa::properties propsWithSuffix = props;
     propsWithSuffix["kernelNameSuffix"] = suffix;
@@ -155,7 +194,7 @@ occa::kernel device_t::buildKernel(const std::string &fileName,
       newKernelName += "_v" + std::to_string(kernelVariant);
     };
 
-    return _device.buildKernel(fileName, newKernelName, propsWithSuffix);
+    return device.buildKernel(fileName, newKernelName, propsWithSuffix);
   }
   else {
     std::string newKernelName = kernelName;
@@ -171,7 +210,7 @@ occa::kernel device_t::buildKernel(const std::string &fileName,
     propsWithSuffix["defines/FUNC(a)"] = std::string("TOKEN_PASTE(a,SUFFIX)");
     newKernelName += suffix;
 
-    return this->buildNativeKernel(fileName, newKernelName, propsWithSuffix);
+    return this->buildNativeKernel(device, fileName, newKernelName, propsWithSuffix);
   }
 }
 
@@ -280,40 +319,51 @@ occa::memory device_t::mallocHost(size_t Nbytes)
   occa::properties props;
   props["host"] = true;
 
+  chargeMemory();
   void *buffer = std::calloc(Nbytes, 1);
   occa::memory h_scratch = _device.malloc(Nbytes, buffer, props);
   std::free(buffer);
+  trackMemory(h_scratch, memoryCategory_t::pinnedHost);
   return h_scratch;
 }
 
 occa::memory device_t::malloc(size_t Nbytes, const occa::properties &properties)
 {
+  chargeMemory();
   void *buffer = std::calloc(Nbytes, 1);
   occa::memory o_returnValue = _device.malloc(Nbytes, buffer, properties);
   std::free(buffer);
+  trackMemory(o_returnValue);
   return o_returnValue;
 }
 
 occa::memory device_t::malloc(size_t Nbytes, const void *src, const occa::properties &properties)
 {
+  chargeMemory();
   void *buffer;
   buffer = std::calloc(Nbytes, 1);
   const void *init_ptr = (src) ? src : buffer;
   occa::memory o_returnValue = _device.malloc(Nbytes, init_ptr, properties);
   std::free(buffer);
+  trackMemory(o_returnValue);
   return o_returnValue;
 }
 
 occa::memory device_t::malloc(size_t Nword, size_t wordSize, const occa::memory& src)
 {
-  return _device.malloc(Nword * wordSize, src);
+  chargeMemory();
+  occa::memory o_returnValue = _device.malloc(Nword * wordSize, src);
+  trackMemory(o_returnValue);
+  return o_returnValue;
 }
 
 occa::memory device_t::malloc(size_t Nword, size_t wordSize)
 {
+  chargeMemory();
   void *buffer = std::calloc(Nword, wordSize);
   occa::memory o_returnValue = _device.malloc(Nword * wordSize, buffer);
   std::free(buffer);
+  trackMemory(o_returnValue);
   return o_returnValue;
 }
 
@@ -406,3 +456,162 @@ device_t::device_t(setupAide &options, comm_t &comm) : _comm(comm)
 
   deviceAtomic = atomicsAvailable(*this, _comm.mpiComm);
 }
+
+void device_t::chargeMemory()
+{
+  auto update = [](memoryUsage_t &usage, long long bytes) {
+    usage.current = bytes;
+    usage.peak = std::max(usage.peak, bytes);
+  };
+
+  // allocations bypassing device_t (e.g. occaDevice().malloc) and tracked buffers released
+  // without device_t::free (e.g. going out of scope) are only visible in the device counter
+  // and end up in other, the pool buffer is part of it too
+  const long long scratch = _scratchPool.isInitialized() ? _scratchPool.size() : 0;
+  const long long untracked = static_cast<long long>(_device.memoryAllocated()) - scratch - _memoryTracked;
+
+  auto &other = _memoryUsage[static_cast<int>(memoryCategory_t::other)];
+  update(other, other.current + untracked - _memoryUntracked);
+  _memoryUntracked = untracked;
+
+  update(_memoryUsage[static_cast<int>(memoryCategory_t::scratch)], scratch);
+}
+
+void device_t::creditMemory(const void *ptr)
+{
+  auto it = _allocations.find(ptr);
+  if (it == _allocations.end())
+    return;
+
+  _memoryUsage[static_cast<int>(it->second.category)].current -= it->second.bytes;
+  _memoryTracked -= it->second.bytes;
+  _allocations.erase(it);
+}
+
+void device_t::trackMemory(const occa::memory &o)
+{
+  trackMemory(o, _memoryCategories.empty() ? memoryCategory_t::other : _memoryCategories.back());
+}
+
+void device_t::trackMemory(const occa::memory &o, memoryCategory_t category)
+{
+  if (!o.isInitialized() || o.size() == 0)
+    return;
+
+  // an entry at the same address was released without device_t::free
+  creditMemory(o.ptr());
+
+  const long long bytes = o.size();
+  _allocations[o.ptr()] = {category, bytes};
+  _memoryTracked += bytes;
+
+  auto &usage = _memoryUsage[static_cast<int>(category)];
+  usage.current += bytes;
+  usage.peak = std::max(usage.peak, usage.current);
+
+  chargeMemory();
+}
+
+void device_t::free(occa::memory &o)
+{
+  if (!o.isInitialized())
+    return;
+
+  if (o.size())
+    creditMemory(o.ptr());
+  o.free();
+
+  chargeMemory();
+}
+
+void device_t::pushMemoryCategory(memoryCategory_t category)
+{
+  chargeMemory();
+  _memoryCategories.push_back(category);
+}
+
+void device_t::popMemoryCategory()
+{
+  nrsCheck(_memoryCategories.empty(), MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "unbalanced memory category!");
+  chargeMemory();
+  _memoryCategories.pop_back();
+}
+
+void device_t::printMemoryUsage(MPI_Comm comm)
+{
+  chargeMemory();
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const int Ncategories = _memoryUsage.size();
+
+  // per category current and peak, followed by the device totals
+  std::vector<long long> current(Ncategories + 1), peak(Ncategories + 1);
+  for (int i = 0; i < Ncategories; i++) {
+    current[i] = _memoryUsage[i].current;
+    peak[i] = _memoryUsage[i].peak;
+  }
+  current[Ncategories] = _device.memoryAllocated();
+  peak[Ncategories] = _device.maxMemoryAllocated();
+
+  std::vector<long long> currentMax(current.size()), peakMin(peak.size()), peakMax(peak.size()),
+      peakSum(peak.size());
+  MPI_Reduce(current.data(), currentMax.data(), current.size(), MPI_LONG_LONG, MPI_MAX, 0, comm);
+  MPI_Reduce(peak.data(), peakMin.data(), peak.size(), MPI_LONG_LONG, MPI_MIN, 0, comm);
+  MPI_Reduce(peak.data(), peakMax.data(), peak.size(), MPI_LONG_LONG, MPI_MAX, 0, comm);
+  MPI_Reduce(peak.data(), peakSum.data(), peak.size(), MPI_LONG_LONG, MPI_SUM, 0, comm);
+
+  if (rank != 0)
+    return;
+
+  auto MB = [](long long bytes) { return bytes / 1e6; };
+  auto printEntry = [&](const std::string &name, int i) {
+    printf("  %-22s%12.1f%12.1f%12.1f%12.1f\n",
+           name.c_str(),
+           MB(currentMax[i]),
+           MB(peakMin[i]),
+           MB(peakMax[i]),
+           MB(peakSum[i]) / size);
+  };
+
+  printf("\ndevice memory [MB]           current         peak\n");
+  printf("                                  max          min         max         avg\n");
+  for (int i = 0; i < Ncategories; i++) {
+    if (peakMax[i] != 0 || currentMax[i] != 0)
+      printEntry(memoryCategoryName(static_cast<memoryCategory_t>(i)), i);
+  }
+  printEntry("total", Ncategories);
+  fflush(stdout);
+}
+
+void device_t::printMemoryFit(dlong Nelements, MPI_Comm comm)
+{
+  printMemoryUsage(comm);
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  // pinned host buffers do not occupy device memory
+  const long long pinned = _memoryUsage[static_cast<int>(memoryCategory_t::pinnedHost)].peak;
+  const double peak = std::max(1LL, static_cast<long long>(_device.maxMemoryAllocated()) - pinned);
+  const double capacity = _device.memorySize();
+
+  double fraction = peak / capacity;
+  MPI_Allreduce(MPI_IN_PLACE, &fraction, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+  // usage scales (close to) linearly with the number of local elements
+  double maxElements = (capacity > 0 && Nelements > 0) ? Nelements * capacity / peak : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &maxElements, 1, MPI_DOUBLE, MPI_MIN, comm);
+
+  if (rank == 0) {
+    if (capacity > 0) {
+      printf("\nfit-check: peak usage is %.1f%% of device capacity (%.1f MB)\n", 100 * fraction, capacity / 1e6);
+      printf("fit-check: estimated max number of elements per device: %.0f\n", maxElements);
+    } else {
+      printf("\nfit-check: device capacity unknown for occa mode %s\n", mode().c_str());
+    }
+    fflush(stdout);
+  }
+}
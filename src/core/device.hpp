@@ -1,6 +1,9 @@
 #ifndef device_hpp_
 #define device_hpp_
 #include <string>
+#include <vector>
+#include <array>
+#include <map>
 #include <occa.hpp>
 #include <mpi.h>
 #include "nrssys.hpp"
@@ -8,6 +11,9 @@
 class setupAide;
 class comm_t;
 
+// allocation categories used for device memory accounting
+enum class memoryCategory_t { mesh, solver, multigrid, plugin, scratch, pinnedHost, other };
+
 class device_t {
   public:
     device_t(setupAide& options, comm_t& comm);
@@ -34,6 +40,9 @@ class device_t {
     occa::memory mallocHost(size_t entries);
     occa::memory mallocHost(size_t Nbytes);
 
+    // frees o and credits it back to the category it was charged to
+    void free(occa::memory &o);
+
     int id() const { return _device_id; }
     const occa::device& occaDevice() const { return _device; }
     std::string mode() const { return _device.mode(); }
@@ -53,9 +62,50 @@ class device_t {
                              const std::string &kernelName,
                              const occa::properties &props) const;
 
+    // non-collective, compiles on a separate occa device (e.g. one per JIT thread)
+    occa::kernel buildKernel(occa::device &device,
+                             const std::string &fullPath,
+                             const occa::properties &props,
+                             const std::string& suffix) const;
+
     bool deviceAtomic;
 
+    // device memory accounting
+    // allocations made through device_t are charged to the innermost category
+    // (see memoryScope_t) and credited back to it by device_t::free, anything else in
+    // the device allocation counter goes to other and the scratch pool to scratch
+    void pushMemoryCategory(memoryCategory_t category);
+    void popMemoryCategory();
+    void trackScratchPool(const occa::experimental::memoryPool &pool) { _scratchPool = pool; }
+
+    // collective, current/peak bytes per category (min/max/avg across ranks)
+    void printMemoryUsage(MPI_Comm comm);
+
+    // collective, peak usage relative to the device capacity and a linear
+    // estimate of the max number of elements fitting on a device
+    void printMemoryFit(dlong Nelements, MPI_Comm comm);
+
   private:
+    struct memoryUsage_t {
+      long long current = 0;
+      long long peak = 0;
+    };
+
+    struct allocation_t {
+      memoryCategory_t category;
+      long long bytes;
+    };
+
+    void chargeMemory();
+    void creditMemory(const void *ptr);
+    void trackMemory(const occa::memory &o);
+    void trackMemory(const occa::memory &o, memoryCategory_t category);
+
+    std::vector<memoryCategory_t> _memoryCategories;
+    std::array<memoryUsage_t, static_cast<int>(memoryCategory_t::other) + 1> _memoryUsage;
+    long long _memoryTracked = 0;
+    long long _memoryUntracked = 0;
+    occa::experimental::memoryPool _scratchPool;
 
     // non-collective
     occa::kernel buildKernel(const std::string &fullPath,
@@ -68,11 +118,37 @@ class device_t {
                              const occa::properties &props,
                              const std::string& suffix) const;
 
-    occa::kernel buildNativeKernel(const std::string &fileName,
+    occa::kernel buildKernel(occa::device &device,
+                             const std::string &fileName,
+                             const std::string &kernelName,
+                             const occa::properties &props,
+                             const std::string& suffix) const;
+
+    occa::kernel buildNativeKernel(occa::device &device,
+                             const std::string &fileName,
                              const std::string &kernelName,
                              const occa::properties &props) const;
     comm_t& _comm;
     occa::device _device;
     int _device_id;
+
+    // live allocations by pointer, non-owning
+    std::map<const void *, allocation_t> _allocations;
+};
+
+// RAII category, e.g. memoryScope_t memoryScope(platform->device, memoryCategory_t::mesh);
+class memoryScope_t
+{
+public:
+  memoryScope_t(device_t &device, memoryCategory_t category) : device_(device)
+  {
+    device_.pushMemoryCategory(category);
+  }
+  ~memoryScope_t() { device_.popMemoryCategory(); }
+  memoryScope_t(const memoryScope_t &) = delete;
+  memoryScope_t &operator=(const memoryScope_t &) = delete;
+
+private:
+  device_t &device_;
 };
 #endif
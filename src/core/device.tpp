@@ -6,29 +6,39 @@ occa::memory device_t::mallocHost(size_t entries)
   occa::properties props;
   props["host"] = true;
 
+  chargeMemory();
   void *buffer = std::calloc(entries, sizeof(T));
   occa::memory h_scratch = _device.malloc<T>(entries, buffer, props);
   std::free(buffer);
+  trackMemory(h_scratch, memoryCategory_t::pinnedHost);
   return h_scratch;
 }
 
 template <class T>
 occa::memory device_t::malloc(size_t entries, const occa::memory& src)
 {
-  return _device.malloc<T>(entries, src);
+  chargeMemory();
+  occa::memory o_returnValue = _device.malloc<T>(entries, src);
+  trackMemory(o_returnValue);
+  return o_returnValue;
 }
 
 template <class T>
 occa::memory device_t::malloc(size_t entries, const void *src)
 {
-  return _device.malloc<T>(entries, src);
+  chargeMemory();
+  occa::memory o_returnValue = _device.malloc<T>(entries, src);
+  trackMemory(o_returnValue);
+  return o_returnValue;
 }
 
 template <class T>
 occa::memory device_t::malloc(size_t entries)
 {
+  chargeMemory();
   void *buffer = std::calloc(entries, sizeof(T));
   occa::memory o_returnValue = _device.malloc<T>(entries, buffer);
   std::free(buffer);
+  trackMemory(o_returnValue);
   return o_returnValue;
 }
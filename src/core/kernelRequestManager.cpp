@@ -2,6 +2,54 @@
 #include "kernelRequestManager.hpp"
 #include "platform.hpp"
 #include "fileUtils.hpp"
+#include <atomic>
+#include <thread>
+#include <numeric>
+#include <exception>
+#include <algorithm>
+
+namespace {
+
+void reportCompileTimes(const std::vector<std::pair<std::string, double>>& fileCompileTimes, double elapsed)
+{
+  std::string txt;
+  for(auto&& [fileName, time] : fileCompileTimes)
+    txt += std::to_string(time) + " " + fileName + "\n";
+
+  const auto comm = platform->comm.mpiComm;
+  int len = txt.size();
+  std::vector<int> counts(platform->comm.mpiCommSize);
+  MPI_Gather(&len, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm);
+
+  std::vector<int> displs(counts.size() + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), displs.begin() + 1);
+  std::vector<char> buf(displs.back());
+  MPI_Gatherv(txt.data(), len, MPI_CHAR, buf.data(), counts.data(), displs.data(), MPI_CHAR, 0, comm);
+
+  MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+  if(platform->comm.mpiRank != 0) return;
+
+  std::vector<std::pair<double, std::string>> entries;
+  std::istringstream is(std::string(buf.begin(), buf.end()));
+  double time;
+  std::string fileName;
+  while(is >> time >> fileName) entries.push_back({time, fileName});
+  if(entries.empty()) return;
+
+  std::sort(entries.begin(), entries.end(), std::greater<>());
+
+  // cached files load in a few ms and are not worth reporting
+  const int maxEntries = platform->verbose ? entries.size() : 5;
+  if(entries.front().first < 1.0 && !platform->verbose) return;
+
+  printf("JIT compile time per kernel file (%.1fs wall, %d thread(s) per rank):\n", elapsed, platform->jitThreads);
+  for(int i = 0; i < std::min(maxEntries, static_cast<int>(entries.size())); ++i)
+    printf("  %8.2fs  %s\n", entries[i].first, fs::path(entries[i].second).filename().c_str());
+  fflush(stdout);
+}
+
+} // namespace
 
 kernelRequestManager_t::kernelRequestManager_t(const platform_t& m_platform)
 : kernelsProcessed(false),
@@ -98,25 +146,72 @@ kernelRequestManager_t::compile()
   const auto& device = platformRef.device;
   auto& requestToKernel = requestToKernelMap;
   auto& fileNameToRequest = fileNameToRequestMap;
-  auto compileKernels = [&kernelFiles, &requestToKernel, &fileNameToRequest, &device, rank, ranksCompiling](){
+  std::vector<std::pair<std::string, double>> fileCompileTimes;
+  auto compileKernels = [&kernelFiles, &requestToKernel, &fileNameToRequest, &device, &fileCompileTimes, rank, ranksCompiling](){
     if(rank >= ranksCompiling) return;
-    const unsigned nFiles = kernelFiles.size();
-    for(unsigned fileId = 0; fileId < nFiles; ++fileId)
-    {
-      if(fileId % ranksCompiling == rank){
-        const std::string fileName = kernelFiles[fileId];
-        for(auto && kernelRequest : fileNameToRequest[fileName]){
-          const std::string requestName = kernelRequest.requestName;
-          const std::string fileName = kernelRequest.fileName;
-          const std::string suffix = kernelRequest.suffix;
-          const occa::properties props = kernelRequest.props;
-
-          const bool buildRank0 = false;
-          auto kernel = device.buildKernel(fileName, props, suffix, buildRank0);
-          requestToKernel[requestName] = kernel;
-        }
+
+    std::vector<std::string> files;
+    for(unsigned fileId = 0; fileId < kernelFiles.size(); ++fileId)
+      if(fileId % ranksCompiling == rank) files.push_back(kernelFiles[fileId]);
+
+    fileCompileTimes.resize(files.size());
+
+    // requests of the same file share source and cache locks, so a file is the unit of work
+    auto compileFile = [&](occa::device& occaDevice, unsigned fileId, bool keepKernels){
+      const double tStart = MPI_Wtime();
+      for(auto && kernelRequest : fileNameToRequest[files[fileId]]){
+        const std::string requestName = kernelRequest.requestName;
+        const std::string fileName = kernelRequest.fileName;
+        const std::string suffix = kernelRequest.suffix;
+        const occa::properties props = kernelRequest.props;
+
+        auto kernel = device.buildKernel(occaDevice, fileName, props, suffix);
+        if(keepKernels) requestToKernel[requestName] = kernel;
       }
+      fileCompileTimes[fileId] = {files[fileId], MPI_Wtime() - tStart};
+    };
+
+    // worker devices are only safe (and cheap) for native sources on the Serial backend:
+    // no GPU context per thread and no OKL parser, the compiler runs as a separate process
+    // and the cache directories are guarded by OCCA's file locks
+    const bool threadSafeBuild =
+      device.mode() == "Serial" &&
+      std::none_of(files.begin(), files.end(), [](const std::string& file){
+        return file.find(".okl") != std::string::npos;
+      });
+    const int nThreads = threadSafeBuild ? std::min(platform->jitThreads, static_cast<int>(files.size())) : 1;
+    if(nThreads <= 1) {
+      occa::device occaDevice = device.occaDevice();
+      for(unsigned fileId = 0; fileId < files.size(); ++fileId)
+        compileFile(occaDevice, fileId, true);
+      return;
     }
+
+    // occa devices are not thread-safe, each worker builds on its own device
+    // and the binaries are loaded from cache on the main device afterwards
+    std::vector<occa::device> workerDevices;
+    for(int i = 0; i < nThreads; ++i)
+      workerDevices.emplace_back(device.occaDevice().properties());
+
+    std::atomic<unsigned> nextFile {0};
+    std::vector<std::exception_ptr> errors(nThreads);
+    std::vector<std::thread> workers;
+    for(int i = 0; i < nThreads; ++i) {
+      workers.emplace_back([&, i](){
+        try {
+          for(unsigned fileId = nextFile++; fileId < files.size(); fileId = nextFile++)
+            compileFile(workerDevices[i], fileId, false);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    for(auto&& worker : workers) worker.join();
+
+    for(auto&& workerDevice : workerDevices) workerDevice.free();
+
+    for(auto&& error : errors)
+      if(error) std::rethrow_exception(error);
   };
 
   const auto& kernelRequests = this->kernels;
@@ -136,14 +231,34 @@ kernelRequestManager_t::compile()
     }
   };
 
+  // a prebuilt bundle replaces compilation and the per-file cache broadcast 
+  // kernels missing in the bundle are JIT compiled into the node-local cache on load
+  const auto bundleFile = fs::path(getenv("OCCA_CACHE_DIR")) / "kernels.bundle";
+  int useBundle = platform->cacheBcast && platform->cacheBundle &&
+                  !platformRef.options.compareArgs("BUILD ONLY", "TRUE");
+  if(useBundle) {
+    if(platform->comm.mpiRank == 0) useBundle = fs::exists(bundleFile);
+    MPI_Bcast(&useBundle, 1, MPI_INT, 0, platform->comm.mpiComm);
+  }
+
   MPI_Barrier(platform->comm.mpiComm);
-  compileKernels();
+  if(!useBundle) {
+    const double tStart = MPI_Wtime();
+    compileKernels();
+    reportCompileTimes(fileCompileTimes, MPI_Wtime() - tStart);
+  }
 
   const auto OCCA_CACHE_DIR0 = occa::env::OCCA_CACHE_DIR;
   if(platform->cacheBcast) {
     const auto OCCA_CACHE_DIR_LOCAL = platform->tmpDir / fs::path("occa/");
     const auto srcPath = fs::path(getenv("OCCA_CACHE_DIR")); 
-    fileBcast(srcPath, OCCA_CACHE_DIR_LOCAL / "..", platform->comm.mpiComm, platform->verbose); 
+    if(useBundle) {
+      if(platform->comm.mpiRank == 0)
+        printf("loading kernel bundle %s\n", std::string(bundleFile).c_str());
+      fileBundleBcast(bundleFile, OCCA_CACHE_DIR_LOCAL, platform->comm.mpiComm, platform->verbose);
+    } else {
+      fileBcast(srcPath, OCCA_CACHE_DIR_LOCAL / "..", platform->comm.mpiComm, platform->verbose); 
+    }
     occa::env::OCCA_CACHE_DIR = std::string(OCCA_CACHE_DIR_LOCAL);
   }
 
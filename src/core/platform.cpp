@@ -47,6 +47,11 @@ platform_t::platform_t(setupAide &_options, MPI_Comm _commg, MPI_Comm _comm)
   if(getenv("NEKRS_CACHE_BCAST"))
     cacheBcast = std::stoi(getenv("NEKRS_CACHE_BCAST"));
 
+  // single file kernel bundle written in build-only mode and broadcasted instead of the cache tree
+  cacheBundle = 0;
+  if(getenv("NEKRS_CACHE_BUNDLE"))
+    cacheBundle = std::stoi(getenv("NEKRS_CACHE_BUNDLE"));
+
   // build-only mode has to use cacheBcast as well otherwise include paths 
   // change triggering a re-build 
 #if 0
@@ -54,6 +59,11 @@ platform_t::platform_t(setupAide &_options, MPI_Comm _commg, MPI_Comm _comm)
     cacheBcast = 0;
 #endif
 
+  // concurrent kernel builds per compiling rank (native kernels on the Serial backend only)
+  jitThreads = 1;
+  if(getenv("NEKRS_JIT_THREADS"))
+    jitThreads = std::max(1, std::stoi(getenv("NEKRS_JIT_THREADS")));
+
   nrsCheck(cacheLocal && cacheBcast,
            _comm, EXIT_FAILURE, 
            "%s\n", "NEKRS_CACHE_LOCAL=1 and NEKRS_CACHE_BCAST=1 is incompatible!");
@@ -69,6 +79,12 @@ platform_t::platform_t(setupAide &_options, MPI_Comm _commg, MPI_Comm _comm)
   if (options.compareArgs("ENABLE TIMER SYNC", "FALSE"))
     timer.disableSync();
 
+  if (options.compareArgs("TIMER EXPORT", "TRUE")) {
+    int traceSize = 0;
+    options.getArgs("TIMER TRACE SIZE", traceSize);
+    timer.setTraceCapacity(traceSize);
+  }
+
   flopCounter = std::make_unique<flopCounter_t>();
 
   tmpDir = "/";
@@ -180,4 +196,5 @@ platform_t::platform_t(setupAide &_options, MPI_Comm _commg, MPI_Comm _comm)
   occa::json properties;
   o_memPool = device.occaDevice().createMemoryPool(properties);
   o_memPool.setAlignment(ALIGN_SIZE);
+  device.trackScratchPool(o_memPool);
 }
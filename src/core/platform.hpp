@@ -51,6 +51,8 @@ public:
   int verbose;
   bool cacheLocal;
   bool cacheBcast; 
+  bool cacheBundle;
+  int jitThreads;
 
   occa::kernel copyDfloatToPfloatKernel;
   occa::kernel copyPfloatToDfloatKernel;
@@ -28,6 +28,17 @@ void registerGMRESKernels(const std::string &section, int Nfields)
   kernelName = "fusedResidualAndNorm";
   fileName = oklpath + kernelName + fileNameExtension;
   platform->kernels.add(sectionIdentifier + kernelName, fileName, gmresKernelInfo);
+
+  const std::string optionsPrefix = createOptionsPrefix(section);
+  if (platform->options.compareArgs(optionsPrefix + "SOLVER", "LOWSYNC")) {
+    kernelName = "lowSyncGMRESReductions";
+    fileName = oklpath + kernelName + fileNameExtension;
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, gmresKernelInfo);
+
+    kernelName = "lowSyncGMRESOrthogonalization";
+    fileName = oklpath + kernelName + fileNameExtension;
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, gmresKernelInfo);
+  }
 }
 
 void registerCombinedPCGKernels(const std::string &section, int Nfields)
@@ -64,6 +75,31 @@ void registerCombinedPCGKernels(const std::string &section, int Nfields)
   platform->kernels.add(sectionIdentifier + kernelName, fileName, combinedPCGInfo);
 }
 
+void registerPipelinedPCGKernels(const std::string &section, int Nfields)
+{
+  const std::string oklpath = getenv("NEKRS_KERNEL_DIR") + std::string("/elliptic/");
+  std::string fileName;
+  const bool serial = platform->serial;
+
+  const std::string fileNameExtension = (serial) ? ".c" : ".okl";
+  const std::string sectionIdentifier = std::to_string(Nfields) + "-";
+
+  occa::properties pipelinedPCGInfo = platform->kernelInfo;
+  pipelinedPCGInfo["defines/p_Nfields"] = Nfields;
+  pipelinedPCGInfo["defines/p_nReduction"] = PipelinedPCGId::nReduction;
+  pipelinedPCGInfo["defines/p_gamma"] = PipelinedPCGId::gamma;
+  pipelinedPCGInfo["defines/p_delta"] = PipelinedPCGId::delta;
+  pipelinedPCGInfo["defines/p_rdotr"] = PipelinedPCGId::rdotr;
+
+  std::string kernelName = "pipelinedPCGReductions";
+  fileName = oklpath + kernelName + fileNameExtension;
+  platform->kernels.add(sectionIdentifier + kernelName, fileName, pipelinedPCGInfo);
+
+  kernelName = "pipelinedPCGUpdate";
+  fileName = oklpath + kernelName + fileNameExtension;
+  platform->kernels.add(sectionIdentifier + kernelName, fileName, pipelinedPCGInfo);
+}
+
 } // namespace
 
 void registerEllipticKernels(std::string section, int poissonEquation)
@@ -118,6 +154,10 @@ void registerEllipticKernels(std::string section, int poissonEquation)
     registerCombinedPCGKernels(section, Nfields);
   }
 
+  if (platform->options.compareArgs(optionsPrefix + "SOLVER", "PCG+PIPELINED")) {
+    registerPipelinedPCGKernels(section, Nfields);
+  }
+
   {
     const std::string oklpath = getenv("NEKRS_KERNEL_DIR") + std::string("/elliptic/");
     std::string fileName, kernelName;
@@ -187,6 +227,13 @@ void registerEllipticKernels(std::string section, int poissonEquation)
     platform->options.setArgs(optionsPrefix + "ELLIPTIC COEFF FIELD", "TRUE");
   }
 
+  int cubNq = 0;
+  if (platform->options.compareArgs(optionsPrefix + "ELLIPTIC INTEGRATION", "CUBATURE")) {
+    int cubN = 0;
+    platform->options.getArgs("CUBATURE POLYNOMIAL DEGREE", cubN);
+    cubNq = cubN + 1;
+  }
+
   for (auto &&coeffField : {true, false}) {
     if (platform->options.compareArgs(optionsPrefix + "ELLIPTIC COEFF FIELD", "TRUE") != coeffField)
       continue;
@@ -196,7 +243,7 @@ void registerEllipticKernels(std::string section, int poissonEquation)
       kernelNamePrefix += (stressForm) ? "Stress" : "Block";
 
     kernelName = "Ax";
-    kernelName += "Coeff";
+    kernelName += (cubNq > N + 1) ? "Cubature" : "Coeff";
     if (platform->options.compareArgs("ELEMENT MAP", "TRILINEAR"))
       kernelName += "Trilinear";
     kernelName += suffix;
@@ -208,6 +255,7 @@ void registerEllipticKernels(std::string section, int poissonEquation)
     auto axKernel = benchmarkAx(NelemBenchmark,
                                 N + 1,
                                 N,
+                                cubNq,
                                 !coeffField,
                                 poissonEquation,
                                 false,
@@ -232,3 +280,39 @@ void registerEllipticKernels(std::string section, int poissonEquation)
   fileName = oklpath + "ellipticBlockUpdatePCG" + fileNameExtension;
   platform->kernels.add(sectionIdentifier + "ellipticBlockUpdatePCG", fileName, kernelInfo);
 }
+
+void registerEllipticBatchKernels(std::string section, int Nfields)
+{
+  int N;
+  platform->options.getArgs("POLYNOMIAL DEGREE", N);
+
+  const bool serial = platform->serial;
+  const std::string fileNameExtension = (serial) ? ".c" : ".okl";
+  const std::string oklpath = getenv("NEKRS_KERNEL_DIR") + std::string("/elliptic/");
+  const std::string sectionIdentifier = "batch" + std::to_string(Nfields) + "-";
+
+  occa::properties kernelInfo = platform->kernelInfo + meshKernelProperties(N);
+  kernelInfo["defines/p_Nfields"] = Nfields;
+
+  std::string kernelName = "ellipticBatchPartialAxCoeffHex3D";
+  std::string fileName = oklpath + kernelName + fileNameExtension;
+  platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+
+  kernelName = "ellipticBlockUpdatePCG";
+  fileName = oklpath + kernelName + fileNameExtension;
+  platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+
+  for (auto &&name : {"batchedPCGInnerProd", "batchedPCGUpdateP", "batchedPCGUpdate"}) {
+    kernelName = name;
+    fileName = oklpath + kernelName + fileNameExtension;
+    platform->kernels.add(sectionIdentifier + kernelName, fileName, kernelInfo);
+  }
+
+  // diagonal is assembled field by field
+  occa::properties diagKernelInfo = kernelInfo;
+  diagKernelInfo["defines/p_Nfields"] = 1;
+  diagKernelInfo["defines/pfloat"] = pfloatString;
+  kernelName = "ellipticBlockBuildDiagonalHex3D";
+  fileName = oklpath + kernelName + ".okl";
+  platform->kernels.add(sectionIdentifier + kernelName, fileName, diagKernelInfo);
+}
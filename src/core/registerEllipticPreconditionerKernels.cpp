@@ -52,6 +52,7 @@ void registerAxKernels(const std::string &section, int N, int poissonEquation)
     auto axKernel = benchmarkAx(NelemBenchmark,
                                 Nq,
                                 Nq - 1,
+                                0,
                                 !coeffField,
                                 poissonEquation,
                                 false,
@@ -149,6 +150,12 @@ void registerCommonMGPreconditionerKernels(int N, occa::properties kernelInfo, i
     fileName = oklpath + kernelName + ".okl";
     platform->kernels.add(kernelName + orderSuffix, fileName, kernelInfo, orderSuffix);
 
+    // fused Jacobi-Chebyshev updates
+    for (std::string name : {"initJacobiChebyshev", "updateJacobiChebyshev", "updateJacobiFourthKindChebyshev"}) {
+      fileName = oklpath + name + ".okl";
+      platform->kernels.add(name + orderSuffix, fileName, kernelInfo, orderSuffix);
+    }
+
     occa::properties buildDiagInfo = kernelInfo;
     if (poissonEquation)
       buildDiagInfo["defines/p_poisson"] = 1;
@@ -185,7 +192,18 @@ void registerSchwarzKernels(const std::string &section, int N)
     properties["defines/p_Nq_e"] = Nq_e;
     properties["defines/p_restrict"] = 0;
     bool useRAS = platform->options.compareArgs(optionsPrefix + "MULTIGRID SMOOTHER", "RAS");
-    const std::string suffix = std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat");
+    int fdmStorage = 0;
+    std::string storageSuffix;
+    if (platform->options.compareArgs(optionsPrefix + "MULTIGRID SCHWARZ STORAGE", "FP16")) {
+      fdmStorage = 1;
+      storageSuffix = "FP16";
+    }
+    else if (platform->options.compareArgs(optionsPrefix + "MULTIGRID SCHWARZ STORAGE", "BF16")) {
+      fdmStorage = 2;
+      storageSuffix = "BF16";
+    }
+    const std::string suffix =
+        std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat") + storageSuffix;
     if (useRAS) {
       properties["defines/p_restrict"] = 1;
     }
@@ -203,6 +221,7 @@ void registerSchwarzKernels(const std::string &section, int N)
     auto fdmKernel = benchmarkFDM(NelemBenchmark,
                                   Nq_e,
                                   sizeof(pfloat),
+                                  fdmStorage,
                                   useRAS,
                                   verbosity,
                                   elliptic_t::targetTimeBenchmark,
@@ -234,6 +253,19 @@ void registerFineLevelKernels(const std::string &section, int N, int poissonEqua
 }
 void registerSEMFEMKernels(const std::string &section, int N, int poissonEquation);
 
+void registerSAAMGKernels(const std::string &section)
+{
+  const std::string optionsPrefix = createOptionsPrefix(section);
+  if (!platform->options.compareArgs(optionsPrefix + "COARSE SOLVER", "SAAMG"))
+    return;
+
+  const std::string oklpath = getenv("NEKRS_KERNEL_DIR") + std::string("/elliptic/");
+  for (auto &&kernelName : {"amgSpMV", "amgResidual", "amgChebyshevUpdate"}) {
+    platform->kernels.add(kernelName, oklpath + kernelName + ".okl", platform->kernelInfo);
+  }
+  platform->kernels.add("amgGather", oklpath + "gather.okl", platform->kernelInfo);
+}
+
 void registerMultigridLevelKernels(const std::string &section, int Nf, int N, int poissonEquation)
 {
   const std::string optionsPrefix = createOptionsPrefix(section);
@@ -317,6 +349,7 @@ void registerMultiGridKernels(const std::string &section, int poissonEquation)
   }
   const int coarseLevel = levels.back();
   if (platform->options.compareArgs(optionsPrefix + "MULTIGRID COARSE SOLVE", "TRUE")) {
+    registerSAAMGKernels(section);
     if (platform->options.compareArgs(optionsPrefix + "MULTIGRID SEMFEM", "TRUE")) {
       registerSEMFEMKernels(section, coarseLevel, poissonEquation);
     }
@@ -375,6 +408,7 @@ void registerEllipticPreconditionerKernels(std::string section, int poissonEquat
     registerMultiGridKernels(section, poissonEquation);
   }
   if (platform->options.compareArgs(optionsPrefix + "PRECONDITIONER", "SEMFEM")) {
+    registerSAAMGKernels(section);
     registerSEMFEMKernels(section, N, poissonEquation);
   }
   if (platform->options.compareArgs(optionsPrefix + "PRECONDITIONER", "JACOBI")) {
@@ -3,6 +3,10 @@
 #include <map>
 #include <algorithm>
 #include <tuple>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <numeric>
 
 #include "timer.hpp"
 #include "platform.hpp"
@@ -33,14 +37,85 @@ int enabled;
 occa::device device_;
 MPI_Comm comm_;
 
+// time spent waiting for the other ranks, accumulated per rank
 inline void sync()
 {
-  if (enable_sync_)
+  if (enable_sync_) {
+    const double tStart = MPI_Wtime();
     MPI_Barrier(comm_);
+    auto &entry = m_["sync wait"];
+    entry.hostElapsed += MPI_Wtime() - tStart;
+    entry.deviceElapsed = entry.hostElapsed;
+    entry.count++;
+  }
 }
 
 double tElapsedTimeSolve = 0;
 
+struct scopeNode_t {
+  std::string name;
+  int parent;
+  int depth;
+  std::map<std::string, int> children;
+  long long int count;
+  double elapsed;
+};
+std::vector<scopeNode_t> scopes_ = {{"", -1, -1, {}, 0, 0}};
+
+struct activeScope_t {
+  int node;
+  double startTime;
+};
+std::vector<activeScope_t> scopeStack_;
+
+struct traceEvent_t {
+  int node;
+  double startTime;
+  double duration;
+};
+std::vector<traceEvent_t> trace_;
+size_t traceCapacity_ = 0;
+size_t traceHead_ = 0;
+
+double t0_ = 0;
+
+std::string scopePath(int node)
+{
+  std::string path = scopes_[node].name;
+  for (int p = scopes_[node].parent; p > 0; p = scopes_[p].parent)
+    path = scopes_[p].name + "/" + path;
+  return path;
+}
+
+std::string jsonEscape(const std::string &s)
+{
+  std::string out;
+  for (auto c : s) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+// rank-ordered collective write of a text chunk per rank
+void writeOrdered(const std::string &fileName, const std::string &txt, MPI_Comm comm)
+{
+  long long int len = txt.size();
+  long long int offset = 0;
+  MPI_Exscan(&len, &offset, 1, MPI_LONG_LONG_INT, MPI_SUM, comm);
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0)
+    offset = 0;
+
+  MPI_File fh;
+  MPI_File_delete(fileName.c_str(), MPI_INFO_NULL);
+  MPI_File_open(comm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+  MPI_File_write_at_all(fh, offset, txt.data(), static_cast<int>(len), MPI_CHAR, MPI_STATUS_IGNORE);
+  MPI_File_close(&fh);
+}
+
 auto sumAllMatchingTags(std::function<bool(std::string)> predicate, const std::string metric)
 {
   long long int count = 0;
@@ -76,6 +151,7 @@ void timer_t::init(MPI_Comm comm, occa::device device, int ifSyncDefault, int en
   comm_ = comm;
   enable_sync_ = enableSync;
   enabled = 1;
+  t0_ = MPI_Wtime();
 }
 
 void timer_t::set(const std::string tag, double time, long long int count)
@@ -103,12 +179,23 @@ void timer_t::reset()
     it.second.deviceElapsed = 0;
     it.second.count = 0;
   }
+  for (auto &node : scopes_) {
+    node.count = 0;
+    node.elapsed = 0;
+  }
+  trace_.clear();
+  traceHead_ = 0;
   ogsResetTime();
 }
 
 void timer_t::clear()
 {
   m_.clear();
+  scopes_.resize(1);
+  scopes_[0].children.clear();
+  scopeStack_.clear();
+  trace_.clear();
+  traceHead_ = 0;
   ogsResetTime();
 }
 
@@ -135,6 +222,7 @@ void timer_t::deviceTic(const std::string tag, int ifSync)
     return;
   if (ifSync)
     sync();
+  beginScope(tag);
   m_[tag].startTag = device_.tagStream();
 }
 
@@ -144,6 +232,7 @@ void timer_t::deviceTic(const std::string tag)
     return;
   if (ifSync())
     sync();
+  beginScope(tag);
   m_[tag].startTag = device_.tagStream();
 }
 
@@ -151,6 +240,7 @@ void timer_t::deviceToc(const std::string tag)
 {
   if (!enabled)
     return;
+  endScope(tag);
   occa::streamTag stopTag = device_.tagStream();
 
   std::map<std::string, tagData>::iterator it = m_.find(tag);
@@ -167,6 +257,7 @@ void timer_t::hostTic(const std::string tag, int ifSync)
     return;
   if (ifSync)
     sync();
+  beginScope(tag);
   m_[tag].startTime = MPI_Wtime();
 }
 
@@ -176,6 +267,7 @@ void timer_t::hostTic(const std::string tag)
     return;
   if (ifSync())
     sync();
+  beginScope(tag);
   m_[tag].startTime = MPI_Wtime();
 }
 
@@ -183,6 +275,7 @@ void timer_t::hostToc(const std::string tag)
 {
   if (!enabled)
     return;
+  endScope(tag);
   double stopTime = MPI_Wtime();
 
   auto it = m_.find(tag);
@@ -199,6 +292,7 @@ void timer_t::tic(const std::string tag, int ifSync)
     return;
   if (ifSync)
     sync();
+  beginScope(tag);
   m_[tag].startTime = MPI_Wtime();
   m_[tag].startTag = device_.tagStream();
 }
@@ -209,6 +303,7 @@ void timer_t::tic(const std::string tag)
     return;
   if (ifSync())
     sync();
+  beginScope(tag);
   m_[tag].startTime = MPI_Wtime();
   m_[tag].startTag = device_.tagStream();
 }
@@ -217,6 +312,7 @@ void timer_t::toc(const std::string tag)
 {
   if (!enabled)
     return;
+  endScope(tag);
   auto stopTime = MPI_Wtime();
   auto stopTag = device_.tagStream();
 
@@ -369,6 +465,13 @@ void timer_t::printStatEntry(std::string name, double time, double tNorm)
   }
 }
 
+double timer_t::busyTime()
+{
+  const double tSolve = query("elapsedStepSum", "DEVICE:MAX");
+  auto it = m_.find("sync wait");
+  return (it == m_.end()) ? tSolve : tSolve - it->second.hostElapsed;
+}
+
 void timer_t::printRunStat(int step)
 {
   int rank;
@@ -433,6 +536,32 @@ void timer_t::printRunStat(int step)
       std::cout << "    flops/rank          " << flops << "\n";
   }
 
+  // busy time = solve time - waiting in the synchronized timers
+  // waits inside other collectives (gather-scatter, unsynchronized reductions) still count
+  // as busy, so the reported imbalance is a lower bound
+  if (tElapsedTimeSolve > 0 && m_.find("sync wait") != m_.end()) {
+    const double tBusy = busyTime();
+
+    struct {
+      double val;
+      int rank;
+    } busyMax = {tBusy, rank};
+    MPI_Allreduce(MPI_IN_PLACE, &busyMax, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm_);
+
+    double busyMin, busySum;
+    MPI_Allreduce(&tBusy, &busyMin, 1, MPI_DOUBLE, MPI_MIN, comm_);
+    MPI_Allreduce(&tBusy, &busySum, 1, MPI_DOUBLE, MPI_SUM, comm_);
+    const double busyAvg = busySum / platform->comm.mpiCommSize;
+
+    if (rank == 0 && busyAvg > 0) {
+      std::cout << "    busy min            " << busyMin << "s\n";
+      std::cout << "    busy max            " << busyMax.val << "s  (rank " << busyMax.rank << ")\n";
+      std::cout << "    load imbalance      " << busyMax.val / busyAvg
+                << "  (max/avg lower bound, at least "
+                << printPercentage(busyMax.val - busyAvg, tElapsedTimeSolve) << "% of solve)\n";
+    }
+  }
+
   auto lpmLocalKernelPredicate = [](const std::string &tag) {
     return tag.find("lpm_t::") != std::string::npos && tag.find("localKernel") != std::string::npos;
   };
@@ -620,4 +749,179 @@ std::vector<std::string> timer_t::tags()
   return entries;
 }
 
+void timer_t::beginScope(const std::string tag)
+{
+  if (!enabled)
+    return;
+
+  // a repeated tic restarts the open scope
+  if (!scopeStack_.empty() && scopes_[scopeStack_.back().node].name == tag) {
+    scopeStack_.back().startTime = MPI_Wtime();
+    return;
+  }
+
+  const int parent = scopeStack_.empty() ? 0 : scopeStack_.back().node;
+  auto it = scopes_[parent].children.find(tag);
+  int node;
+  if (it == scopes_[parent].children.end()) {
+    node = scopes_.size();
+    scopes_.push_back({tag, parent, scopes_[parent].depth + 1, {}, 0, 0});
+    scopes_[parent].children[tag] = node;
+  } else {
+    node = it->second;
+  }
+
+  scopeStack_.push_back({node, MPI_Wtime()});
+}
+
+void timer_t::endScope(const std::string tag)
+{
+  if (!enabled)
+    return;
+  const double stopTime = MPI_Wtime();
+
+  auto it = std::find_if(scopeStack_.rbegin(), scopeStack_.rend(), [&](const activeScope_t &s) {
+    return scopes_[s.node].name == tag;
+  });
+  if (it == scopeStack_.rend())
+    return;
+
+  // inner scopes left open are dropped
+  const auto scope = *it;
+  scopeStack_.erase(std::next(it).base(), scopeStack_.end());
+
+  const double elapsed = stopTime - scope.startTime;
+  scopes_[scope.node].elapsed += elapsed;
+  scopes_[scope.node].count++;
+
+  if (traceCapacity_ > 0) {
+    const traceEvent_t event{scope.node, scope.startTime - t0_, elapsed};
+    if (trace_.size() < traceCapacity_) {
+      trace_.push_back(event);
+    } else {
+      trace_[traceHead_] = event;
+      traceHead_ = (traceHead_ + 1) % traceCapacity_;
+    }
+  }
+}
+
+void timer_t::setTraceCapacity(size_t nEvents)
+{
+  traceCapacity_ = nEvents;
+  trace_.clear();
+  trace_.reserve(nEvents);
+  traceHead_ = 0;
+}
+
+void timer_t::exportTrace(const std::string fileName)
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  std::ostringstream txt;
+  txt.precision(3);
+  txt << std::fixed;
+  if (rank == 0)
+    txt << "{\"traceEvents\":[\n";
+  else
+    txt << ",\n";
+  txt << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"args\":{\"name\":\"rank " << rank
+      << "\"}}";
+
+  // oldest first
+  for (size_t i = 0; i < trace_.size(); i++) {
+    const auto &event = trace_[(traceHead_ + i) % trace_.size()];
+    txt << ",\n{\"name\":\"" << jsonEscape(scopes_[event.node].name) << "\",\"cat\":\""
+        << jsonEscape(scopePath(event.node)) << "\",\"ph\":\"X\",\"ts\":" << 1e6 * event.startTime
+        << ",\"dur\":" << 1e6 * event.duration << ",\"pid\":" << rank << ",\"tid\":0}";
+  }
+
+  if (rank == size - 1)
+    txt << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  writeOrdered(fileName, txt.str(), comm_);
+}
+
+void timer_t::exportStats(const std::string fileName)
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  // union of scope paths across ranks
+  std::string localPaths;
+  std::map<std::string, int> pathToNode;
+  for (int node = 1; node < static_cast<int>(scopes_.size()); node++) {
+    const auto path = scopePath(node);
+    pathToNode[path] = node;
+    localPaths += path + "\n";
+  }
+
+  int len = localPaths.size();
+  std::vector<int> counts(size);
+  MPI_Allgather(&len, 1, MPI_INT, counts.data(), 1, MPI_INT, comm_);
+  std::vector<int> displs(size + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), displs.begin() + 1);
+  std::vector<char> buf(displs.back());
+  MPI_Allgatherv(localPaths.data(), len, MPI_CHAR, buf.data(), counts.data(), displs.data(), MPI_CHAR, comm_);
+
+  std::set<std::string> pathSet;
+  {
+    std::istringstream is(std::string(buf.begin(), buf.end()));
+    std::string path;
+    while (std::getline(is, path))
+      pathSet.insert(path);
+  }
+  const std::vector<std::string> paths(pathSet.begin(), pathSet.end());
+  const int nPaths = paths.size();
+
+  // inclusive, self time and calls per path
+  std::vector<double> incl(nPaths, 0), self(nPaths, 0), calls(nPaths, 0);
+  for (int i = 0; i < nPaths; i++) {
+    auto it = pathToNode.find(paths[i]);
+    if (it == pathToNode.end())
+      continue;
+    const auto &node = scopes_[it->second];
+    incl[i] = node.elapsed;
+    self[i] = node.elapsed;
+    for (auto &&[name, child] : node.children)
+      self[i] -= scopes_[child].elapsed;
+    calls[i] = node.count;
+  }
+
+  auto reduce = [&](std::vector<double> &v, MPI_Op op) {
+    std::vector<double> out(nPaths);
+    MPI_Reduce(v.data(), out.data(), nPaths, MPI_DOUBLE, op, 0, comm_);
+    return out;
+  };
+  const auto inclMin = reduce(incl, MPI_MIN);
+  const auto inclMax = reduce(incl, MPI_MAX);
+  const auto inclSum = reduce(incl, MPI_SUM);
+  const auto selfMin = reduce(self, MPI_MIN);
+  const auto selfMax = reduce(self, MPI_MAX);
+  const auto selfSum = reduce(self, MPI_SUM);
+  const auto callsSum = reduce(calls, MPI_SUM);
+
+  if (rank != 0)
+    return;
+
+  std::ofstream f(fileName, std::ios::trunc);
+  f.precision(6);
+  f << std::scientific;
+  f << "{\n  \"ranks\": " << size << ",\n  \"scopes\": [";
+  for (int i = 0; i < nPaths; i++) {
+    const auto name = paths[i].substr(paths[i].rfind('/') + 1);
+    const auto depth = std::count(paths[i].begin(), paths[i].end(), '/');
+    const double avg = inclSum[i] / size;
+    f << ((i > 0) ? "," : "") << "\n    {\"path\": \"" << jsonEscape(paths[i]) << "\", \"name\": \""
+      << jsonEscape(name) << "\", \"depth\": " << depth << ", \"calls\": " << callsSum[i] / size
+      << ",\n     \"time\": {\"min\": " << inclMin[i] << ", \"max\": " << inclMax[i] << ", \"avg\": " << avg
+      << "},\n     \"self\": {\"min\": " << selfMin[i] << ", \"max\": " << selfMax[i]
+      << ", \"avg\": " << selfSum[i] / size << "},\n     \"imbalance\": " << ((avg > 0) ? inclMax[i] / avg : 1.0)
+      << "}";
+  }
+  f << "\n  ]\n}\n";
+}
+
 } // namespace timer
@@ -36,6 +36,9 @@ double deviceElapsed(const std::string tag);
 long long int count(const std::string tag);
 double query(const std::string tag,std::string metric);
 void printRunStat(int step);
+
+// collective, solve time minus the wait in the synchronized timers of this rank
+double busyTime();
 void printStatEntry(std::string name, std::string tag, std::string type, double tNorm);
 void printStatEntry(std::string name, double time, double tNorm);
 void printStatEntry(std::string name, double tTag, long long int nCalls, double tNorm);
@@ -45,6 +48,32 @@ void printAll();
 
 // obtain all tags registered with the timer
 std::vector<std::string> tags();
+
+// hierarchical scopes nested in begin/end order (host wall time)
+// tic/toc open and close a scope of the same name
+void beginScope(const std::string tag);
+void endScope(const std::string tag);
+
+// bounded per-rank event recording, 0 disables it
+void setTraceCapacity(size_t nEvents);
+
+// collective exports
+void exportTrace(const std::string fileName); // Chrome trace-event format, one pid per rank
+void exportStats(const std::string fileName); // per scope min/max/avg across ranks
+};
+
+// RAII scope, e.g. timer::scope_t scope(platform->timer, "coarse grid");
+class scope_t
+{
+public:
+  scope_t(timer_t &timer, const std::string &tag) : timer_(timer), tag_(tag) { timer_.beginScope(tag_); }
+  ~scope_t() { timer_.endScope(tag_); }
+  scope_t(const scope_t &) = delete;
+  scope_t &operator=(const scope_t &) = delete;
+
+private:
+  timer_t &timer_;
+  const std::string tag_;
 };
 }
 
@@ -8,6 +8,8 @@
 #include <cstring>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <limits>
 
 #include "device.hpp"
 #include "platform.hpp"
@@ -241,3 +243,147 @@ bool isFileEmpty(const char *file)
   f.close();
   return isEmpty;
 }
+
+// bundle layout: magic | nEntries | per entry (offset, size, perms, path length, path) | file data
+namespace {
+constexpr char bundleMagic[8] = {'N', 'R', 'S', 'B', 'N', 'D', 'L', '1'};
+
+struct bundleEntry_t {
+  uint64_t offset;
+  uint64_t size;
+  uint32_t perms;
+  std::string path;
+};
+
+template <typename T> void appendBytes(std::vector<char> &buf, const T &val)
+{
+  const auto p = reinterpret_cast<const char *>(&val);
+  buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+template <typename T> T readBytes(const char *&p)
+{
+  T val;
+  std::memcpy(&val, p, sizeof(T));
+  p += sizeof(T);
+  return val;
+}
+} // namespace
+
+void fileBundle(const fs::path &srcDir, const fs::path &bundleFile)
+{
+  std::vector<bundleEntry_t> entries;
+  for (const auto &entry : fs::recursive_directory_iterator(srcDir)) {
+    if (!entry.is_regular_file() || entry.path() == bundleFile)
+      continue;
+    bundleEntry_t e;
+    e.path = fs::relative(entry.path(), srcDir);
+    e.size = entry.file_size();
+    e.perms = static_cast<uint32_t>(entry.status().permissions());
+    entries.push_back(e);
+  }
+  // sorted by cache path (request hash) for a deterministic index
+  std::sort(entries.begin(), entries.end(), [](const bundleEntry_t &a, const bundleEntry_t &b) {
+    return a.path < b.path;
+  });
+
+  std::vector<char> index;
+  index.insert(index.end(), bundleMagic, bundleMagic + sizeof(bundleMagic));
+  appendBytes(index, static_cast<uint64_t>(entries.size()));
+  size_t indexBytes = index.size();
+  for (const auto &e : entries)
+    indexBytes += 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t) + e.path.size();
+
+  uint64_t offset = indexBytes;
+  for (auto &&e : entries) {
+    e.offset = offset;
+    offset += e.size;
+    appendBytes(index, e.offset);
+    appendBytes(index, e.size);
+    appendBytes(index, e.perms);
+    appendBytes(index, static_cast<uint32_t>(e.path.size()));
+    index.insert(index.end(), e.path.begin(), e.path.end());
+  }
+
+  const auto tmpFile = fs::path(std::string(bundleFile) + ".tmp");
+  {
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    out.write(index.data(), index.size());
+    for (const auto &e : entries) {
+      std::ifstream in(srcDir / e.path, std::ios::binary);
+      out << in.rdbuf();
+    }
+  }
+  fileSync(tmpFile.c_str());
+  fs::rename(tmpFile, bundleFile);
+}
+
+void fileBundleBcast(const fs::path &bundleFile, const fs::path &dstDir, MPI_Comm comm, int verbose)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  MPI_Comm commLocal;
+  int localRank;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &commLocal);
+  MPI_Comm_rank(commLocal, &localRank);
+
+  MPI_Comm commNode;
+  MPI_Comm_split(comm, (localRank == 0) ? 1 : MPI_UNDEFINED, rank, &commNode);
+
+  if (commNode != MPI_COMM_NULL) {
+    int nodeRank;
+    MPI_Comm_rank(commNode, &nodeRank);
+
+    // single read on the root, one broadcast to all node leaders
+    uint64_t bundleSize = 0;
+    if (nodeRank == 0)
+      bundleSize = fs::file_size(bundleFile);
+    MPI_Bcast(&bundleSize, 1, MPI_UINT64_T, 0, commNode);
+
+    std::vector<char> buf(bundleSize);
+    if (nodeRank == 0) {
+      std::ifstream in(bundleFile, std::ios::binary);
+      in.read(buf.data(), bundleSize);
+    }
+
+    constexpr uint64_t maxChunk = std::numeric_limits<int>::max();
+    for (uint64_t pos = 0; pos < bundleSize; pos += maxChunk)
+      MPI_Bcast(buf.data() + pos, std::min(maxChunk, bundleSize - pos), MPI_CHAR, 0, commNode);
+
+    nrsCheck(bundleSize < sizeof(bundleMagic) + sizeof(uint64_t) ||
+                 std::memcmp(buf.data(), bundleMagic, sizeof(bundleMagic)),
+             MPI_COMM_SELF,
+             EXIT_FAILURE,
+             "invalid bundle %s!\n",
+             std::string(bundleFile).c_str());
+
+    const char *p = buf.data() + sizeof(bundleMagic);
+    const auto nEntries = readBytes<uint64_t>(p);
+    for (uint64_t i = 0; i < nEntries; i++) {
+      bundleEntry_t e;
+      e.offset = readBytes<uint64_t>(p);
+      e.size = readBytes<uint64_t>(p);
+      e.perms = readBytes<uint32_t>(p);
+      const auto len = readBytes<uint32_t>(p);
+      e.path.assign(p, len);
+      p += len;
+
+      const auto filePath = dstDir / e.path;
+      _mkdir(filePath);
+      {
+        std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+        out.write(buf.data() + e.offset, e.size);
+      }
+      fs::permissions(filePath, static_cast<fs::perms>(e.perms) | fs::perms::owner_read | fs::perms::owner_write);
+
+      if (verbose && nodeRank == 0)
+        std::cout << __func__ << ": " << e.path << " (" << e.size << " bytes)" << std::endl;
+    }
+
+    MPI_Comm_free(&commNode);
+  }
+
+  MPI_Comm_free(&commLocal);
+  MPI_Barrier(comm);
+}
@@ -13,4 +13,9 @@ bool fileExists(const char *file);
 void fileBcast(const std::filesystem::path &srcPath, const std::filesystem::path &dstPath,
                MPI_Comm comm, int verbose);
 
+// single file archive of a directory tree (e.g. the OCCA cache)
+void fileBundle(const std::filesystem::path &srcDir, const std::filesystem::path &bundleFile);
+void fileBundleBcast(const std::filesystem::path &bundleFile, const std::filesystem::path &dstDir,
+                     MPI_Comm comm, int verbose);
+
 #endif
@@ -0,0 +1,341 @@
+#include <cstdint>
+#include <cstring>
+#include "mesh.h"
+#include "fldCompression.hpp"
+
+namespace {
+
+// adaptive binary range coder (LZMA style) with 11-bit probabilities
+constexpr int probBits = 11;
+constexpr int probInit = (1 << probBits) / 2;
+constexpr int probShift = 5;
+constexpr uint32_t topValue = 1u << 24;
+
+using byteModel_t = std::array<uint16_t, 256>;
+using word_t = std::conditional<sizeof(dfloat) == sizeof(uint64_t), uint64_t, uint32_t>::type;
+
+byteModel_t byteModel()
+{
+  byteModel_t probs;
+  probs.fill(probInit);
+  return probs;
+}
+
+class rangeEncoder_t
+{
+public:
+  rangeEncoder_t(std::vector<unsigned char> &out) : out(out) {}
+
+  void encodeBit(uint16_t &prob, int bit)
+  {
+    const uint32_t bound = (range >> probBits) * prob;
+    if (bit == 0) {
+      range = bound;
+      prob += ((1 << probBits) - prob) >> probShift;
+    } else {
+      low += bound;
+      range -= bound;
+      prob -= prob >> probShift;
+    }
+    while (range < topValue) {
+      range <<= 8;
+      shiftLow();
+    }
+  }
+
+  // msb first through a binary tree of 255 contexts
+  void encodeByte(byteModel_t &probs, unsigned char byte)
+  {
+    int m = 1;
+    for (int i = 7; i >= 0; i--) {
+      const int bit = (byte >> i) & 1;
+      encodeBit(probs[m], bit);
+      m = (m << 1) | bit;
+    }
+  }
+
+  void flush()
+  {
+    for (int i = 0; i < 5; i++)
+      shiftLow();
+  }
+
+private:
+  void shiftLow()
+  {
+    if (static_cast<uint32_t>(low) < 0xFF000000u || (low >> 32) != 0) {
+      unsigned char temp = cache;
+      do {
+        out.push_back(static_cast<unsigned char>(temp + static_cast<unsigned char>(low >> 32)));
+        temp = 0xFF;
+      } while (--cacheSize != 0);
+      cache = static_cast<unsigned char>(static_cast<uint32_t>(low) >> 24);
+    }
+    cacheSize++;
+    low = (low & 0x00FFFFFFu) << 8;
+  }
+
+  std::vector<unsigned char> &out;
+  uint64_t low = 0;
+  uint32_t range = 0xFFFFFFFFu;
+  unsigned char cache = 0;
+  uint64_t cacheSize = 1;
+};
+
+class rangeDecoder_t
+{
+public:
+  rangeDecoder_t(const unsigned char *in, size_t size) : in(in), size(size)
+  {
+    for (int i = 0; i < 5; i++)
+      code = (code << 8) | next();
+  }
+
+  int decodeBit(uint16_t &prob)
+  {
+    const uint32_t bound = (range >> probBits) * prob;
+    int bit;
+    if (code < bound) {
+      range = bound;
+      prob += ((1 << probBits) - prob) >> probShift;
+      bit = 0;
+    } else {
+      code -= bound;
+      range -= bound;
+      prob -= prob >> probShift;
+      bit = 1;
+    }
+    while (range < topValue) {
+      range <<= 8;
+      code = (code << 8) | next();
+    }
+    return bit;
+  }
+
+  unsigned char decodeByte(byteModel_t &probs)
+  {
+    int m = 1;
+    for (int i = 0; i < 8; i++)
+      m = (m << 1) | decodeBit(probs[m]);
+    return static_cast<unsigned char>(m - 256);
+  }
+
+private:
+  unsigned char next() { return (pos < size) ? in[pos++] : 0; }
+
+  const unsigned char *in;
+  size_t size;
+  size_t pos = 0;
+  uint32_t code = 0;
+  uint32_t range = 0xFFFFFFFFu;
+};
+
+// out(i,j,k) = sum_abc A(i,a) A(j,b) A(k,c) in(a,b,c)
+void applyTensor(int Nq, const double *A, const double *in, double *out, double *tmp)
+{
+  for (int k = 0; k < Nq; k++)
+    for (int j = 0; j < Nq; j++)
+      for (int i = 0; i < Nq; i++) {
+        double s = 0;
+        for (int a = 0; a < Nq; a++)
+          s += A[i * Nq + a] * in[a + j * Nq + k * Nq * Nq];
+        out[i + j * Nq + k * Nq * Nq] = s;
+      }
+
+  for (int k = 0; k < Nq; k++)
+    for (int j = 0; j < Nq; j++)
+      for (int i = 0; i < Nq; i++) {
+        double s = 0;
+        for (int b = 0; b < Nq; b++)
+          s += A[j * Nq + b] * out[i + b * Nq + k * Nq * Nq];
+        tmp[i + j * Nq + k * Nq * Nq] = s;
+      }
+
+  for (int k = 0; k < Nq; k++)
+    for (int j = 0; j < Nq; j++)
+      for (int i = 0; i < Nq; i++) {
+        double s = 0;
+        for (int c = 0; c < Nq; c++)
+          s += A[k * Nq + c] * tmp[i + j * Nq + c * Nq * Nq];
+        out[i + j * Nq + k * Nq * Nq] = s;
+      }
+}
+
+// xor with the previous value along i exposes the shared sign/exponent/leading mantissa bits
+void encodeWords(rangeEncoder_t &rc, const dfloat *u, int Np)
+{
+  std::vector<word_t> w(Np);
+  std::memcpy(w.data(), u, Np * sizeof(word_t));
+  for (int n = Np - 1; n > 0; n--)
+    w[n] ^= w[n - 1];
+
+  for (int plane = sizeof(word_t) - 1; plane >= 0; plane--) {
+    auto probs = byteModel();
+    for (int n = 0; n < Np; n++)
+      rc.encodeByte(probs, static_cast<unsigned char>(w[n] >> (8 * plane)));
+  }
+}
+
+void decodeWords(rangeDecoder_t &rc, dfloat *u, int Np)
+{
+  std::vector<word_t> w(Np, 0);
+  for (int plane = sizeof(word_t) - 1; plane >= 0; plane--) {
+    auto probs = byteModel();
+    for (int n = 0; n < Np; n++)
+      w[n] |= static_cast<word_t>(rc.decodeByte(probs)) << (8 * plane);
+  }
+
+  for (int n = 1; n < Np; n++)
+    w[n] ^= w[n - 1];
+  std::memcpy(u, w.data(), Np * sizeof(word_t));
+}
+
+} // namespace
+
+namespace fld {
+
+compression_t compressionType(const std::string &name)
+{
+  if (name == "LOSSLESS")
+    return compression_t::lossless;
+  if (name == "MODAL")
+    return compression_t::modal;
+  return compression_t::none;
+}
+
+std::string compressionName(compression_t type)
+{
+  if (type == compression_t::lossless)
+    return "LOSSLESS";
+  if (type == compression_t::modal)
+    return "MODAL";
+  return "NONE";
+}
+
+elementCodec_t::elementCodec_t(int N, compression_t type_, double tolerance)
+    : Nq(N + 1), Np((N + 1) * (N + 1) * (N + 1)), type(type_), step(0)
+{
+  if (type != compression_t::modal)
+    return;
+
+  nrsCheck(tolerance <= 0, MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "invalid compression tolerance!");
+
+  std::vector<dfloat> r(Nq);
+  std::vector<dfloat> V_(Nq * Nq);
+  Nodes1D(N, r.data());
+  Vandermonde1D(N, Nq, r.data(), V_.data());
+
+  std::vector<dfloat> invV_(V_);
+  matrixInverse(Nq, invV_.data());
+
+  V.assign(V_.begin(), V_.end());
+  invV.assign(invV_.begin(), invV_.end());
+
+  // |u(x_ijk) - u_q(x_ijk)| <= step/2 * sum_abc |V_ia V_jb V_kc| <= step/2 * (max_i sum_a |V_ia|)^3
+  double maxRowSum = 0;
+  for (int i = 0; i < Nq; i++) {
+    double sum = 0;
+    for (int a = 0; a < Nq; a++)
+      sum += std::abs(V[i * Nq + a]);
+    maxRowSum = std::max(maxRowSum, sum);
+  }
+
+  step = 2 * tolerance / (maxRowSum * maxRowSum * maxRowSum);
+}
+
+void elementCodec_t::encode(const dfloat *u, std::vector<unsigned char> &out) const
+{
+  const size_t sizePos = out.size();
+  out.resize(out.size() + sizeof(uint32_t));
+
+  rangeEncoder_t rc(out);
+
+  if (type == compression_t::modal) {
+    std::vector<double> in(u, u + Np);
+    std::vector<double> c(Np);
+    std::vector<double> wrk(Np);
+    applyTensor(Nq, invV.data(), in.data(), c.data(), wrk.data());
+
+    // llround is undefined for non-finite or out of range values, store such elements losslessly
+    constexpr double qMax = 4611686018427387904.0; // 2^62
+    bool raw = false;
+    for (int n = 0; n < Np; n++)
+      raw |= !(std::abs(c[n] / step) < qMax);
+
+    uint16_t rawProb = probInit;
+    rc.encodeBit(rawProb, raw);
+    if (raw) {
+      encodeWords(rc, u, Np);
+    } else {
+      std::array<byteModel_t, 2> probs = {byteModel(), byteModel()};
+      for (int n = 0; n < Np; n++) {
+        const int64_t q = std::llround(c[n] / step);
+        uint64_t zz = (static_cast<uint64_t>(q) << 1) ^ static_cast<uint64_t>(q >> 63);
+        int ctx = 0;
+        do {
+          unsigned char byte = zz & 0x7F;
+          zz >>= 7;
+          if (zz)
+            byte |= 0x80;
+          rc.encodeByte(probs[ctx], byte);
+          ctx = 1;
+        } while (zz);
+      }
+    }
+  } else {
+    encodeWords(rc, u, Np);
+  }
+
+  rc.flush();
+
+  const uint32_t nbytes = out.size() - sizePos - sizeof(uint32_t);
+  std::memcpy(out.data() + sizePos, &nbytes, sizeof(nbytes));
+}
+
+size_t elementCodec_t::decode(const unsigned char *in, size_t size, dfloat *u) const
+{
+  uint32_t nbytes;
+  nrsCheck(size < sizeof(nbytes), MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "corrupt compressed element!");
+  std::memcpy(&nbytes, in, sizeof(nbytes));
+  nrsCheck(size < sizeof(nbytes) + nbytes, MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "corrupt compressed element!");
+
+  rangeDecoder_t rc(in + sizeof(nbytes), nbytes);
+
+  if (type == compression_t::modal) {
+    uint16_t rawProb = probInit;
+    if (rc.decodeBit(rawProb)) {
+      decodeWords(rc, u, Np);
+      return sizeof(nbytes) + nbytes;
+    }
+
+    std::vector<double> c(Np);
+    std::vector<double> out(Np);
+    std::vector<double> wrk(Np);
+
+    std::array<byteModel_t, 2> probs = {byteModel(), byteModel()};
+    for (int n = 0; n < Np; n++) {
+      uint64_t zz = 0;
+      int shift = 0;
+      int ctx = 0;
+      unsigned char byte;
+      do {
+        byte = rc.decodeByte(probs[ctx]);
+        zz |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+        ctx = 1;
+      } while ((byte & 0x80) && shift < 64);
+      const int64_t q = static_cast<int64_t>(zz >> 1) ^ -static_cast<int64_t>(zz & 1);
+      c[n] = q * step;
+    }
+
+    applyTensor(Nq, V.data(), c.data(), out.data(), wrk.data());
+    for (int n = 0; n < Np; n++)
+      u[n] = out[n];
+  } else {
+    decodeWords(rc, u, Np);
+  }
+
+  return sizeof(nbytes) + nbytes;
+}
+
+} // namespace fld
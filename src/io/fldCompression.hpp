@@ -0,0 +1,39 @@
+#if !defined(nekrs_fldcompression_hpp_)
+#define nekrs_fldcompression_hpp_
+
+#include "nrssys.hpp"
+
+namespace fld
+{
+enum class compression_t { none, lossless, modal };
+
+compression_t compressionType(const std::string &name);
+std::string compressionName(compression_t type);
+
+// per element codec for GLL nodal data
+//   lossless: xor-delta along i + byte-shuffle + adaptive entropy coding of the raw dfloat values
+//   modal:    Legendre transform + quantization bounding the max nodal error by tolerance
+//             followed by entropy coding of the integer coefficients,
+//             elements with non-finite or huge coefficients fall back to lossless
+class elementCodec_t
+{
+public:
+  elementCodec_t(int N, compression_t type, double tolerance);
+
+  // appends encoded element to out
+  void encode(const dfloat *u, std::vector<unsigned char> &out) const;
+
+  // returns number of consumed bytes
+  size_t decode(const unsigned char *in, size_t size, dfloat *u) const;
+
+private:
+  int Nq;
+  int Np;
+  compression_t type;
+  double step;
+  std::vector<double> V;
+  std::vector<double> invV;
+};
+} // namespace fld
+
+#endif
@@ -20,4 +20,17 @@ void writeFld(std::string suffix, dfloat t, int step, int outXYZ, int FP64,
               const occa::memory& o_u, const occa::memory& o_p,  const occa::memory& o_s,
               int NSfields);
 
+namespace fld
+{
+void write(const std::string& prefix, mesh_t *mesh, dlong fieldOffset, double time, int step, dfloat p0th,
+           int outXYZ, int FP64,
+           const occa::memory& o_u, const occa::memory& o_p, const occa::memory& o_s,
+           int NSfields);
+void flush();
+void finalize();
+
+bool isCompressed(const std::string& fileName);
+double restart(nrs_t *nrs, const std::string& restart);
+}
+
 #endif
@@ -0,0 +1,634 @@
+#include <iterator>
+#include <numeric>
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "nekInterfaceAdapter.hpp"
+#include "fldCompression.hpp"
+
+// native parallel reader for standard (.f%05d) and compressed (.fz%05d) field files
+//
+// element ids (and offsets) are read in contiguous chunks and redistributed through a
+// rendezvous keyed by global element id, so no rank has to hold global tables and the
+// partition (and polynomial order) may differ from the one used for writing
+
+namespace {
+
+constexpr int headerBytes = 132;
+constexpr float testPattern = 6.54321f;
+
+struct header_t {
+  bool compressed;
+  int wordSize;
+  int Nq;
+  hlong nelgt;
+  double time;
+  int step;
+  std::string rdcode;
+  double p0th;
+  fld::compression_t compression;
+  double tolerance;
+};
+
+struct record_t {
+  uint64_t id;
+  uint64_t offset;
+  uint64_t size;
+};
+
+void checkMPIIO(int retVal, const char *what)
+{
+  if (retVal == MPI_SUCCESS)
+    return;
+
+  char errString[MPI_MAX_ERROR_STRING];
+  int errStringLen;
+  MPI_Error_string(retVal, errString, &errStringLen);
+  nrsAbort(MPI_COMM_SELF, EXIT_FAILURE, "%s failed: %s\n", what, errString);
+}
+
+header_t parseHeader(const std::string &hdr, const std::string &fileName)
+{
+  std::istringstream is(hdr);
+  std::vector<std::string> tokens{std::istream_iterator<std::string>(is), {}};
+
+  nrsCheck(tokens.empty() || (tokens[0] != "#czf" && tokens[0] != "#std"),
+           platform->comm.mpiComm,
+           EXIT_FAILURE,
+           "%s is not a field file!\n",
+           fileName.c_str());
+
+  header_t h;
+  h.compressed = (tokens[0] == "#czf");
+  nrsCheck(tokens.size() < (h.compressed ? 16 : 13),
+           platform->comm.mpiComm,
+           EXIT_FAILURE,
+           "cannot parse header of %s!\n",
+           fileName.c_str());
+
+  // see mfo_write_hdr
+  nrsCheck(!h.compressed && std::stoi(tokens[10]) != 1,
+           platform->comm.mpiComm,
+           EXIT_FAILURE,
+           "%s\n",
+           "multi-file output (nfileoo > 1) is not supported, use restartEngine = nek!");
+
+  h.wordSize = std::stoi(tokens[1]);
+  h.Nq = std::stoi(tokens[2]);
+  h.nelgt = std::stoll(tokens[5]);
+  h.time = std::stod(tokens[7]);
+  h.step = std::stoi(tokens[8]);
+  h.rdcode = tokens[11];
+  h.p0th = std::stod(tokens[12]);
+  h.compression = h.compressed ? fld::compressionType(tokens[14]) : fld::compression_t::none;
+  h.tolerance = h.compressed ? std::stod(tokens[15]) : 0;
+  return h;
+}
+
+// sends records to the owning ranks, returns received records grouped by source rank
+std::vector<record_t> exchange(const std::vector<std::vector<record_t>> &buckets,
+                               std::vector<int> &recvCounts,
+                               MPI_Comm comm)
+{
+  const int size = buckets.size();
+  std::vector<int> sendCounts(size), sendOffsets(size), recvOffsets(size);
+  recvCounts.resize(size);
+
+  const int recordWords = sizeof(record_t) / sizeof(uint64_t);
+  for (int r = 0; r < size; r++)
+    sendCounts[r] = recordWords * buckets[r].size();
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+
+  std::exclusive_scan(sendCounts.begin(), sendCounts.end(), sendOffsets.begin(), 0);
+  std::exclusive_scan(recvCounts.begin(), recvCounts.end(), recvOffsets.begin(), 0);
+
+  std::vector<record_t> sendBuf;
+  for (const auto &bucket : buckets)
+    sendBuf.insert(sendBuf.end(), bucket.begin(), bucket.end());
+
+  std::vector<record_t> recvBuf((recvOffsets.back() + recvCounts.back()) / recordWords);
+  MPI_Alltoallv(sendBuf.data(),
+                sendCounts.data(),
+                sendOffsets.data(),
+                MPI_UINT64_T,
+                recvBuf.data(),
+                recvCounts.data(),
+                recvOffsets.data(),
+                MPI_UINT64_T,
+                comm);
+
+  for (auto &&count : recvCounts)
+    count /= recordWords;
+
+  return recvBuf;
+}
+
+// components of all fields in record order
+int numComponents(const std::string &rdcode, int dim)
+{
+  int Ncomponents = 0;
+  for (int i = 0; i < rdcode.size(); i++) {
+    if (rdcode[i] == 'X' || rdcode[i] == 'U')
+      Ncomponents += dim;
+    else if (rdcode[i] == 'P' || rdcode[i] == 'T')
+      Ncomponents++;
+    else if (rdcode[i] == 'S') {
+      Ncomponents += std::stoi(rdcode.substr(i + 1, 2));
+      i += 2;
+    }
+  }
+  return Ncomponents;
+}
+
+// all components of the local elements, [e][component][NpFile]
+std::vector<dfloat> readCompressed(MPI_File fh, const header_t &h, const std::vector<hlong> &ids, MPI_Comm comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const dlong Nelements = ids.size();
+  const hlong nelgt = h.nelgt;
+
+  // id and offset tables of a contiguous chunk
+  const hlong chunkN = nelgt / size + (rank < nelgt % size);
+  const hlong chunkB = rank * (nelgt / size) + std::min<hlong>(rank, nelgt % size);
+
+  std::vector<int> chunkIds(chunkN);
+  std::vector<uint64_t> chunkOffsets(chunkN + 1);
+
+  MPI_Offset offset = headerBytes + sizeof(float);
+  checkMPIIO(MPI_File_read_at_all(fh,
+                                  offset + chunkB * sizeof(int),
+                                  chunkIds.data(),
+                                  chunkN,
+                                  MPI_INT,
+                                  MPI_STATUS_IGNORE),
+             "MPI_File_read_at_all");
+  offset += nelgt * sizeof(int);
+
+  checkMPIIO(MPI_File_read_at_all(fh,
+                                  offset + chunkB * sizeof(uint64_t),
+                                  chunkOffsets.data(),
+                                  chunkN + 1,
+                                  MPI_UINT64_T,
+                                  MPI_STATUS_IGNORE),
+             "MPI_File_read_at_all");
+  offset += (nelgt + 1) * sizeof(uint64_t);
+  const MPI_Offset payloadStart = offset;
+
+  auto owner = [size](uint64_t id) { return static_cast<int>((id - 1) % size); };
+
+  // deposit (id, offset, size) at the rendezvous rank of each id
+  std::vector<record_t> directory;
+  {
+    std::vector<std::vector<record_t>> buckets(size);
+    for (hlong i = 0; i < chunkN; i++) {
+      const uint64_t id = chunkIds[i];
+      buckets[owner(id)].push_back({id, chunkOffsets[i], chunkOffsets[i + 1] - chunkOffsets[i]});
+    }
+    std::vector<int> counts;
+    directory = exchange(buckets, counts, comm);
+  }
+  std::unordered_map<uint64_t, record_t> directoryMap;
+  for (const auto &r : directory)
+    directoryMap[r.id] = r;
+
+  // look up local elements
+  std::vector<record_t> localRecords(Nelements);
+  {
+    std::vector<std::vector<record_t>> requests(size);
+    for (dlong e = 0; e < Nelements; e++) {
+      const uint64_t id = ids[e];
+      requests[owner(id)].push_back({id, 0, 0});
+    }
+    std::vector<int> counts;
+    auto received = exchange(requests, counts, comm);
+
+    std::vector<std::vector<record_t>> replies(size);
+    int i = 0;
+    for (int r = 0; r < size; r++) {
+      for (int n = 0; n < counts[r]; n++, i++) {
+        const auto entry = directoryMap.find(received[i].id);
+        nrsCheck(entry == directoryMap.end(),
+                 MPI_COMM_SELF,
+                 EXIT_FAILURE,
+                 "element %llu not found in restart file!\n",
+                 static_cast<unsigned long long>(received[i].id));
+        replies[r].push_back(entry->second);
+      }
+    }
+    auto answers = exchange(replies, counts, comm);
+
+    std::unordered_map<uint64_t, record_t> answerMap;
+    for (const auto &r : answers)
+      answerMap[r.id] = r;
+    for (dlong e = 0; e < Nelements; e++)
+      localRecords[e] = answerMap.at(ids[e]);
+  }
+
+  // collective read through a file view sorted by offset
+  std::vector<dlong> order(Nelements);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](dlong a, dlong b) {
+    return localRecords[a].offset < localRecords[b].offset;
+  });
+
+  std::vector<int> blockLengths(Nelements);
+  std::vector<MPI_Aint> displacements(Nelements);
+  std::vector<size_t> bufferOffset(Nelements);
+  size_t Nbytes = 0;
+  for (dlong i = 0; i < Nelements; i++) {
+    const auto &r = localRecords[order[i]];
+    blockLengths[i] = r.size;
+    displacements[i] = r.offset;
+    bufferOffset[order[i]] = Nbytes;
+    Nbytes += r.size;
+  }
+
+  nrsCheck(Nbytes > std::numeric_limits<int>::max(),
+           MPI_COMM_SELF,
+           EXIT_FAILURE,
+           "%s\n",
+           "compressed rank payload exceeds 2GB!");
+
+  MPI_Datatype fileType;
+  MPI_Type_create_hindexed(Nelements, blockLengths.data(), displacements.data(), MPI_BYTE, &fileType);
+  MPI_Type_commit(&fileType);
+
+  std::vector<unsigned char> payload(Nbytes);
+  checkMPIIO(MPI_File_set_view(fh, payloadStart, MPI_BYTE, fileType, "native", MPI_INFO_NULL),
+             "MPI_File_set_view");
+  checkMPIIO(MPI_File_read_all(fh, payload.data(), Nbytes, MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_all");
+  MPI_Type_free(&fileType);
+
+  const int Ncomponents = numComponents(h.rdcode, 3);
+  const int Np = h.Nq * h.Nq * h.Nq;
+  const fld::elementCodec_t codec(h.Nq - 1, h.compression, h.tolerance);
+
+  std::vector<dfloat> data(static_cast<size_t>(Nelements) * Ncomponents * Np);
+  for (dlong e = 0; e < Nelements; e++) {
+    const unsigned char *in = payload.data() + bufferOffset[e];
+    size_t remaining = localRecords[e].size;
+    for (int c = 0; c < Ncomponents; c++) {
+      const size_t consumed = codec.decode(in, remaining, data.data() + (e * Ncomponents + c) * Np);
+      in += consumed;
+      remaining -= consumed;
+    }
+  }
+
+  return data;
+}
+
+// all components of the local elements, [e][component][NpFile]
+std::vector<dfloat> readStandard(MPI_File fh, const header_t &h, const std::vector<hlong> &ids, MPI_Comm comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const dlong Nelements = ids.size();
+  const hlong nelgt = h.nelgt;
+  const int Np = h.Nq * h.Nq * h.Nq;
+
+  // contiguous chunk of element positions, read from every section
+  const hlong chunkN = nelgt / size + (rank < nelgt % size);
+  const hlong chunkB = rank * (nelgt / size) + std::min<hlong>(rank, nelgt % size);
+
+  std::vector<int> chunkIds(chunkN);
+  MPI_Offset offset = headerBytes + sizeof(float);
+  checkMPIIO(MPI_File_read_at_all(fh,
+                                  offset + chunkB * sizeof(int),
+                                  chunkIds.data(),
+                                  chunkN,
+                                  MPI_INT,
+                                  MPI_STATUS_IGNORE),
+             "MPI_File_read_at_all");
+  offset += nelgt * sizeof(int);
+
+  std::vector<int> sections;
+  for (int i = 0; i < h.rdcode.size(); i++) {
+    if (h.rdcode[i] == 'X' || h.rdcode[i] == 'U')
+      sections.push_back(3);
+    else if (h.rdcode[i] == 'P' || h.rdcode[i] == 'T')
+      sections.push_back(1);
+    else if (h.rdcode[i] == 'S') {
+      for (int is = 0; is < std::stoi(h.rdcode.substr(i + 1, 2)); is++)
+        sections.push_back(1);
+      i += 2;
+    }
+  }
+  const int Ncomponents = std::accumulate(sections.begin(), sections.end(), 0);
+  const size_t recordWords = static_cast<size_t>(Ncomponents) * Np;
+
+  // chunk records, [position][component][Np]
+  std::vector<dfloat> chunk(chunkN * recordWords);
+  {
+    std::vector<char> buf(chunkN * 3 * Np * h.wordSize);
+    int component = 0;
+    for (const auto &Nc : sections) {
+      const size_t sectionWords = Nc * Np;
+      checkMPIIO(MPI_File_read_at_all(fh,
+                                      offset + chunkB * sectionWords * h.wordSize,
+                                      buf.data(),
+                                      chunkN * sectionWords,
+                                      (h.wordSize == sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
+                                      MPI_STATUS_IGNORE),
+                 "MPI_File_read_at_all");
+      offset += nelgt * sectionWords * h.wordSize;
+
+      for (hlong p = 0; p < chunkN; p++) {
+        dfloat *dst = chunk.data() + p * recordWords + component * Np;
+        for (size_t n = 0; n < sectionWords; n++) {
+          dst[n] = (h.wordSize == sizeof(double)) ? reinterpret_cast<const double *>(buf.data())[p * sectionWords + n]
+                                                  : reinterpret_cast<const float *>(buf.data())[p * sectionWords + n];
+        }
+      }
+      component += Nc;
+    }
+  }
+
+  auto owner = [size](uint64_t id) { return static_cast<int>((id - 1) % size); };
+
+  // rendezvous of requests (id, rank, e) and chunk entries (id, rank, position)
+  std::vector<std::vector<record_t>> buckets(size);
+  for (dlong e = 0; e < Nelements; e++)
+    buckets[owner(ids[e])].push_back({static_cast<uint64_t>(ids[e]), static_cast<uint64_t>(rank), static_cast<uint64_t>(e)});
+  std::vector<int> counts;
+  const auto requests = exchange(buckets, counts, comm);
+
+  std::unordered_map<uint64_t, record_t> requestMap;
+  for (const auto &r : requests)
+    requestMap[r.id] = r;
+
+  for (auto &&bucket : buckets)
+    bucket.clear();
+  for (hlong p = 0; p < chunkN; p++)
+    buckets[owner(chunkIds[p])].push_back({static_cast<uint64_t>(chunkIds[p]), static_cast<uint64_t>(rank), static_cast<uint64_t>(p)});
+  const auto entries = exchange(buckets, counts, comm);
+
+  // tell the reading ranks where their positions go: (position, requesting rank, e)
+  for (auto &&bucket : buckets)
+    bucket.clear();
+  for (const auto &entry : entries) {
+    const auto request = requestMap.find(entry.id);
+    if (request == requestMap.end())
+      continue;
+    buckets[entry.offset].push_back({entry.size, request->second.offset, request->second.size});
+  }
+  const auto routes = exchange(buckets, counts, comm);
+
+  // ship records directly from the reading to the requesting rank
+  for (auto &&bucket : buckets)
+    bucket.clear();
+  for (const auto &route : routes)
+    buckets[route.offset].push_back(route);
+
+  std::vector<int> sendCounts(size), sendOffsets(size), recvCounts(size), recvOffsets(size);
+  std::vector<dfloat> sendBuf;
+  sendBuf.reserve(routes.size() * recordWords);
+  for (int r = 0; r < size; r++) {
+    for (const auto &route : buckets[r])
+      sendBuf.insert(sendBuf.end(), chunk.begin() + route.id * recordWords, chunk.begin() + (route.id + 1) * recordWords);
+    sendCounts[r] = buckets[r].size() * recordWords;
+  }
+  const auto targets = exchange(buckets, counts, comm);
+
+  for (int r = 0; r < size; r++)
+    recvCounts[r] = counts[r] * recordWords;
+  std::exclusive_scan(sendCounts.begin(), sendCounts.end(), sendOffsets.begin(), 0);
+  std::exclusive_scan(recvCounts.begin(), recvCounts.end(), recvOffsets.begin(), 0);
+
+  std::vector<dfloat> recvBuf(recvOffsets.back() + recvCounts.back());
+  MPI_Alltoallv(sendBuf.data(),
+                sendCounts.data(),
+                sendOffsets.data(),
+                MPI_DFLOAT,
+                recvBuf.data(),
+                recvCounts.data(),
+                recvOffsets.data(),
+                MPI_DFLOAT,
+                comm);
+
+  std::vector<dfloat> data(static_cast<size_t>(Nelements) * recordWords);
+  dlong found = 0;
+  for (size_t i = 0; i < targets.size(); i++) {
+    const auto e = targets[i].size;
+    std::copy(recvBuf.begin() + i * recordWords, recvBuf.begin() + (i + 1) * recordWords, data.begin() + e * recordWords);
+    found++;
+  }
+  nrsCheck(found != Nelements, MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "elements missing in restart file!");
+
+  return data;
+}
+
+} // namespace
+
+namespace fld {
+
+bool isCompressed(const std::string &fileName)
+{
+  int compressed = 0;
+  if (platform->comm.mpiRank == 0) {
+    std::ifstream f(fileName, std::ios::binary);
+    char magic[4] = {};
+    if (f.read(magic, sizeof(magic)))
+      compressed = (std::string(magic, sizeof(magic)) == "#czf");
+  }
+  MPI_Bcast(&compressed, 1, MPI_INT, 0, platform->comm.mpiComm);
+  return compressed;
+}
+
+// restart = <fileName>[+U][+P][+T][+time=<float>]
+double restart(nrs_t *nrs, const std::string &restart)
+{
+  MPI_Comm comm = platform->comm.mpiComm;
+  const int rank = platform->comm.mpiRank;
+
+  const double tStart = MPI_Wtime();
+
+  const auto entries = serializeString(restart, '+');
+  const std::string fileName = entries.at(0);
+
+  bool readU = true, readP = true, readT = true;
+  double timeOverride = -1;
+  bool haveTimeOverride = false;
+  {
+    std::vector<std::string> fields;
+    for (int i = 1; i < entries.size(); i++) {
+      auto entry = entries[i];
+      upperCase(entry);
+      if (entry.rfind("TIME=", 0) == 0) {
+        timeOverride = std::stod(entry.substr(5));
+        haveTimeOverride = true;
+      } else {
+        fields.push_back(entry);
+      }
+    }
+    if (fields.size()) {
+      auto requested = [&](const std::string &name) {
+        return std::find(fields.begin(), fields.end(), name) != fields.end();
+      };
+      readU = requested("U");
+      readP = requested("P");
+      readT = requested("T");
+    }
+  }
+
+  if (rank == 0) {
+    printf("reading restart file %s\n", fileName.c_str());
+    fflush(stdout);
+  }
+
+  mesh_t *mesh = nrs->_mesh;
+
+  MPI_File fh;
+  checkMPIIO(MPI_File_open(comm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh), "MPI_File_open");
+
+  std::string hdr(headerBytes, ' ');
+  float pattern = 0;
+  if (rank == 0) {
+    checkMPIIO(MPI_File_read_at(fh, 0, &hdr[0], headerBytes, MPI_CHAR, MPI_STATUS_IGNORE), "MPI_File_read_at");
+    checkMPIIO(MPI_File_read_at(fh, headerBytes, &pattern, 1, MPI_FLOAT, MPI_STATUS_IGNORE),
+               "MPI_File_read_at");
+  }
+  MPI_Bcast(&hdr[0], headerBytes, MPI_CHAR, 0, comm);
+  MPI_Bcast(&pattern, 1, MPI_FLOAT, 0, comm);
+
+  const auto h = parseHeader(hdr, fileName);
+
+  hlong nelgt = mesh->Nelements;
+  MPI_Allreduce(MPI_IN_PLACE, &nelgt, 1, MPI_HLONG, MPI_SUM, comm);
+
+  nrsCheck(std::abs(pattern - testPattern) > 1e-5, comm, EXIT_FAILURE, "%s\n", "unsupported byte order!");
+  nrsCheck(h.compressed && h.wordSize != sizeof(dfloat), comm, EXIT_FAILURE, "%s\n", "word size does not match dfloat!");
+  nrsCheck(h.wordSize != sizeof(float) && h.wordSize != sizeof(double),
+           comm,
+           EXIT_FAILURE,
+           "invalid word size %d!\n",
+           h.wordSize);
+  nrsCheck(h.nelgt != nelgt,
+           comm,
+           EXIT_FAILURE,
+           "number of elements of restart file (%lld) does not match!\n",
+           static_cast<long long>(h.nelgt));
+
+  std::vector<hlong> ids(mesh->Nelements);
+  for (dlong e = 0; e < mesh->Nelements; e++)
+    ids[e] = nek::lglel(e) + 1;
+
+  const auto data = h.compressed ? readCompressed(fh, h, ids, comm) : readStandard(fh, h, ids, comm);
+  checkMPIIO(MPI_File_close(&fh), "MPI_File_close");
+
+  // targets in record order, nullptr entries are skipped
+  struct target_t {
+    dfloat *ptr;
+    dlong Nelements;
+  };
+  std::vector<target_t> targets;
+
+  const auto &rdcode = h.rdcode;
+  int NSfields = 0;
+  for (int i = 0; i < rdcode.size(); i++) {
+    if (rdcode[i] == 'X') {
+      const bool movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
+      targets.push_back({movingMesh ? mesh->x : nullptr, mesh->Nelements});
+      targets.push_back({movingMesh ? mesh->y : nullptr, mesh->Nelements});
+      targets.push_back({movingMesh ? mesh->z : nullptr, mesh->Nelements});
+    } else if (rdcode[i] == 'U') {
+      for (int d = 0; d < mesh->dim; d++)
+        targets.push_back({readU ? nrs->U + d * nrs->fieldOffset : nullptr, nrs->meshV->Nelements});
+    } else if (rdcode[i] == 'P') {
+      targets.push_back({readP ? nrs->P : nullptr, nrs->meshV->Nelements});
+    } else if (rdcode[i] == 'T') {
+      NSfields = 1;
+    } else if (rdcode[i] == 'S') {
+      NSfields += std::stoi(rdcode.substr(i + 1, 2));
+      i += 2;
+    }
+  }
+  for (int is = 0; is < NSfields; is++) {
+    const bool available = readT && nrs->Nscalar > is;
+    if (available) {
+      mesh_t *meshS = (is) ? nrs->cds->meshV : nrs->cds->mesh[0];
+      targets.push_back({nrs->cds->S + nrs->cds->fieldOffsetScan[is], meshS->Nelements});
+    } else {
+      targets.push_back({nullptr, 0});
+    }
+  }
+
+  // all fields in one pass, interpolated on device if the polynomial order changed
+  const int NpFile = h.Nq * h.Nq * h.Nq;
+  const int Ncomponents = targets.size();
+  const bool interpolate = (h.Nq != mesh->Nq);
+
+  occa::kernel interpolateKernel;
+  occa::memory o_I, o_in, o_out;
+  if (interpolate) {
+    if (rank == 0) {
+      printf("interpolating restart data from N=%d to N=%d\n", h.Nq - 1, mesh->N);
+      fflush(stdout);
+    }
+
+    std::vector<dfloat> r(h.Nq);
+    std::vector<dfloat> I(mesh->Nq * h.Nq);
+    Nodes1D(h.Nq - 1, r.data());
+    InterpolationMatrix1D(h.Nq - 1, h.Nq, r.data(), mesh->Nq, mesh->r, I.data());
+
+    occa::properties props = platform->kernelInfo;
+    props["defines/p_NqIn"] = h.Nq;
+    props["defines/p_NqOut"] = mesh->Nq;
+    props["defines/p_NpIn"] = NpFile;
+    props["defines/p_NpOut"] = mesh->Np;
+    props["defines/p_blockSize"] = std::min(1024, std::max(h.Nq, mesh->Nq) * std::max(h.Nq, mesh->Nq));
+
+    const std::string oklpath(getenv("NEKRS_KERNEL_DIR"));
+    interpolateKernel = platform->device.buildKernel(oklpath + "/mesh/interpolateHex3D.okl", props, true);
+
+    o_I = platform->device.malloc<dfloat>(I.size(), I.data());
+    o_in = platform->device.malloc<dfloat>(std::max<dlong>(1, mesh->Nelements * NpFile));
+    o_out = platform->device.malloc<dfloat>(std::max<dlong>(1, mesh->Nelements * mesh->Np));
+  }
+
+  std::vector<dfloat> component(mesh->Nelements * NpFile);
+  for (int c = 0; c < Ncomponents; c++) {
+    const auto &target = targets[c];
+    if (!target.ptr)
+      continue;
+
+    for (dlong e = 0; e < target.Nelements; e++) {
+      const auto src = data.begin() + (static_cast<size_t>(e) * Ncomponents + c) * NpFile;
+      std::copy(src, src + NpFile, component.begin() + e * NpFile);
+    }
+
+    if (!interpolate) {
+      std::copy(component.begin(), component.begin() + target.Nelements * NpFile, target.ptr);
+      continue;
+    }
+
+    if (target.Nelements) {
+      o_in.copyFrom(component.data(), target.Nelements * NpFile * sizeof(dfloat));
+      interpolateKernel(target.Nelements, o_I, o_in, o_out);
+      o_out.copyTo(target.ptr, target.Nelements * mesh->Np * sizeof(dfloat));
+    }
+  }
+
+  if (interpolate) {
+    o_I.free();
+    o_in.free();
+    o_out.free();
+  }
+
+  nrs->p0th[0] = h.p0th;
+
+  if (rank == 0) {
+    printf("done :: read %s (%s) in %.4gs\n",
+           fileName.c_str(),
+           h.compressed ? compressionName(h.compression).c_str() : ("FP" + std::to_string(8 * h.wordSize)).c_str(),
+           MPI_Wtime() - tStart);
+    fflush(stdout);
+  }
+
+  return haveTimeOverride ? timeOverride : h.time;
+}
+
+} // namespace fld
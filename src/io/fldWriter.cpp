@@ -0,0 +1,663 @@
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <numeric>
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "nekInterfaceAdapter.hpp"
+#include "fldCompression.hpp"
+
+// native writer for the Nek5000 multi-file field format (.f%05d) using collective MPI-IO
+// file layout: header | test pattern | global element ids | field data | per element min/max (float)
+//
+// compressed variant (.fz%05d)
+// file layout: header (#czf) | test pattern | global element ids | element offsets (uint64, nelgt+1) |
+//              per element records of all components (see fldCompression.hpp)
+//
+// a write is split into a snapshot (device -> pinned host arena) and the actual file write
+// (conversion + MPI-IO) which runs either inline or on a background I/O thread
+
+namespace {
+
+constexpr int headerBytes = 132;
+constexpr float testPattern = 6.54321f;
+
+std::map<std::string, int> fileCounter;
+
+struct arena_t {
+  occa::memory h_data;
+  occa::memory h_out;
+};
+
+struct job_t {
+  std::string fname;
+  std::string prefix;
+  std::string casename;
+  std::string header;
+  int counter;
+  int step;
+  double time;
+  int FP64;
+  fld::compression_t compression;
+  double tolerance;
+  int Nq;
+  int Np;
+  dlong Nelements;
+  hlong nelgt;
+  hlong nelB;
+  std::vector<int> glel;
+  std::vector<int> Ncomponents;
+  arena_t *arena;
+};
+
+// async state
+std::thread ioThread;
+std::mutex ioMutex;
+std::condition_variable ioCv;
+std::deque<std::unique_ptr<job_t>> ioQueue;
+std::vector<std::unique_ptr<arena_t>> arenas;
+std::vector<arena_t *> freeArenas;
+int pendingJobs = 0;
+bool shutdownRequested = false;
+MPI_Comm ioComm = MPI_COMM_NULL;
+
+void reallocArena(arena_t &arena, size_t NbytesData, size_t NbytesOut)
+{
+  if (arena.h_data.size() < NbytesData) {
+    if (arena.h_data.size())
+      arena.h_data.free();
+    arena.h_data = platform->device.mallocHost(NbytesData);
+  }
+  if (arena.h_out.size() < NbytesOut) {
+    if (arena.h_out.size())
+      arena.h_out.free();
+    arena.h_out = platform->device.mallocHost(NbytesOut);
+  }
+}
+
+// Fortran Ew.d edit descriptor (0.ddddE+xx)
+std::string fortranExp(double val, int width, int digits)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*E", digits - 1, val);
+
+  std::string s(buf);
+  const bool negative = (s[0] == '-');
+  const auto ePos = s.find('E');
+  std::string mantissa = s.substr(negative, ePos - negative);
+  mantissa.erase(1, 1);
+
+  int exponent = std::stoi(s.substr(ePos + 1));
+  if (val != 0.0)
+    exponent++;
+
+  snprintf(buf, sizeof(buf), "E%c%02d", (exponent < 0) ? '-' : '+', std::abs(exponent));
+  std::string out = std::string(negative ? "-" : "") + "0." + mantissa + buf;
+  if (out.size() < width)
+    out.insert(0, width - out.size(), ' ');
+  return out;
+}
+
+std::string header(int wordSize,
+                   int Nq,
+                   hlong nelgt,
+                   double time,
+                   int step,
+                   const std::string &rdcode,
+                   double p0th)
+{
+  // see mfo_write_hdr
+  std::ostringstream hdr;
+  hdr << "#std " << std::setw(1) << wordSize << " " << std::setw(2) << Nq << " " << std::setw(2) << Nq
+      << " " << std::setw(2) << Nq << " " << std::setw(10) << nelgt << " " << std::setw(10) << nelgt << " "
+      << fortranExp(time, 20, 13) << " " << std::setw(9) << step << " " << std::setw(6) << 0 << " "
+      << std::setw(6) << 1 << " " << std::left << std::setw(10) << rdcode;
+
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%15.7E F", p0th);
+  hdr << buf;
+
+  std::string out = hdr.str();
+  out.resize(headerBytes, ' ');
+  return out;
+}
+
+std::string compressedHeader(int Nq,
+                             hlong nelgt,
+                             double time,
+                             int step,
+                             const std::string &rdcode,
+                             double p0th,
+                             fld::compression_t compression,
+                             double tolerance)
+{
+  std::string out = header(sizeof(dfloat), Nq, nelgt, time, step, rdcode, p0th);
+  out.resize(out.find_last_not_of(' ') + 1);
+  out.replace(0, 4, "#czf");
+
+  char buf[64];
+  snprintf(buf, sizeof(buf), " %s %.3E", fld::compressionName(compression).c_str(), tolerance);
+  out += buf;
+
+  nrsCheck(out.size() > headerBytes, MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "compressed header too long!");
+  out.resize(headerBytes, ' ');
+  return out;
+}
+
+std::string fileName(const std::string &prefix, const std::string &casename, int counter, bool compressed)
+{
+  std::ostringstream name;
+  name << prefix << casename << (compressed ? "0.fz" : "0.f") << std::setw(5) << std::setfill('0') << counter;
+  return name.str();
+}
+
+void writeMetaFile(const std::string &prefix, const std::string &casename, int counter)
+{
+  std::ofstream f(prefix + casename + ".nek5000", std::ios::trunc);
+  f << "filetemplate: " << prefix << casename << "%01d.f%05d" << std::endl;
+  f << "firsttimestep: 1" << std::endl;
+  f << "numtimesteps: " << counter << std::endl;
+  f.close();
+}
+
+template <typename T>
+void pack(int Nfields, dlong Nelements, int Np, const dfloat *in, void *out, float *bounds)
+{
+  // element-wise interleave of all components
+  auto *o = static_cast<T *>(out);
+  const dlong Nlocal = Nelements * Np;
+  for (dlong e = 0; e < Nelements; e++) {
+    for (int fld = 0; fld < Nfields; fld++) {
+      const dfloat *src = in + fld * Nlocal + e * Np;
+      T *dst = o + (e * Nfields + fld) * Np;
+      dfloat minVal = src[0];
+      dfloat maxVal = src[0];
+      for (int n = 0; n < Np; n++) {
+        dst[n] = static_cast<T>(src[n]);
+        minVal = std::min(minVal, src[n]);
+        maxVal = std::max(maxVal, src[n]);
+      }
+      bounds[2 * (e * Nfields + fld) + 0] = static_cast<float>(minVal);
+      bounds[2 * (e * Nfields + fld) + 1] = static_cast<float>(maxVal);
+    }
+  }
+}
+
+void checkMPIIO(int retVal, const char *what)
+{
+  if (retVal == MPI_SUCCESS)
+    return;
+
+  char errString[MPI_MAX_ERROR_STRING];
+  int errStringLen;
+  MPI_Error_string(retVal, errString, &errStringLen);
+  nrsAbort(MPI_COMM_SELF, EXIT_FAILURE, "%s failed: %s\n", what, errString);
+}
+
+// collective on comm, touches only the job and its arena
+double writeJob(const job_t &job, MPI_Comm comm)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  const double tStart = MPI_Wtime();
+
+  const int Np = job.Np;
+  const dlong Nelements = job.Nelements;
+  const dlong Nlocal = Nelements * Np;
+  const int wordSize = job.FP64 ? sizeof(double) : sizeof(float);
+
+  MPI_File fh;
+  if (rank == 0)
+    MPI_File_delete(job.fname.c_str(), MPI_INFO_NULL);
+  MPI_Barrier(comm);
+  checkMPIIO(MPI_File_open(comm, job.fname.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh),
+             "MPI_File_open");
+
+  if (rank == 0) {
+    checkMPIIO(MPI_File_write_at(fh, 0, job.header.c_str(), headerBytes, MPI_CHAR, MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+    checkMPIIO(MPI_File_write_at(fh, headerBytes, &testPattern, 1, MPI_FLOAT, MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+  }
+
+  MPI_Offset offset = headerBytes + sizeof(float);
+  checkMPIIO(MPI_File_write_at_all(fh,
+                                   offset + job.nelB * sizeof(int),
+                                   job.glel.data(),
+                                   Nelements,
+                                   MPI_INT,
+                                   MPI_STATUS_IGNORE),
+             "MPI_File_write_at_all");
+  offset += job.nelgt * sizeof(int);
+
+  auto data = static_cast<dfloat *>(job.arena->h_data.ptr());
+  auto out = job.arena->h_out.ptr();
+
+  std::vector<std::vector<float>> bounds;
+  for (const auto &Ncomponents : job.Ncomponents) {
+    bounds.push_back(std::vector<float>(2 * Ncomponents * Nelements));
+    if (job.FP64)
+      pack<double>(Ncomponents, Nelements, Np, data, out, bounds.back().data());
+    else
+      pack<float>(Ncomponents, Nelements, Np, data, out, bounds.back().data());
+
+    checkMPIIO(MPI_File_write_at_all(fh,
+                                     offset + job.nelB * Ncomponents * Np * wordSize,
+                                     out,
+                                     Ncomponents * Nlocal,
+                                     job.FP64 ? MPI_DOUBLE : MPI_FLOAT,
+                                     MPI_STATUS_IGNORE),
+               "MPI_File_write_at_all");
+    offset += job.nelgt * Ncomponents * Np * wordSize;
+    data += Ncomponents * Nlocal;
+  }
+
+  for (int fld = 0; fld < job.Ncomponents.size(); fld++) {
+    const auto Ncomponents = job.Ncomponents[fld];
+    checkMPIIO(MPI_File_write_at_all(fh,
+                                     offset + job.nelB * 2 * Ncomponents * sizeof(float),
+                                     bounds[fld].data(),
+                                     bounds[fld].size(),
+                                     MPI_FLOAT,
+                                     MPI_STATUS_IGNORE),
+               "MPI_File_write_at_all");
+    offset += job.nelgt * 2 * Ncomponents * sizeof(float);
+  }
+
+  checkMPIIO(MPI_File_close(&fh), "MPI_File_close");
+
+  if (rank == 0)
+    writeMetaFile(job.prefix, job.casename, job.counter);
+
+  MPI_Barrier(comm);
+  const double elapsed = std::max(MPI_Wtime() - tStart, 1e-10);
+
+  if (rank == 0) {
+    printf("%9d %11.4E done :: Write checkpoint %s\n", job.step, job.time, job.fname.c_str());
+    printf("                              file size = %.4g GB\n", offset / 1e9);
+    printf("                              avg data-throughput = %.1f GB/s\n", offset / 1e9 / elapsed);
+    fflush(stdout);
+  }
+
+  return elapsed;
+}
+
+// collective on comm, encoding runs on the calling thread
+double writeCompressedJob(const job_t &job, MPI_Comm comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const double tStart = MPI_Wtime();
+
+  const int Np = job.Np;
+  const dlong Nelements = job.Nelements;
+  const dlong Nlocal = Nelements * Np;
+  const int Ncomponents = std::accumulate(job.Ncomponents.begin(), job.Ncomponents.end(), 0);
+
+  const fld::elementCodec_t codec(job.Nq - 1, job.compression, job.tolerance);
+
+  auto data = static_cast<const dfloat *>(job.arena->h_data.ptr());
+  std::vector<unsigned char> payload;
+  payload.reserve(Ncomponents * Nlocal * sizeof(dfloat) / 2);
+
+  std::vector<uint64_t> elementOffset(Nelements);
+  for (dlong e = 0; e < Nelements; e++) {
+    elementOffset[e] = payload.size();
+    for (int fld = 0; fld < Ncomponents; fld++)
+      codec.encode(data + fld * Nlocal + e * Np, payload);
+  }
+  const double tEncode = MPI_Wtime() - tStart;
+
+  uint64_t payloadSize = payload.size();
+  uint64_t payloadB = 0;
+  MPI_Exscan(&payloadSize, &payloadB, 1, MPI_UINT64_T, MPI_SUM, comm);
+  if (rank == 0)
+    payloadB = 0;
+  MPI_Allreduce(MPI_IN_PLACE, &payloadSize, 1, MPI_UINT64_T, MPI_SUM, comm);
+
+  for (auto &&offset : elementOffset)
+    offset += payloadB;
+
+  nrsCheck(payload.size() > std::numeric_limits<int>::max(),
+           MPI_COMM_SELF,
+           EXIT_FAILURE,
+           "%s\n",
+           "compressed rank payload exceeds 2GB!");
+
+  MPI_File fh;
+  if (rank == 0)
+    MPI_File_delete(job.fname.c_str(), MPI_INFO_NULL);
+  MPI_Barrier(comm);
+  checkMPIIO(MPI_File_open(comm, job.fname.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh),
+             "MPI_File_open");
+
+  if (rank == 0) {
+    checkMPIIO(MPI_File_write_at(fh, 0, job.header.c_str(), headerBytes, MPI_CHAR, MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+    checkMPIIO(MPI_File_write_at(fh, headerBytes, &testPattern, 1, MPI_FLOAT, MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+  }
+
+  MPI_Offset offset = headerBytes + sizeof(float);
+  checkMPIIO(MPI_File_write_at_all(fh,
+                                   offset + job.nelB * sizeof(int),
+                                   job.glel.data(),
+                                   Nelements,
+                                   MPI_INT,
+                                   MPI_STATUS_IGNORE),
+             "MPI_File_write_at_all");
+  offset += job.nelgt * sizeof(int);
+
+  checkMPIIO(MPI_File_write_at_all(fh,
+                                   offset + job.nelB * sizeof(uint64_t),
+                                   elementOffset.data(),
+                                   Nelements,
+                                   MPI_UINT64_T,
+                                   MPI_STATUS_IGNORE),
+             "MPI_File_write_at_all");
+  if (rank == size - 1) {
+    checkMPIIO(MPI_File_write_at(fh,
+                                 offset + job.nelgt * sizeof(uint64_t),
+                                 &payloadSize,
+                                 1,
+                                 MPI_UINT64_T,
+                                 MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+  }
+  offset += (job.nelgt + 1) * sizeof(uint64_t);
+
+  checkMPIIO(MPI_File_write_at_all(fh,
+                                   offset + payloadB,
+                                   payload.data(),
+                                   payload.size(),
+                                   MPI_BYTE,
+                                   MPI_STATUS_IGNORE),
+             "MPI_File_write_at_all");
+  offset += payloadSize;
+
+  checkMPIIO(MPI_File_close(&fh), "MPI_File_close");
+
+  MPI_Barrier(comm);
+  const double elapsed = std::max(MPI_Wtime() - tStart, 1e-10);
+
+  double tEncodeMax = tEncode;
+  MPI_Reduce(&tEncode, &tEncodeMax, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+
+  if (rank == 0) {
+    const double rawBytes = static_cast<double>(job.nelgt) * Ncomponents * Np * sizeof(dfloat);
+    printf("%9d %11.4E done :: Write checkpoint %s\n", job.step, job.time, job.fname.c_str());
+    printf("                              file size = %.4g GB\n", offset / 1e9);
+    printf("                              compression ratio = %.2f (%s)\n",
+           rawBytes / std::max(payloadSize, uint64_t(1)),
+           fld::compressionName(job.compression).c_str());
+    printf("                              encoding time = %.4gs\n", tEncodeMax);
+    printf("                              avg data-throughput = %.1f GB/s\n", offset / 1e9 / elapsed);
+    fflush(stdout);
+  }
+
+  return elapsed;
+}
+
+double runJob(const job_t &job, MPI_Comm comm)
+{
+  if (job.compression != fld::compression_t::none)
+    return writeCompressedJob(job, comm);
+  return writeJob(job, comm);
+}
+
+void ioLoop()
+{
+  while (true) {
+    std::unique_ptr<job_t> job;
+    {
+      std::unique_lock<std::mutex> lock(ioMutex);
+      ioCv.wait(lock, [] { return !ioQueue.empty() || shutdownRequested; });
+      if (ioQueue.empty())
+        return;
+      job = std::move(ioQueue.front());
+      ioQueue.pop_front();
+    }
+
+    runJob(*job, ioComm);
+
+    {
+      std::lock_guard<std::mutex> lock(ioMutex);
+      freeArenas.push_back(job->arena);
+      pendingJobs--;
+    }
+    ioCv.notify_all();
+  }
+}
+
+bool asyncEnabled()
+{
+  static int enabled = -1;
+  if (enabled < 0) {
+    enabled = platform->options.compareArgs("CHECKPOINT ASYNC", "TRUE");
+    if (enabled) {
+      int provided;
+      MPI_Query_thread(&provided);
+      if (provided < MPI_THREAD_MULTIPLE) {
+        if (platform->comm.mpiRank == 0)
+          printf("WARNING: async checkpointing requires MPI_THREAD_MULTIPLE "
+                 "(set NEKRS_MPI_THREAD_MULTIPLE=1), falling back to synchronous writes!\n");
+        enabled = 0;
+      }
+    }
+    if (enabled) {
+      MPI_Comm_dup(platform->comm.mpiComm, &ioComm);
+      ioThread = std::thread(ioLoop);
+    }
+  }
+  return enabled;
+}
+
+arena_t *acquireArena(size_t NbytesData, size_t NbytesOut)
+{
+  int maxQueueDepth = 2;
+  platform->options.getArgs("CHECKPOINT QUEUE DEPTH", maxQueueDepth);
+  maxQueueDepth = std::max(maxQueueDepth, 1);
+
+  arena_t *arena = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(ioMutex);
+    if (freeArenas.empty() && arenas.size() < maxQueueDepth) {
+      arenas.push_back(std::make_unique<arena_t>());
+      freeArenas.push_back(arenas.back().get());
+    }
+    // bounded queue, stall until the I/O thread hands back an arena
+    ioCv.wait(lock, [] { return !freeArenas.empty(); });
+    arena = freeArenas.back();
+    freeArenas.pop_back();
+  }
+
+  reallocArena(*arena, NbytesData, NbytesOut);
+  return arena;
+}
+
+} // namespace
+
+namespace fld {
+
+void write(const std::string &prefix,
+           mesh_t *mesh,
+           dlong fieldOffset,
+           double time,
+           int step,
+           dfloat p0th,
+           int outXYZ,
+           int FP64,
+           const occa::memory &o_uu,
+           const occa::memory &o_pp,
+           const occa::memory &o_ss,
+           int NSfields)
+{
+  platform->timer.tic("checkpointing", 1);
+
+  MPI_Comm comm = platform->comm.mpiComm;
+  const int rank = platform->comm.mpiRank;
+  const bool async = asyncEnabled();
+
+  auto job = std::make_unique<job_t>();
+  job->prefix = prefix;
+  platform->options.getArgs("CASENAME", job->casename);
+  {
+    std::string compression;
+    platform->options.getArgs("CHECKPOINT COMPRESSION", compression);
+    job->compression = fld::compressionType(compression);
+    job->tolerance = 0;
+    platform->options.getArgs("CHECKPOINT COMPRESSION TOLERANCE", job->tolerance);
+  }
+  const bool compressed = job->compression != fld::compression_t::none;
+  job->counter = ++fileCounter[prefix];
+  job->fname = fileName(prefix, job->casename, job->counter, compressed);
+  job->step = step;
+  job->time = time;
+  job->FP64 = FP64;
+  job->Nq = mesh->Nq;
+  job->Np = mesh->Np;
+  job->Nelements = mesh->Nelements;
+
+  if (prefix.empty() && job->counter == 1)
+    outXYZ = 1;
+
+  const dlong Nlocal = mesh->Nelements * mesh->Np;
+  const int wordSize = FP64 ? sizeof(double) : sizeof(float);
+
+  job->nelgt = mesh->Nelements;
+  MPI_Allreduce(MPI_IN_PLACE, &job->nelgt, 1, MPI_HLONG, MPI_SUM, comm);
+  job->nelB = 0;
+  {
+    hlong Nelements = mesh->Nelements;
+    MPI_Exscan(&Nelements, &job->nelB, 1, MPI_HLONG, MPI_SUM, comm);
+    if (rank == 0)
+      job->nelB = 0;
+  }
+
+  job->glel.resize(mesh->Nelements);
+  for (dlong e = 0; e < mesh->Nelements; e++)
+    job->glel[e] = nek::lglel(e) + 1;
+
+  std::vector<occa::memory> components;
+  std::string rdcode;
+
+  auto component = [&](const occa::memory &o_fld, int i) {
+    return o_fld.cast(occa::dtype::byte) + i * fieldOffset * sizeof(dfloat);
+  };
+
+  if (outXYZ) {
+    components.push_back(mesh->o_x.cast(occa::dtype::byte));
+    components.push_back(mesh->o_y.cast(occa::dtype::byte));
+    components.push_back(mesh->o_z.cast(occa::dtype::byte));
+    job->Ncomponents.push_back(mesh->dim);
+    rdcode += "X";
+  }
+  if (o_uu.isInitialized()) {
+    for (int i = 0; i < mesh->dim; i++)
+      components.push_back(component(o_uu, i));
+    job->Ncomponents.push_back(mesh->dim);
+    rdcode += "U";
+  }
+  if (o_pp.isInitialized()) {
+    components.push_back(component(o_pp, 0));
+    job->Ncomponents.push_back(1);
+    rdcode += "P";
+  }
+  if (o_ss.isInitialized() && NSfields) {
+    for (int is = 0; is < NSfields; is++) {
+      components.push_back(component(o_ss, is));
+      job->Ncomponents.push_back(1);
+    }
+    rdcode += "T";
+    if (NSfields > 1) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "S%02d", NSfields - 1);
+      rdcode += buf;
+    }
+  }
+
+  if (compressed)
+    job->header =
+        compressedHeader(mesh->Nq, job->nelgt, time, step, rdcode, p0th, job->compression, job->tolerance);
+  else
+    job->header = header(wordSize, mesh->Nq, job->nelgt, time, step, rdcode, p0th);
+
+  if (rank == 0) {
+    printf("\n%9d %11.4E Write checkpoint%s\n", step, time, async ? " (async)" : "");
+    printf("      FILE: %s\n", job->fname.c_str());
+    fflush(stdout);
+  }
+
+  const size_t NbytesData = components.size() * Nlocal * sizeof(dfloat);
+  // compressed records are assembled by the encoder, no conversion buffer required
+  const size_t NbytesOut = compressed ? 0 : mesh->dim * Nlocal * wordSize;
+
+  static arena_t syncArena;
+  if (async) {
+    job->arena = acquireArena(NbytesData, NbytesOut);
+  } else {
+    reallocArena(syncArena, NbytesData, NbytesOut);
+    job->arena = &syncArena;
+  }
+
+  // snapshot
+  {
+    auto data = static_cast<dfloat *>(job->arena->h_data.ptr());
+    for (const auto &o_component : components) {
+      o_component.copyTo(data, Nlocal * sizeof(dfloat));
+      data += Nlocal;
+    }
+  }
+
+  if (async) {
+    {
+      std::lock_guard<std::mutex> lock(ioMutex);
+      ioQueue.push_back(std::move(job));
+      pendingJobs++;
+    }
+    ioCv.notify_all();
+  } else {
+    runJob(*job, comm);
+  }
+
+  platform->timer.toc("checkpointing");
+}
+
+void flush()
+{
+  if (ioComm == MPI_COMM_NULL)
+    return;
+
+  platform->timer.tic("checkpointing", 1);
+  {
+    std::unique_lock<std::mutex> lock(ioMutex);
+    ioCv.wait(lock, [] { return pendingJobs == 0; });
+  }
+  platform->timer.toc("checkpointing");
+}
+
+void finalize()
+{
+  if (ioComm == MPI_COMM_NULL)
+    return;
+
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(ioMutex);
+    shutdownRequested = true;
+  }
+  ioCv.notify_all();
+  ioThread.join();
+
+  arenas.clear();
+  freeArenas.clear();
+  MPI_Comm_free(&ioComm);
+}
+
+} // namespace fld
@@ -1,19 +1,24 @@
 #include "nrs.hpp"
+#include "inipp.hpp"
+#include "nekrs.hpp"
 #include "nekInterfaceAdapter.hpp"
 
-
 void writeFld(std::string suffix, dfloat t, int step, int outXYZ, int FP64,
               const occa::memory& o_s, int NSfields)
 {
-  nek::outfld(suffix.c_str(), t, step, outXYZ, FP64, 
-              o_NULL, o_NULL, o_s, NSfields); 
+  writeFld(suffix, t, step, outXYZ, FP64, o_NULL, o_NULL, o_s, NSfields);
 }
 
 void writeFld(std::string suffix, dfloat t, int step, int outXYZ, int FP64,
               const occa::memory& o_u, const occa::memory& o_p, const occa::memory& o_s,
               int NSfields)
 {
-  nek::outfld(suffix.c_str(), t, step, outXYZ, FP64, o_u, o_p, o_s, NSfields); 
+  if (platform->options.compareArgs("CHECKPOINT ENGINE", "NEKRS")) {
+    auto nrs = static_cast<nrs_t *>(nekrs::nrsPtr());
+    fld::write(suffix, nrs->_mesh, nrs->fieldOffset, t, step, nrs->p0th[0], outXYZ, FP64, o_u, o_p, o_s, NSfields);
+  } else {
+    nek::outfld(suffix.c_str(), t, step, outXYZ, FP64, o_u, o_p, o_s, NSfields); 
+  }
 }
 
 void writeFld(nrs_t *nrs, dfloat t, int step, int outXYZ, int FP64, std::string suffix) 
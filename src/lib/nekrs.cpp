@@ -18,6 +18,7 @@
 #include "AMGX.hpp"
 #include "hypreWrapper.hpp"
 #include "hypreWrapperDevice.hpp"
+#include "meshCostWeights.hpp"
 
 namespace fs = std::filesystem;
 
@@ -104,6 +105,18 @@ setupAide* setDefaultSettings(std::string casename)
   options->setArgs("VARIABLE DT", "FALSE");
 
   options->setArgs("CHECKPOINT OUTPUT MESH", "FALSE");
+  options->setArgs("CHECKPOINT ENGINE", "NEK");
+  options->setArgs("CHECKPOINT PRECISION", "FP32");
+  options->setArgs("CHECKPOINT ASYNC", "FALSE");
+  options->setArgs("CHECKPOINT QUEUE DEPTH", "2");
+  options->setArgs("CHECKPOINT COMPRESSION", "NONE");
+  options->setArgs("CHECKPOINT COMPRESSION TOLERANCE", "1e-6");
+  options->setArgs("MESH ELEMENT ORDER", "PARTITIONER");
+  options->setArgs("MESH PARTITION WEIGHTS", "NONE");
+  options->setArgs("RESTART ENGINE", "NEK");
+  options->setArgs("KERNEL TUNING", "CACHED");
+  options->setArgs("TIMER EXPORT", "FALSE");
+  options->setArgs("TIMER TRACE SIZE", "65536");
 
   const auto dropTol = 5.0 * std::numeric_limits<pfloat>::epsilon();
   options->setArgs("AMG DROP TOLERANCE", to_string_f(dropTol));
@@ -475,7 +488,23 @@ int updateFileCheckFreq()
   return freq;
 }
 
-void printRuntimeStatistics(int step) { platform->timer.printRunStat(step); }
+void printRuntimeStatistics(int step)
+{
+  platform->timer.printRunStat(step);
+  platform->device.printMemoryUsage(platform->comm.mpiComm);
+
+  if (platform->options.compareArgs("MESH PARTITION WEIGHTS", "COST"))
+    meshCostWeights::update(platform->timer.busyTime(), platform->comm.mpiComm);
+
+  if (platform->options.compareArgs("TIMER EXPORT", "TRUE")) {
+    std::string casename;
+    platform->options.getArgs("CASENAME", casename);
+    platform->timer.exportStats(casename + ".timers.json");
+    platform->timer.exportTrace(casename + ".trace.json");
+  }
+}
+
+void printMemoryFit() { platform->device.printMemoryFit(nrs->_mesh->Nelements, platform->comm.mpiComm); }
 
 void processUpdFile()
 {
@@ -624,6 +653,8 @@ int nrsFinalize(nrs_t *nrs)
     if (nrs->meshSolver)
       delete nrs->meshSolver;
 
+    fld::finalize();
+
     hypreWrapper::finalize();
     hypreWrapperDevice::finalize();
     AMGXfinalize();
@@ -25,6 +25,7 @@ int runTimeStatFreq();
 int printInfoFreq();
 int updateFileCheckFreq();
 void printRuntimeStatistics(int step);
+void printMemoryFit();
 double writeInterval(void);
 double dt(int tStep);
 double startTime(void);
@@ -97,6 +97,7 @@ volatile sig_atomic_t processUpdFile = 0;
 struct cmdOptions
 {
   int buildOnly = 0;
+  int fitCheck = 0;
   int ciMode = 0;
   int debug = 0;
   int sizeTarget = 0;
@@ -148,6 +149,7 @@ cmdOptions* processCmdLineOptions(int argc, char** argv, const MPI_Comm &comm)
         {"setup", required_argument, 0, 's'},
         {"cimode", required_argument, 0, 'c'},
         {"build-only", optional_argument, 0, 'b'},
+        {"fit-check", no_argument, 0, 'f'},
         {"debug", no_argument, 0, 'd'},
         {"backend", required_argument, 0, 't'},
         {"device-id", required_argument, 0, 'i'},
@@ -176,6 +178,9 @@ cmdOptions* processCmdLineOptions(int argc, char** argv, const MPI_Comm &comm)
         if(!optarg && argv[optind] != NULL && argv[optind][0] != '-')
           cmdOpt->sizeTarget = std::stoi(argv[optind++]);
         break;
+      case 'f':
+        cmdOpt->fitCheck = 1;
+        break;
       case 'c':
         cmdOpt->ciMode = atoi(optarg);
         if (cmdOpt->ciMode < 0) {
@@ -230,6 +235,7 @@ cmdOptions* processCmdLineOptions(int argc, char** argv, const MPI_Comm &comm)
   }
 
   MPI_Bcast(&cmdOpt->buildOnly, sizeof(cmdOpt->buildOnly), MPI_BYTE, 0, comm);
+  MPI_Bcast(&cmdOpt->fitCheck, sizeof(cmdOpt->fitCheck), MPI_BYTE, 0, comm);
   MPI_Bcast(&cmdOpt->sizeTarget, sizeof(cmdOpt->sizeTarget), MPI_BYTE, 0, comm);
   MPI_Bcast(&cmdOpt->ciMode, sizeof(cmdOpt->ciMode), MPI_BYTE, 0, comm);
   MPI_Bcast(&cmdOpt->debug, sizeof(cmdOpt->debug), MPI_BYTE, 0, comm);
@@ -250,7 +256,7 @@ cmdOptions* processCmdLineOptions(int argc, char** argv, const MPI_Comm &comm)
       } else {
         std::cout << "usage: ./nekrs [--help <par>] "
                   << "--setup <par|sess file> "
-                  << "[ --build-only <#procs> ] [ --cimode <id> ] [ --debug ] "
+                  << "[ --build-only <#procs> ] [ --fit-check ] [ --cimode <id> ] [ --debug ] "
                   << "[ --backend <CPU|CUDA|HIP|DPCPP|OPENCL> ] [ --device-id <id|LOCAL-RANK> ]"
                   << "\n";
       }
@@ -546,6 +552,21 @@ int main(int argc, char** argv)
  
     double time = nekrs::startTime();
  
+    // one step to size the solver scratch space, then report peak memory usage
+    if (cmdOpt->fitCheck) {
+      const double dt = nekrs::dt(1);
+      nekrs::outputStep(0);
+      nekrs::initStep(time, dt, 1);
+      int corrector = 1;
+      while (!nekrs::runStep(corrector++))
+        ;
+      nekrs::finishStep();
+      nekrs::printMemoryFit();
+      nekrs::finalize();
+      MPI_Finalize();
+      return EXIT_SUCCESS;
+    }
+ 
     double elapsedTime = 0;
     {
       MPI_Barrier(comm);
@@ -563,6 +584,7 @@ int main(int argc, char** argv)
  
     nekrs::udfExecuteStep(time, tStep, /* outputStep */ 0);
     nekrs::resetTimer("udfExecuteStep");
+    nekrs::resetTimer("sync wait");
  
     double elapsedStepSum = 0;
  
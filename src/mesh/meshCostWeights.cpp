@@ -0,0 +1,97 @@
+#include <numeric>
+#include <algorithm>
+#include "platform.hpp"
+#include "nekInterfaceAdapter.hpp"
+#include "fileUtils.hpp"
+#include "re2Reader.hpp"
+#include "meshCostWeights.hpp"
+
+namespace meshCostWeights
+{
+
+std::string fileName()
+{
+  std::string casename;
+  platform->options.getArgs("CASENAME", casename);
+  return casename + ".cost";
+}
+
+void update(double cost, MPI_Comm comm)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  double costMin = cost;
+  MPI_Allreduce(MPI_IN_PLACE, &costMin, 1, MPI_DOUBLE, MPI_MIN, comm);
+  if (costMin <= 0)
+    return;
+
+  const auto file = fileName();
+  const int Nelements = nekData.nelt;
+
+  // file views need increasing displacements
+  std::vector<hlong> ids(Nelements);
+  for (int e = 0; e < Nelements; e++)
+    ids[e] = nek::lglel(e) + 1;
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<MPI_Aint> displs(Nelements);
+  for (int e = 0; e < Nelements; e++)
+    displs[e] = (ids[e] - 1) * sizeof(double);
+
+  MPI_Datatype view;
+  MPI_Type_create_hindexed_block(Nelements, 1, displs.data(), MPI_DOUBLE, &view);
+  MPI_Type_commit(&view);
+
+  int nelgt, nelgv;
+  re2::nelg(platform->options.getArgs("MESH FILE"), nelgt, nelgv, comm);
+
+  // weights of the current partition, a file of another mesh is ignored
+  int exists = 0;
+  if (rank == 0)
+    exists = fs::exists(file) && fs::file_size(file) == static_cast<size_t>(nelgt) * sizeof(double);
+  MPI_Bcast(&exists, 1, MPI_INT, 0, comm);
+
+  std::vector<double> w(Nelements, 1.0);
+  MPI_File fh;
+  if (exists) {
+    nrsCheck(MPI_File_open(comm, file.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS,
+             comm, EXIT_FAILURE, "cannot open %s\n", file.c_str());
+    MPI_File_set_view(fh, 0, MPI_DOUBLE, view, "native", MPI_INFO_NULL);
+    MPI_File_read_all(fh, w.data(), Nelements, MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&fh);
+    for (auto &&we : w)
+      we = (we > 0) ? we : 1.0;
+  }
+
+  // cost per unit weight of this rank
+  const double W = std::accumulate(w.begin(), w.end(), 0.0);
+  const double scale = (W > 0) ? cost / W : 0;
+
+  double sum[2] = {0, static_cast<double>(Nelements)};
+  for (auto &&we : w) {
+    we *= scale;
+    sum[0] += we;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, comm);
+  const double mean = sum[0] / sum[1];
+  for (auto &&we : w)
+    we /= mean;
+
+  if (rank == 0)
+    MPI_File_delete(file.c_str(), MPI_INFO_NULL);
+  MPI_Barrier(comm);
+  nrsCheck(MPI_File_open(comm, file.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh) !=
+               MPI_SUCCESS,
+           comm, EXIT_FAILURE, "cannot open %s\n", file.c_str());
+  MPI_File_set_view(fh, 0, MPI_DOUBLE, view, "native", MPI_INFO_NULL);
+  MPI_File_write_all(fh, w.data(), Nelements, MPI_DOUBLE, MPI_STATUS_IGNORE);
+  MPI_File_close(&fh);
+
+  MPI_Type_free(&view);
+
+  if (rank == 0)
+    printf("updated partition cost weights %s\n", file.c_str());
+}
+
+} // namespace meshCostWeights
@@ -0,0 +1,17 @@
+#if !defined(nekrs_meshcostweights_hpp_)
+#define nekrs_meshcostweights_hpp_
+
+#include "nrssys.hpp"
+
+// per element cost weights picked up by the partitioner at the next (re)start,
+// one double per global element id in native byte order
+namespace meshCostWeights
+{
+std::string fileName();
+
+// collective, scales the weights the current partition was built with (or one) by the
+// measured cost per unit weight of each rank and writes them normalized to a mean of one
+void update(double cost, MPI_Comm comm);
+} // namespace meshCostWeights
+
+#endif
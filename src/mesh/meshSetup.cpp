@@ -370,34 +370,37 @@ mesh_t *createMeshMG(mesh_t *_mesh, int Nc)
 
   mesh->geometricFactors();
 
-  mesh->o_vgeo.free(); // dfloat version not required
-  mesh->o_LMM.free(); // dfloat version not required
+  platform->device.free(mesh->o_vgeo); // dfloat version not required
+  platform->device.free(mesh->o_LMM); // dfloat version not required
 
   {
     const auto length = mesh->o_ggeo.length();
     auto o_tmp = platform->device.malloc<dfloat>(length);
     mesh->o_ggeo.copyTo(o_tmp); 
-    mesh->o_ggeo.free();
+    platform->device.free(mesh->o_ggeo);
     mesh->o_ggeo = platform->device.malloc<pfloat>(length);
     platform->copyDfloatToPfloatKernel(length, o_tmp, mesh->o_ggeo);
+    platform->device.free(o_tmp);
   }
 
   {
     const auto length = mesh->o_D.length();
     auto o_tmp = platform->device.malloc<dfloat>(length);
     mesh->o_D.copyTo(o_tmp); 
-    mesh->o_D.free();
+    platform->device.free(mesh->o_D);
     mesh->o_D = platform->device.malloc<pfloat>(length);
     platform->copyDfloatToPfloatKernel(length, o_tmp, mesh->o_D);
+    platform->device.free(o_tmp);
   }
 
   {
     const auto length = mesh->o_DT.length();
     auto o_tmp = platform->device.malloc<dfloat>(length);
     mesh->o_DT.copyTo(o_tmp); 
-    mesh->o_DT.free();
+    platform->device.free(mesh->o_DT);
     mesh->o_DT = platform->device.malloc<pfloat>(length);
     platform->copyDfloatToPfloatKernel(length, o_tmp, mesh->o_DT);
+    platform->device.free(o_tmp);
   }
  
   return mesh;
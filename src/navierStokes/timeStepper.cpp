@@ -646,6 +646,9 @@ void scalarSolve(nrs_t *nrs, double time, occa::memory o_S, int stage)
     if (!cds->compute[is] || cds->cvodeSolve[is]) {
       continue;
     }
+    if (std::find(cds->batchIds.begin(), cds->batchIds.end(), is) != cds->batchIds.end()) {
+      continue;
+    }
 
     mesh_t *mesh;
     (is) ? mesh = cds->meshV : mesh = cds->mesh[0];
@@ -663,6 +666,30 @@ void scalarSolve(nrs_t *nrs, double time, occa::memory o_S, int stage)
     occa::memory o_Snew = cdsSolve(is, cds, time, stage);
     o_Snew.copyTo(o_S, cds->fieldOffset[is], cds->fieldOffsetScan[is]);
   }
+
+  if (cds->batchSolver) {
+    const int Nbatch = cds->batchIds.size();
+    mesh_t *mesh = cds->meshV;
+
+    for (int fld = 0; fld < Nbatch; fld++) {
+      auto o_coeff = cds->o_batchEllipticCoeff + fld * nrs->fieldOffset;
+      cds->setEllipticCoeffKernel(mesh->Nlocal,
+                                  cds->g0 * cds->idt,
+                                  cds->fieldOffsetScan[cds->batchIds[fld]],
+                                  Nbatch * nrs->fieldOffset,
+                                  static_cast<int>(cds->o_BFDiag.isInitialized()),
+                                  cds->o_diff,
+                                  cds->o_rho,
+                                  cds->o_BFDiag,
+                                  o_coeff);
+    }
+
+    occa::memory o_Snew = cdsSolveBatch(cds, time, stage);
+    for (int fld = 0; fld < Nbatch; fld++) {
+      const int is = cds->batchIds[fld];
+      o_Snew.copyTo(o_S, cds->fieldOffset[is], cds->fieldOffsetScan[is], fld * nrs->fieldOffset);
+    }
+  }
   platform->timer.toc("scalarSolve");
 }
 
@@ -846,6 +873,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                      solver->res00Norm / solver->res0Norm,
                      prevVecs,
                      solver->solutionProjection->getMaxNumVecsProjection());
+              if (solver->solutionProjection->isAdaptive())
+                solver->solutionProjection->printAdaptiveInfo();
             }
           }
           printf("S%02d      : iter %03d  resNorm0 %.2e  "
@@ -875,6 +904,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                    solver->res00Norm / solver->res0Norm,
                    prevVecs,
                    solver->solutionProjection->getMaxNumVecsProjection());
+            if (solver->solutionProjection->isAdaptive())
+              solver->solutionProjection->printAdaptiveInfo();
           }
         }
         printf("P        : iter %03d  resNorm0 %.2e  resNorm %.2e\n",
@@ -893,6 +924,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                      solver->res00Norm / solver->res0Norm,
                      prevVecs,
                      solver->solutionProjection->getMaxNumVecsProjection());
+              if (solver->solutionProjection->isAdaptive())
+                solver->solutionProjection->printAdaptiveInfo();
             }
           }
           printf("UVW      : iter %03d  resNorm0 %.2e  "
@@ -913,6 +946,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                      solver->res00Norm / solver->res0Norm,
                      prevVecs,
                      solver->solutionProjection->getMaxNumVecsProjection());
+              if (solver->solutionProjection->isAdaptive())
+                solver->solutionProjection->printAdaptiveInfo();
             }
           }
           printf("U        : iter %03d  resNorm0 %.2e  "
@@ -932,6 +967,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                      solver->res00Norm / solver->res0Norm,
                      prevVecs,
                      solver->solutionProjection->getMaxNumVecsProjection());
+              if (solver->solutionProjection->isAdaptive())
+                solver->solutionProjection->printAdaptiveInfo();
             }
           }
           printf("V        : iter %03d  resNorm0 %.2e  "
@@ -949,6 +986,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                      solver->res00Norm / solver->res0Norm,
                      prevVecs,
                      solver->solutionProjection->getMaxNumVecsProjection());
+              if (solver->solutionProjection->isAdaptive())
+                solver->solutionProjection->printAdaptiveInfo();
             }
           }
           printf("W        : iter %03d  resNorm0 %.2e  "
@@ -970,6 +1009,8 @@ void printInfo(nrs_t *nrs, double time, int tstep, bool printStepInfo, bool prin
                    solver->res00Norm / solver->res0Norm,
                    prevVecs,
                    solver->solutionProjection->getMaxNumVecsProjection());
+            if (solver->solutionProjection->isAdaptive())
+              solver->solutionProjection->printAdaptiveInfo();
           }
         }
         printf("MSH      : iter %03d  resNorm0 %.2e  resNorm %.2e\n",
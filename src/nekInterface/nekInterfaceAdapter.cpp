@@ -6,6 +6,7 @@
 #include "neknek.hpp"
 #include "fileUtils.hpp"
 #include "re2Reader.hpp"
+#include "meshCostWeights.hpp"
 #include "fileUtils.hpp"
 
 nekdata_private nekData;
@@ -595,6 +596,8 @@ void buildNekInterface(int ldimt, int N, int np, setupAide &options)
       re2::nelg(meshFile, nelgt, nelgv, MPI_COMM_SELF);
 
       int lelt = (nelgt / np) + 3;
+      if (options.compareArgs("MESH PARTITION WEIGHTS", "COST"))
+        lelt = 2 * (nelgt / np) + 8; // weights are clamped to [1/sqrt(2), sqrt(2)] of their mean
       if (lelt > nelgt)
         lelt = nelgt;
 
@@ -768,10 +771,27 @@ int setup(nrs_t *nrs_in)
     meshPartType = 2;
   if (options->compareArgs("MESH PARTITIONER", "rcb+rsb"))
     meshPartType = 3;
+  if (options->compareArgs("MESH ELEMENT ORDER", "LOCALITY"))
+    meshPartType |= 8; // renumber rank local elements after partitioning
 
   double meshConTol = 0.2;
   options->getArgs("MESH CONNECTIVITY TOL", meshConTol);
 
+  if (options->compareArgs("MESH PARTITION WEIGHTS", "COST")) {
+    const std::string costFile = meshCostWeights::fileName();
+    int costFileExists;
+    if (rank == 0)
+      costFileExists = fs::exists(costFile) && fs::file_size(costFile) > 0;
+    MPI_Bcast(&costFileExists, 1, MPI_INT, 0, platform->comm.mpiComm);
+    if (costFileExists) {
+      if (rank == 0)
+        printf("using partition cost weights from %s\n", costFile.c_str());
+      setenv("NEKRS_PARTITION_WEIGHTS", costFile.c_str(), 1);
+    } else {
+      unsetenv("NEKRS_PARTITION_WEIGHTS");
+    }
+  }
+
   int nBcRead = 1; // at the very least we have to read the boundaryIDs
   if (bcMap::useNekBCs())
     nBcRead += nscalSolve;
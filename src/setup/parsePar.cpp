@@ -122,6 +122,7 @@ static std::vector<std::string> generalKeys = {
     {"dealiasing"},
     {"cubaturePolynomialOrder"},
     {"startFrom"},
+    {"restartEngine"},
     {"stopAt"},
     {"elapsedtime"},
     {"timestepper"},
@@ -129,8 +130,12 @@ static std::vector<std::string> generalKeys = {
     {"subCycling"},
     {"writeControl"},
     {"writeInterval"},
+    {"checkpointEngine"},
+    {"checkpointPrecision"},
+    {"checkpointCompression"},
     {"constFlowRate"},
     {"verbose"},
+    {"timerExport"},
     {"variableDT"},
     {"nScalars"}, // sans temperature
 
@@ -162,6 +167,7 @@ static std::vector<std::string> commonKeys = {
     {"boundaryTypeMap"},
     {"maxIterations"},
     {"regularization"},
+    {"integration"},
 
     // deprecated filter params
     {"filtering"},
@@ -176,6 +182,8 @@ static std::vector<std::string> meshKeys = {
     {"initialGuess"},
     {"boundaryTypeMap"},
     {"partitioner"},
+    {"elementorder"},
+    {"partitionweights"},
     {"file"},
     {"connectivitytol"},
     {"writetofieldfile"},
@@ -225,10 +233,17 @@ static std::vector<std::string> boomeramgKeys = {
     {"chebyshevFraction"},
 };
 
+static std::vector<std::string> saamgKeys = {
+    {"strongThreshold"},
+    {"coarsestSize"},
+    {"chebyshevDegree"},
+    {"chebyshevFraction"},
+};
+
 static std::vector<std::string> amgxKeys = {
     {"configFile"},
 };
-static std::vector<std::string> occaKeys = {{"backend"}, {"deviceNumber"}, {"platformNumber"}};
+static std::vector<std::string> occaKeys = {{"backend"}, {"deviceNumber"}, {"platformNumber"}, {"kernelTuning"}};
 
 static std::vector<std::string> pressureKeys = {};
 
@@ -251,6 +266,7 @@ static std::vector<std::string> validSections = {
     {"problemtype"},
     {"amgx"},
     {"boomeramg"},
+    {"saamg"},
     {"occa"},
     {"mesh"},
     {"scalar"},
@@ -270,6 +286,7 @@ void makeStringsLowerCase()
   lowerCase(deprecatedKeys);
   lowerCase(amgxKeys);
   lowerCase(boomeramgKeys);
+  lowerCase(saamgKeys);
   lowerCase(pressureKeys);
   lowerCase(occaKeys);
   lowerCase(cvodeKeys);
@@ -301,6 +318,8 @@ const std::vector<std::string> &getValidKeys(const std::string &section)
     return amgxKeys;
   if (section == "boomeramg")
     return boomeramgKeys;
+  if (section == "saamg")
+    return saamgKeys;
   if (section == "occa")
     return occaKeys;
   if (section == "velocity")
@@ -776,9 +795,11 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       {"smoother"},
       {"boomeramg"},
       {"amgx"},
+      {"saamg"},
       {"cpu"},
       {"device"},
       {"overlap"},
+      {"agglomerate"},
   };
 
   std::vector<std::string> entries = serializeString(p_coarseSolver, '+');
@@ -789,7 +810,8 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
   const int smoother = p_coarseSolver.find("smoother") != std::string::npos;
   const int amgx = p_coarseSolver.find("amgx") != std::string::npos;
   const int boomer = p_coarseSolver.find("boomeramg") != std::string::npos;
-  if (amgx + boomer > 1)
+  const int saamg = p_coarseSolver.find("saamg") != std::string::npos;
+  if (amgx + boomer + saamg > 1)
     append_error("Conflicting solver types in coarseSolver!\n");
 
   if (boomer) {
@@ -800,7 +822,7 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
     }
   }
 
-  if (boomer || amgx) {
+  if (boomer || amgx || saamg) {
     options.setArgs(parSectionName + "MULTIGRID COARSE SOLVE", "TRUE");
     options.setArgs(parSectionName + "COARSE SOLVER", "BOOMERAMG");
     if (amgx) {
@@ -808,6 +830,9 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       if (!AMGXenabled())
         append_error("AMGX was requested but is not enabled!\n");
     }
+    if (saamg) {
+      options.setArgs(parSectionName + "COARSE SOLVER", "SAAMG");
+    }
 
     options.setArgs(parSectionName + "COARSE SOLVER PRECISION", "FP32");
     if (options.compareArgs(parSectionName + "PRECONDITIONER", "SEMFEM")) {
@@ -818,6 +843,9 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       if (options.compareArgs(parSectionName + "MULTIGRID SEMFEM", "TRUE"))
         options.setArgs(parSectionName + "COARSE SOLVER LOCATION", "DEVICE");
     }
+    if (saamg) {
+      options.setArgs(parSectionName + "COARSE SOLVER LOCATION", "DEVICE");
+    }
 
     for (std::string entry : entries) {
       if (entry.find("smoother") != std::string::npos) {
@@ -836,6 +864,9 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
         if (!options.compareArgs(parSectionName + "MGSOLVER CYCLE", "ADDITIVE"))
           append_error("Overlapping coarse solve requires additive multigrid!\n");
       }
+      else if (entry.find("agglomerate") != std::string::npos) {
+        options.setArgs(parSectionName + "COARSE SOLVER AGGLOMERATE", "TRUE");
+      }
     }
   }
   else {
@@ -859,6 +890,17 @@ void parseCoarseSolver(const int rank, setupAide &options, inipp::Ini *par, std:
     append_error("AMGX on CPU is not supported!\n");
   }
 
+  if (p_coarseSolver.find("agglomerate") != std::string::npos) {
+    if (!boomer || !options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "CPU") ||
+        options.compareArgs(parSectionName + "MULTIGRID SEMFEM", "TRUE") ||
+        options.compareArgs(parSectionName + "PRECONDITIONER", "SEMFEM"))
+      append_error("Agglomerated coarse solve requires boomerAMG on CPU with a FEM coarse grid!\n");
+  }
+
+  if (saamg && options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "CPU")) {
+    append_error("SAAMG on CPU is not supported!\n");
+  }
+
   if (boomer && options.compareArgs(parSectionName + "COARSE SOLVER LOCATION", "GPU")) {
     if (hypreWrapperDevice::enabled()) {
       append_error("HYPRE is not configured to run on the GPU!\n");
@@ -921,6 +963,8 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
       {"jac"},
       {"mineigenvalueboundfactor"},
       {"maxeigenvalueboundfactor"},
+      {"fp16"},
+      {"bf16"},
   };
 
   {
@@ -934,6 +978,16 @@ void parseSmoother(const int rank, setupAide &options, inipp::Ini *par, std::str
     std::vector<std::string> list;
     list = serializeString(p_smoother, '+');
 
+    const bool fp16 = p_smoother.find("fp16") != std::string::npos;
+    const bool bf16 = p_smoother.find("bf16") != std::string::npos;
+    if (fp16 || bf16) {
+      if (fp16 && bf16)
+        append_error("Conflicting storage types in smootherType!\n");
+      if (p_smoother.find("asm") == std::string::npos && p_smoother.find("ras") == std::string::npos)
+        append_error("FP16/BF16 storage requires a Schwarz smoother (ASM or RAS)!\n");
+      options.setArgs(parSection + "MULTIGRID SCHWARZ STORAGE", fp16 ? "FP16" : "BF16");
+    }
+
     if (p_smoother.find("cheb") != std::string::npos) {
       bool surrogateSmootherSet = false;
       std::string chebyshevType = "";
@@ -1197,6 +1251,11 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       {"pgmres"},
       {"pcg"},
       {"combined"},
+      {"pipelined"},
+      {"replacement"},
+      {"lowsync"},
+      {"recycle"},
+      {"batched"},
       {"block"},
   };
   std::vector<std::string> list = serializeString(p_solver, '+');
@@ -1215,11 +1274,28 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       }
     }
     options.setArgs(parSectionName + "PGMRES RESTART", n);
-    if (p_solver.find("fgmres") != std::string::npos || p_solver.find("flexible") != std::string::npos) {
-      p_solver = "PGMRES+FLEXIBLE";
+    if (p_solver.find("recycle") != std::string::npos) {
+      if (p_solver.find("lowsync") != std::string::npos) {
+        std::ostringstream ss;
+        ss << "recycling GMRES cannot be combined with lowSync!\n";
+        append_value_error(ss.str());
+      }
+      std::string k = "8";
+      for (std::string s : list) {
+        const auto recycleStr = parseValueForKey(s, "recycle");
+        if (!recycleStr.empty()) {
+          k = recycleStr;
+        }
+      }
+      options.setArgs(parSectionName + "PGMRES RECYCLE DIMENSION", k);
+      // recycled solution space is built from the stored preconditioned vectors
+      p_solver = "PGMRES+FLEXIBLE+RECYCLE";
+    }
+    else if (p_solver.find("fgmres") != std::string::npos || p_solver.find("flexible") != std::string::npos) {
+      p_solver = (p_solver.find("lowsync") != std::string::npos) ? "PGMRES+FLEXIBLE+LOWSYNC" : "PGMRES+FLEXIBLE";
     }
     else {
-      p_solver = "PGMRES";
+      p_solver = (p_solver.find("lowsync") != std::string::npos) ? "PGMRES+LOWSYNC" : "PGMRES";
     }
   }
   else if (p_solver.find("cg") != std::string::npos) {
@@ -1230,13 +1306,47 @@ void parseLinearSolver(const int rank, setupAide &options, inipp::Ini *par, std:
       options.setArgs(parSectionName + "BLOCK SOLVER", "FALSE");
     }
 
-    if (p_solver.find("fcg") != std::string::npos || p_solver.find("flexible") != std::string::npos) {
+    if (p_solver.find("batched") != std::string::npos) {
+      if (parScope != "temperature" && parScope.find("scalar") == std::string::npos) {
+        std::ostringstream ss;
+        ss << "batched PCG solver only supported for scalars!\n";
+        append_value_error(ss.str());
+      }
+      if (p_solver.find("fcg") != std::string::npos || p_solver.find("flexible") != std::string::npos ||
+          p_solver.find("pipelined") != std::string::npos || p_solver.find("combined") != std::string::npos ||
+          p_solver.find("block") != std::string::npos) {
+        std::ostringstream ss;
+        ss << "batched PCG solver cannot be combined with other PCG variants!\n";
+        append_value_error(ss.str());
+      }
+      p_solver = "PCG+BATCHED";
+    } else if (p_solver.find("fcg") != std::string::npos || p_solver.find("flexible") != std::string::npos) {
+      if (p_solver.find("pipelined") != std::string::npos) {
+        std::ostringstream ss;
+        ss << "pipelined PCG solver not supported with flexible preconditioner!\n";
+        append_value_error(ss.str());
+      }
       p_solver = "PCG+FLEXIBLE";
       if (p_solver.find("combined") != std::string::npos) {
         std::ostringstream ss;
         ss << "combined PCG solver not supported with flexible preconditioner!\n";
         append_value_error(ss.str());
       }
+    } else if (p_solver.find("pipelined") != std::string::npos) {
+      if (p_solver.find("combined") != std::string::npos) {
+        std::ostringstream ss;
+        ss << "pipelined and combined PCG solver cannot be used together!\n";
+        append_value_error(ss.str());
+      }
+      std::string n = "50";
+      for (std::string s : list) {
+        const auto replacementStr = parseValueForKey(s, "replacement");
+        if (!replacementStr.empty()) {
+          n = replacementStr;
+        }
+      }
+      options.setArgs(parSectionName + "PCG RESIDUAL REPLACEMENT", n);
+      p_solver = "PCG+PIPELINED";
     } else {
       if (p_solver.find("combined") != std::string::npos) {
         if (!options.compareArgs(parSectionName + "PRECONDITIONER", "JACOBI")) {
@@ -1282,6 +1392,7 @@ void parseInitialGuess(const int rank, setupAide &options, inipp::Ini *par, std:
       // settings
       {"nvector"},
       {"start"},
+      {"adaptive"},
   };
 
   options.setArgs(parSectionName + "INITIAL GUESS", "EXTRAPOLATION");
@@ -1334,6 +1445,13 @@ void parseInitialGuess(const int rank, setupAide &options, inipp::Ini *par, std:
       const auto startStr = parseValueForKey(s, "start");
       if (!startStr.empty() && proj)
         options.setArgs(parSectionName + "RESIDUAL PROJECTION START", startStr);
+
+      if (s == "adaptive") {
+        if (proj)
+          options.setArgs(parSectionName + "RESIDUAL PROJECTION ADAPTIVE", "TRUE");
+        else
+          append_error("initialGuess +adaptive requires projection!\n");
+      }
     }
     return;
   }
@@ -1596,6 +1714,27 @@ void parseBoomerAmgSection(const int rank, setupAide &options, inipp::Ini *par)
   }
 }
 
+void parseSaamgSection(const int rank, setupAide &options, inipp::Ini *par)
+{
+  if (par->sections.count("saamg")) {
+    double strongThres;
+    if (par->extract("saamg", "strongthreshold", strongThres))
+      options.setArgs("SAAMG STRONG THRESHOLD", to_string_f(strongThres));
+    int coarsestSize;
+    if (par->extract("saamg", "coarsestsize", coarsestSize))
+      options.setArgs("SAAMG COARSEST SIZE", std::to_string(coarsestSize));
+    int chebyDegree;
+    if (par->extract("saamg", "chebyshevdegree", chebyDegree)) {
+      if (chebyDegree < 1)
+        append_error("SAAMG chebyshevDegree has to be positive!\n");
+      options.setArgs("SAAMG CHEBYSHEV DEGREE", std::to_string(chebyDegree));
+    }
+    double chebyFraction;
+    if (par->extract("saamg", "chebyshevfraction", chebyFraction))
+      options.setArgs("SAAMG CHEBYSHEV FRACTION", to_string_f(chebyFraction));
+  }
+}
+
 void parseOccaSection(const int rank, setupAide &options, inipp::Ini *par)
 {
   std::string backendSpecification;
@@ -1676,6 +1815,18 @@ void parseOccaSection(const int rank, setupAide &options, inipp::Ini *par)
     upperCase(platformNumber);
     options.setArgs("PLATFORM NUMBER", platformNumber);
   }
+
+  std::string kernelTuning;
+  if (par->extract("occa", "kerneltuning", kernelTuning)) {
+    const std::vector<std::string> validValues = {
+        {"cached"},
+        {"retune"},
+        {"none"},
+    };
+    checkValidity(rank, validValues, kernelTuning);
+    upperCase(kernelTuning);
+    options.setArgs("KERNEL TUNING", kernelTuning);
+  }
 }
 
 void parseGeneralSection(const int rank, setupAide &options, inipp::Ini *par)
@@ -1691,6 +1842,17 @@ void parseGeneralSection(const int rank, setupAide &options, inipp::Ini *par)
     options.setArgs("RESTART FILE NAME", startFrom);
   }
 
+  std::string restartEngine;
+  if (par->extract("general", "restartengine", restartEngine)) {
+    const std::vector<std::string> validValues = {
+        {"nek"},
+        {"nekrs"},
+    };
+    checkValidity(rank, validValues, restartEngine);
+    upperCase(restartEngine);
+    options.setArgs("RESTART ENGINE", restartEngine);
+  }
+
   int N;
   if (par->extract("general", "polynomialorder", N)) {
     options.setArgs("POLYNOMIAL DEGREE", std::to_string(N));
@@ -1921,6 +2083,98 @@ void parseGeneralSection(const int rank, setupAide &options, inipp::Ini *par)
     }
   }
 
+  std::string checkpointEngine;
+  if (par->extract("general", "checkpointengine", checkpointEngine)) {
+    const std::vector<std::string> validValues = {
+        {"nek"},
+        {"nekrs"},
+        {"async"},
+        {"queuedepth"},
+    };
+
+    std::vector<std::string> entries = serializeString(checkpointEngine, '+');
+    for (std::string entry : entries) {
+      checkValidity(rank, validValues, entry);
+
+      if (entry == "nek")
+        options.setArgs("CHECKPOINT ENGINE", "NEK");
+      else if (entry == "nekrs")
+        options.setArgs("CHECKPOINT ENGINE", "NEKRS");
+      else if (entry == "async")
+        options.setArgs("CHECKPOINT ASYNC", "TRUE");
+
+      const auto queueDepthStr = parseValueForKey(entry, "queuedepth");
+      if (!queueDepthStr.empty())
+        options.setArgs("CHECKPOINT QUEUE DEPTH", queueDepthStr);
+    }
+
+    if (options.compareArgs("CHECKPOINT ASYNC", "TRUE") && !options.compareArgs("CHECKPOINT ENGINE", "NEKRS"))
+      append_error("general::checkpointEngine+async requires nekrs engine");
+  }
+
+  std::string checkpointPrecision;
+  if (par->extract("general", "checkpointprecision", checkpointPrecision)) {
+    checkValidity(rank, {"fp32", "fp64"}, checkpointPrecision);
+
+    if (checkpointPrecision == "fp32")
+      options.setArgs("CHECKPOINT PRECISION", "FP32");
+    else if (checkpointPrecision == "fp64")
+      options.setArgs("CHECKPOINT PRECISION", "FP64");
+  }
+
+  std::string checkpointCompression;
+  if (par->extract("general", "checkpointcompression", checkpointCompression)) {
+    const std::vector<std::string> validValues = {
+        {"none"},
+        {"lossless"},
+        {"modal"},
+        {"tolerance"},
+    };
+
+    std::vector<std::string> entries = serializeString(checkpointCompression, '+');
+    for (std::string entry : entries) {
+      checkValidity(rank, validValues, entry);
+
+      if (entry == "none")
+        options.setArgs("CHECKPOINT COMPRESSION", "NONE");
+      else if (entry == "lossless")
+        options.setArgs("CHECKPOINT COMPRESSION", "LOSSLESS");
+      else if (entry == "modal")
+        options.setArgs("CHECKPOINT COMPRESSION", "MODAL");
+
+      const auto toleranceStr = parseValueForKey(entry, "tolerance");
+      if (!toleranceStr.empty())
+        options.setArgs("CHECKPOINT COMPRESSION TOLERANCE", toleranceStr);
+    }
+
+    if (!options.compareArgs("CHECKPOINT COMPRESSION", "NONE") &&
+        !options.compareArgs("CHECKPOINT ENGINE", "NEKRS"))
+      append_error("general::checkpointCompression requires checkpointEngine = nekrs");
+  }
+
+  std::string timerExport;
+  if (par->extract("general", "timerexport", timerExport)) {
+    const std::vector<std::string> validValues = {
+        {"true"},
+        {"false"},
+        {"tracesize"},
+    };
+
+    std::vector<std::string> entries = serializeString(timerExport, '+');
+    for (std::string entry : entries) {
+      checkValidity(rank, validValues, entry);
+
+      if (entry == "true")
+        options.setArgs("TIMER EXPORT", "TRUE");
+      else if (entry == "false")
+        options.setArgs("TIMER EXPORT", "FALSE");
+
+      const auto traceSizeStr = parseValueForKey(entry, "tracesize");
+      if (!traceSizeStr.empty())
+        options.setArgs("TIMER TRACE SIZE", traceSizeStr);
+    }
+  }
+
   bool dealiasing = true;
   if (par->extract("general", "dealiasing", dealiasing)) {
     if (dealiasing)
@@ -1987,6 +2241,20 @@ void parseMeshSection(const int rank, setupAide &options, inipp::Ini *par)
       options.setArgs("MESH PARTITIONER", meshPartitioner);
     }
 
+    std::string meshElementOrder;
+    if (par->extract("mesh", "elementorder", meshElementOrder)) {
+      checkValidity(rank, {"partitioner", "locality"}, meshElementOrder);
+      upperCase(meshElementOrder);
+      options.setArgs("MESH ELEMENT ORDER", meshElementOrder);
+    }
+
+    std::string meshPartitionWeights;
+    if (par->extract("mesh", "partitionweights", meshPartitionWeights)) {
+      checkValidity(rank, {"none", "cost"}, meshPartitionWeights);
+      upperCase(meshPartitionWeights);
+      options.setArgs("MESH PARTITION WEIGHTS", meshPartitionWeights);
+    }
+
     std::string meshConTol;
     if (par->extract("mesh", "connectivitytol", meshConTol)) {
       options.setArgs("MESH CONNECTIVITY TOL", meshConTol);
@@ -2016,6 +2284,38 @@ void parseMeshSection(const int rank, setupAide &options, inipp::Ini *par)
   }
 }
 
+void parseIntegration(const int rank, setupAide &options, inipp::Ini *par, std::string parScope)
+{
+  std::string parSectionName = parPrefixFromParSection(parScope);
+  upperCase(parSectionName);
+
+  std::string integration;
+  if (!par->extract(parScope, "integration", integration))
+    return;
+
+  if (integration == "collocation") {
+    options.setArgs(parSectionName + "ELLIPTIC INTEGRATION", "COLLOCATION");
+  }
+  else if (integration == "cubature") {
+    options.setArgs(parSectionName + "ELLIPTIC INTEGRATION", "CUBATURE");
+
+    int N, cubN;
+    options.getArgs("POLYNOMIAL DEGREE", N);
+    options.getArgs("CUBATURE POLYNOMIAL DEGREE", cubN);
+    if (cubN <= N)
+      append_error("integration = cubature requires cubaturePolynomialOrder > polynomialOrder!\n");
+    if (options.compareArgs(parSectionName + "BLOCK SOLVER", "TRUE"))
+      append_error("integration = cubature not supported for block solver!\n");
+    if (options.compareArgs(parSectionName + "SOLVER", "BATCHED"))
+      append_error("integration = cubature not supported for batched solver!\n");
+    if (options.compareArgs("ELEMENT MAP", "TRILINEAR"))
+      append_error("integration = cubature not supported for trilinear element map!\n");
+  }
+  else {
+    append_error("Could not parse integration = " + integration + "!\n");
+  }
+}
+
 void parsePressureSection(const int rank, setupAide &options, inipp::Ini *par)
 {
   options.setArgs("PRESSURE ELLIPTIC COEFF FIELD", "FALSE");
@@ -2028,8 +2328,12 @@ void parsePressureSection(const int rank, setupAide &options, inipp::Ini *par)
 
   parseLinearSolver(rank, options, par, "pressure");
 
+  parseIntegration(rank, options, par, "pressure");
+
   parseBoomerAmgSection(rank, options, par);
 
+  parseSaamgSection(rank, options, par);
+
   if (par->sections.count("amgx")) {
     if (!AMGXenabled()) {
       append_error("AMGX was requested but is not compiled!\n");
@@ -2055,6 +2359,8 @@ void parseVelocitySection(const int rank, setupAide &options, inipp::Ini *par)
 
   parseLinearSolver(rank, options, par, "velocity");
 
+  parseIntegration(rank, options, par, "velocity");
+
   parseSolverTolerance(rank, options, par, "velocity");
 
   std::string v_bcMap;
@@ -2159,6 +2465,8 @@ void parseScalarSections(const int rank, setupAide &options, inipp::Ini *par)
 
     parseLinearSolver(rank, options, par, "temperature");
 
+    parseIntegration(rank, options, par, "temperature");
+
     parseSolverTolerance(rank, options, par, "temperature");
 
     std::string sbuf;
@@ -2280,6 +2588,8 @@ void parseScalarSections(const int rank, setupAide &options, inipp::Ini *par)
 
     parseLinearSolver(rank, options, par, parScope);
 
+    parseIntegration(rank, options, par, parScope);
+
     parseSolverTolerance(rank, options, par, parScope);
 
 
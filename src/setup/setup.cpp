@@ -132,6 +132,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 {
   platform_t *platform = platform_t::getInstance();
   device_t &device = platform->device;
+  memoryScope_t memoryScope(device, memoryCategory_t::solver);
   nrs->kernelInfo = new occa::properties();
   *(nrs->kernelInfo) = platform->kernelInfo;
   occa::properties &kernelInfo = *nrs->kernelInfo;
@@ -229,7 +230,10 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
              "Invalid solid element partitioning");
   }
 
-  nrs->_mesh = createMesh(comm, N, cubN, nrs->cht, kernelInfo);
+  {
+    memoryScope_t meshMemoryScope(device, memoryCategory_t::mesh);
+    nrs->_mesh = createMesh(comm, N, cubN, nrs->cht, kernelInfo);
+  }
   nrs->meshV = (mesh_t *)nrs->_mesh->fluid;
   mesh_t *mesh = nrs->meshV;
 
@@ -584,10 +588,16 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   if (!platform->options.getArgs("RESTART FILE NAME").empty()) {
     std::string fileName;
     platform->options.getArgs("RESTART FILE NAME", fileName);
-    nek::restartFromFile(fileName);
 
     double startTime;
-    nek::copyFromNek(startTime);
+    if (fld::isCompressed(serializeString(fileName, '+').at(0)) ||
+        platform->options.compareArgs("RESTART ENGINE", "NEKRS")) {
+      nek::getIC();
+      startTime = fld::restart(nrs, fileName);
+    } else {
+      nek::restartFromFile(fileName);
+      nek::copyFromNek(startTime);
+    }
     platform->options.setArgs("START TIME", to_string_f(startTime));
   } else {
     nek::getIC();
@@ -599,7 +609,10 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   }
   fflush(stdout);
 
-  udf.setup(nrs);
+  {
+    memoryScope_t udfMemoryScope(device, memoryCategory_t::plugin);
+    udf.setup(nrs);
+  }
 
   if (platform->comm.mpiRank == 0) {
     printf("done\n");
@@ -715,6 +728,74 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 
       ellipticSolveSetup(cds->solver[is]);
     }
+
+    cds->batchIds = cdsBatchedScalars();
+    if (cds->batchIds.size()) {
+      const int Nbatch = cds->batchIds.size();
+      const std::string sid = scalarDigitStr(cds->batchIds[0]);
+      mesh_t *mesh = cds->meshV;
+
+      nrsCheck(nrs->cht && cds->batchIds[0] == 0,
+               platform->comm.mpiComm,
+               EXIT_FAILURE,
+               "%s\n",
+               "batched solve does not support a conjugate heat transfer scalar!");
+
+      for (auto &&is : cds->batchIds) {
+        for (auto &&key : {" PRECONDITIONER", " INITIAL GUESS", " SOLVER TOLERANCE", " MAXIMUM ITERATIONS"}) {
+          nrsCheck(options.getArgs("SCALAR" + sid + key) != options.getArgs("SCALAR" + scalarDigitStr(is) + key),
+                   platform->comm.mpiComm,
+                   EXIT_FAILURE,
+                   "batched scalars require identical%s!\n",
+                   key);
+        }
+      }
+
+      if (platform->comm.mpiRank == 0) {
+        std::cout << "================= ELLIPTIC SETUP SCALAR BATCH (" << Nbatch << " fields) ===============\n";
+      }
+
+      // inherits the options of the first scalar in the batch
+      auto solver = new elliptic_t();
+      solver->name = "scalar" + sid;
+      solver->Nfields = Nbatch;
+      solver->batched = true;
+      solver->fieldOffset = nrs->fieldOffset;
+      solver->loffset = nrs->fieldOffset;
+      solver->mesh = mesh;
+      solver->poisson = 0;
+
+      cds->o_batchEllipticCoeff = platform->device.malloc<dfloat>(2 * Nbatch * nrs->fieldOffset);
+      for (int fld = 0; fld < Nbatch; fld++) {
+        auto o_coeff = cds->o_batchEllipticCoeff + fld * nrs->fieldOffset;
+        cds->setEllipticCoeffKernel(mesh->Nlocal,
+                                    cds->g0 * cds->idt,
+                                    cds->fieldOffsetScan[cds->batchIds[fld]],
+                                    Nbatch * nrs->fieldOffset,
+                                    0,
+                                    cds->o_diff,
+                                    cds->o_rho,
+                                    o_NULL,
+                                    o_coeff);
+      }
+      solver->o_lambda0 = cds->o_batchEllipticCoeff.slice(0 * Nbatch * nrs->fieldOffset);
+      solver->o_lambda1 = cds->o_batchEllipticCoeff.slice(1 * Nbatch * nrs->fieldOffset);
+
+      const dlong EToBOffset = mesh->Nelements * mesh->Nfaces;
+      solver->EToB = (int *)calloc(Nbatch * EToBOffset, sizeof(int));
+      for (int fld = 0; fld < Nbatch; fld++) {
+        const std::string field = "scalar" + scalarDigitStr(cds->batchIds[fld]);
+        for (dlong e = 0; e < mesh->Nelements; e++) {
+          for (int f = 0; f < mesh->Nfaces; f++) {
+            const int bID = mesh->EToB[f + e * mesh->Nfaces];
+            solver->EToB[f + e * mesh->Nfaces + fld * EToBOffset] = bcMap::ellipticType(bID, field);
+          }
+        }
+      }
+
+      ellipticSolveSetup(solver);
+      cds->batchSolver = solver;
+    }
   }
 
   if (nrs->flow) {
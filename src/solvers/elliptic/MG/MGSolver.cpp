@@ -217,6 +217,26 @@ void MGSolver_t::runAdditiveVcycle()
   o_rhs.copyTo(Sx, Nlocal);
 
   o_x.getDevice().finish();
+
+  if (this->coarseLevel->agglomerate) {
+    for(int i = 0; i < Nlocal; i++)
+      Sx[i] *= this->coarseLevel->weight[i]; 
+    ogsGather(Gx, Sx, ogsPfloat, ogsAdd, ogs);
+
+    // all ranks (leaders included) smooth first with the rhs gather posted, the Schwarz
+    // halo exchange would otherwise wait for a leader busy in the coarse solve
+    this->coarseLevel->gatherAgglomeratedRhs(Gx);
+    schwarzSolve(this);
+    this->coarseLevel->solveAgglomerated(xBuffer);
+    this->coarseLevel->finishAgglomeratedSolve();
+
+    ogsScatter(Sx, xBuffer, ogsPfloat, ogsAdd, ogs);
+    o_x.copyFrom(Sx, Nlocal);
+
+    prolongateV(this);
+    return;
+  }
+
   #pragma omp parallel proc_bind(close) num_threads(nThreads)
   {
     #pragma omp single
@@ -28,6 +28,7 @@ SOFTWARE.
 #define MGSOLVER_HPP
 
 #include <functional>
+#include <vector>
 
 #include "nrssys.hpp"
 #include "defines.hpp"
@@ -38,6 +39,7 @@ SOFTWARE.
 #include "hypreWrapper.hpp"
 #include "hypreWrapperDevice.hpp"
 #include "AMGX.hpp"
+#include "SAAMG.hpp"
 
 class MGSolver_t {
 
@@ -100,6 +102,30 @@ public:
  
     void *boomerAMG = nullptr;
     AMGX_t *AMGX = nullptr;
+    SAAMG_t *SAAMG = nullptr;
+
+    // agglomerated coarse solve on one leader rank per node
+    bool agglomerate = false;
+    MPI_Comm nodeComm = MPI_COMM_NULL;
+    MPI_Comm agglomerateComm = MPI_COMM_NULL; // leaders only
+    std::vector<int> agglomerateCounts, agglomerateOffsets;
+    std::vector<pfloat> agglomerateRhs, agglomerateX;
+    MPI_Request agglomerateRequests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+
+    // post the rhs gather, solve on the leader and post the scatter, wait for both
+    void gatherAgglomeratedRhs(pfloat *rhs);
+    void solveAgglomerated(pfloat *x);
+    void finishAgglomeratedSolve();
+
+  private:
+    void setupAgglomeration(hlong *globalRowStarts,
+                            dlong nnz,
+                            hlong *Ai,
+                            hlong *Aj,
+                            std::vector<double> &Av,
+                            std::vector<hlong> &aggAi,
+                            std::vector<hlong> &aggAj,
+                            std::vector<double> &aggAv);
   
   };
 
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include "limits.h"
 #include "stdio.h"
+#include <algorithm>
 #include "timer.hpp"
 
 #include "AMGX.hpp"
@@ -37,6 +38,16 @@ SOFTWARE.
 
 static occa::kernel vectorDotStarKernel;
 
+namespace {
+
+struct nonZeroEntry_t {
+  hlong row;
+  hlong col;
+  double val;
+};
+
+} // namespace
+
 MGSolver_t::coarseLevel_t::coarseLevel_t(setupAide options, MPI_Comm comm)
 {
   this->options = options;
@@ -77,7 +88,29 @@ void MGSolver_t::coarseLevel_t::setupSolver(
   std::vector<double> Av(nnz);
   for(int i = 0; i < Av.size(); i++) Av[i] = Avals[i]; 
 
-  if (options.compareArgs("COARSE SOLVER", "BOOMERAMG")){
+  // solve on the leader ranks using the matrix rows of all ranks on the same node
+  MPI_Comm solverComm = comm;
+  int solverN = N;
+  std::vector<hlong> aggAi, aggAj;
+  std::vector<double> aggAv;
+  agglomerate = options.compareArgs("COARSE SOLVER AGGLOMERATE", "TRUE");
+  if (agglomerate) {
+    nrsCheck(!options.compareArgs("COARSE SOLVER", "BOOMERAMG") || useDevice, comm, EXIT_FAILURE,
+             "%s\n", "Coarse solver agglomeration requires BoomerAMG on CPU!");
+
+    setupAgglomeration(globalRowStarts, nnz, Ai, Aj, Av, aggAi, aggAj, aggAv);
+    solverComm = agglomerateComm;
+    solverN = agglomerateRhs.size();
+    nnz = aggAv.size();
+    Ai = aggAi.data();
+    Aj = aggAj.data();
+    Av.swap(aggAv);
+  }
+
+  if (agglomerate && agglomerateComm == MPI_COMM_NULL) {
+    // nothing to setup, non-leader ranks just send their rhs
+  }
+  else if (options.compareArgs("COARSE SOLVER", "BOOMERAMG")){
  
     double settings[hypreWrapperDevice::NPARAM+1];
     settings[0]  = 1;    /* custom settings              */
@@ -124,13 +157,13 @@ void MGSolver_t::coarseLevel_t::setupSolver(
     } else {
       const int Nthreads = 1;
       boomerAMG = new hypreWrapper::boomerAMG_t(
-        N,
+        solverN,
         nnz,
         Ai,
         Aj,
         Av.data(),
         (int) nullSpace,
-        comm,
+        solverComm,
         Nthreads,
         useFP32,
         settings,
@@ -154,6 +187,17 @@ void MGSolver_t::coarseLevel_t::setupSolver(
       useFP32,
       std::stoi(getenv("NEKRS_GPU_MPI")),
       cfg);
+  }
+  else if (options.compareArgs("COARSE SOLVER", "SAAMG")){
+    SAAMG = new SAAMG_t(
+      N,
+      nnz,
+      Ai,
+      Aj,
+      Av.data(),
+      (int) nullSpace,
+      comm,
+      verbose);
   } else {
     std::string amgSolver;
     options.getArgs("COARSE SOLVER", amgSolver);
@@ -175,6 +219,10 @@ MGSolver_t::coarseLevel_t::~coarseLevel_t()
       delete (hypreWrapper::boomerAMG_t*) this->boomerAMG;
   }
   if(AMGX) delete AMGX;
+  if(SAAMG) delete SAAMG;
+
+  if(agglomerateComm != MPI_COMM_NULL) MPI_Comm_free(&agglomerateComm);
+  if(nodeComm != MPI_COMM_NULL) MPI_Comm_free(&nodeComm);
 
   h_xBuffer.free();
   o_xBuffer.free();
@@ -205,12 +253,19 @@ void MGSolver_t::coarseLevel_t::solve(occa::memory& o_rhs, occa::memory& o_x)
       if(useDevice) {
         auto boomerAMG = (hypreWrapperDevice::boomerAMG_t*) this->boomerAMG;
         boomerAMG->solve(o_Gx, o_xBuffer);
+      } else if (agglomerate) {
+        gatherAgglomeratedRhs(Gx);
+        solveAgglomerated(xBuffer);
+        finishAgglomeratedSolve();
       } else {
         auto boomerAMG = (hypreWrapper::boomerAMG_t*) this->boomerAMG;
         boomerAMG->solve(Gx, xBuffer); 
       }
     } else if (options.compareArgs("COARSE SOLVER", "AMGX")){
         AMGX->solve(o_Gx.ptr(), o_xBuffer.ptr());
+    } else if (options.compareArgs("COARSE SOLVER", "SAAMG")){
+        SAAMG->solve(o_Gx, o_xBuffer);
+        if(!useDevice) o_xBuffer.copyTo(xBuffer, N);
     }
 
     // T->E
@@ -225,3 +280,109 @@ void MGSolver_t::coarseLevel_t::solve(occa::memory& o_rhs, occa::memory& o_x)
 
   platform->timer.toc("coarseSolve");
 }
+
+void MGSolver_t::coarseLevel_t::setupAgglomeration(hlong *globalRowStarts,
+                                                   dlong nnz,
+                                                   hlong *Ai,
+                                                   hlong *Aj,
+                                                   std::vector<double> &Av,
+                                                   std::vector<hlong> &aggAi,
+                                                   std::vector<hlong> &aggAj,
+                                                   std::vector<double> &aggAv)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+  int nodeRank, nodeSize;
+  MPI_Comm_rank(nodeComm, &nodeRank);
+  MPI_Comm_size(nodeComm, &nodeSize);
+
+  const bool leader = (nodeRank == 0);
+  MPI_Comm_split(comm, leader ? 0 : MPI_UNDEFINED, rank, &agglomerateComm);
+
+  // renumber rows such that all rows of a node are contiguous (ordered by leader, then rank)
+  int leaderRank = rank;
+  MPI_Bcast(&leaderRank, 1, MPI_INT, 0, nodeComm);
+  std::vector<int> leaderOfRank(size);
+  MPI_Allgather(&leaderRank, 1, MPI_INT, leaderOfRank.data(), 1, MPI_INT, comm);
+
+  std::vector<int> order(size);
+  for (int r = 0; r < size; r++) order[r] = r;
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return leaderOfRank[a] < leaderOfRank[b]; });
+
+  std::vector<hlong> newRowStarts(size);
+  hlong offset = 0;
+  for (auto &&r : order) {
+    newRowStarts[r] = offset;
+    offset += globalRowStarts[r + 1] - globalRowStarts[r];
+  }
+
+  auto renumber = [&](hlong id) {
+    const int r = std::upper_bound(globalRowStarts, globalRowStarts + size + 1, id) - globalRowStarts - 1;
+    return newRowStarts[r] + (id - globalRowStarts[r]);
+  };
+
+  std::vector<nonZeroEntry_t> entries(nnz);
+  for (dlong i = 0; i < nnz; i++) entries[i] = {renumber(Ai[i]), renumber(Aj[i]), Av[i]};
+
+  // gather rows and entries on the leader
+  agglomerateCounts.resize(nodeSize);
+  agglomerateOffsets.resize(nodeSize + 1);
+  MPI_Gather(&N, 1, MPI_INT, agglomerateCounts.data(), 1, MPI_INT, 0, nodeComm);
+  agglomerateOffsets[0] = 0;
+  for (int r = 0; r < nodeSize; r++) agglomerateOffsets[r + 1] = agglomerateOffsets[r] + agglomerateCounts[r];
+
+  int nBytes = entries.size() * sizeof(nonZeroEntry_t);
+  std::vector<int> byteCounts(nodeSize), byteOffsets(nodeSize + 1, 0);
+  MPI_Gather(&nBytes, 1, MPI_INT, byteCounts.data(), 1, MPI_INT, 0, nodeComm);
+  for (int r = 0; r < nodeSize; r++) byteOffsets[r + 1] = byteOffsets[r] + byteCounts[r];
+
+  std::vector<nonZeroEntry_t> nodeEntries(leader ? byteOffsets[nodeSize] / sizeof(nonZeroEntry_t) : 0);
+  MPI_Gatherv(entries.data(), nBytes, MPI_BYTE,
+              nodeEntries.data(), byteCounts.data(), byteOffsets.data(), MPI_BYTE, 0, nodeComm);
+
+  if (leader) {
+    std::sort(nodeEntries.begin(), nodeEntries.end(),
+              [](const nonZeroEntry_t &a, const nonZeroEntry_t &b) { return a.row < b.row; });
+    for (auto &&e : nodeEntries) {
+      aggAi.push_back(e.row);
+      aggAj.push_back(e.col);
+      aggAv.push_back(e.val);
+    }
+    agglomerateRhs.resize(agglomerateOffsets[nodeSize]);
+    agglomerateX.resize(agglomerateOffsets[nodeSize]);
+  }
+
+  int nLeaders = leader;
+  MPI_Allreduce(MPI_IN_PLACE, &nLeaders, 1, MPI_INT, MPI_SUM, comm);
+  if (rank == 0) printf("agglomerating coarse solve onto %d rank(s) ... ", nLeaders);
+}
+
+void MGSolver_t::coarseLevel_t::gatherAgglomeratedRhs(pfloat *rhs)
+{
+  MPI_Igatherv(rhs, N, MPI_PFLOAT,
+               agglomerateRhs.data(), agglomerateCounts.data(), agglomerateOffsets.data(), MPI_PFLOAT,
+               0, nodeComm, &agglomerateRequests[0]);
+}
+
+// the leader waits for the rhs and solves, non-leaders only post the scatter
+void MGSolver_t::coarseLevel_t::solveAgglomerated(pfloat *x)
+{
+  if (agglomerateComm != MPI_COMM_NULL) {
+    MPI_Wait(&agglomerateRequests[0], MPI_STATUS_IGNORE);
+    std::fill(agglomerateX.begin(), agglomerateX.end(), 0);
+    auto boomerAMG = (hypreWrapper::boomerAMG_t*) this->boomerAMG;
+    boomerAMG->solve(agglomerateRhs.data(), agglomerateX.data());
+  }
+
+  MPI_Iscatterv(agglomerateX.data(), agglomerateCounts.data(), agglomerateOffsets.data(), MPI_PFLOAT,
+                x, N, MPI_PFLOAT,
+                0, nodeComm, &agglomerateRequests[1]);
+}
+
+void MGSolver_t::coarseLevel_t::finishAgglomeratedSolve()
+{
+  MPI_Waitall(2, agglomerateRequests, MPI_STATUSES_IGNORE);
+}
@@ -502,10 +502,10 @@ void ellipticBuildFEMGalerkinHex3D(elliptic_t* elliptic,
   free(b);
   free(q);
   free(Aq);
-  o_q.free();
-  o_qPfloat.free();
-  o_Aq.free();
-  o_AqPfloat.free();
+  platform->device.free(o_q);
+  platform->device.free(o_qPfloat);
+  platform->device.free(o_Aq);
+  platform->device.free(o_AqPfloat);
 
   // Make the MPI_NONZERO_T data type
   MPI_Datatype MPI_NONZERO_T;
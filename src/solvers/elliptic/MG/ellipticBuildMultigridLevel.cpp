@@ -51,6 +51,7 @@ elliptic_t* ellipticBuildMultigridLevel(elliptic_t* fineElliptic, int Nc, int Nf
   memcpy(elliptic,fineElliptic,sizeof(elliptic_t));
 
   elliptic->mgLevel = true;
+  elliptic->cubatureAx = false;
 
   mesh_t* mesh = createMeshMG(fineElliptic->mesh, Nc);
   elliptic->mesh = mesh;
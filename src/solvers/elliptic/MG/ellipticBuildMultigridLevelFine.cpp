@@ -52,6 +52,7 @@ elliptic_t* ellipticBuildMultigridLevelFine(elliptic_t* baseElliptic)
   elliptic->mesh = mesh;
 
   elliptic->mgLevel = true;
+  elliptic->cubatureAx = false;
 
   ellipticBuildPreconditionerKernels(elliptic);
 
@@ -86,11 +86,11 @@ void pMGLevel::prolongate(occa::memory o_x, occa::memory o_Px)
 
 void pMGLevel::smooth(occa::memory o_rhs, occa::memory o_x, bool x_is_zero)
 {
-  platform->timer.tic(elliptic->name + " preconditioner smoother N=" + std::to_string(mesh->N), 1);
-
   if(!x_is_zero && smootherType == SmootherType::ASM) return;
   if(!x_is_zero && smootherType == SmootherType::RAS) return;
 
+  platform->timer.tic(elliptic->name + " preconditioner smoother N=" + std::to_string(mesh->N), 1);
+
   if (smootherType == SmootherType::CHEBYSHEV)
     this->smoothChebyshev(o_rhs, o_x, x_is_zero);
   else if (smootherType == SmootherType::OPT_FOURTH_CHEBYSHEV || smootherType == SmootherType::FOURTH_CHEBYSHEV)
@@ -170,25 +170,37 @@ void pMGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZe
     platform->linAlg->pfill(Nrows, zero, o_x);
   }
 
-  // res = S(r-Ax)
-  if (!xIsZero) {
-    this->Ax(o_x,o_res);
-    platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
-    flopCount += 2 * Nrows;
+  // Jacobi scaling needs the assembled Ax, fuse it into the vector updates following the operator
+  const bool fuseJacobi = (chebySmootherType == ChebyshevSmootherType::JACOBI);
+
+  if (fuseJacobi) {
+    // res = S(r-Ax), d = invTheta*res
+    if (!xIsZero)
+      this->Ax(o_x, o_res);
+    elliptic->initJacobiChebyshevKernel(Nrows, static_cast<int>(xIsZero), 1, invTheta, o_invDiagA, o_r, o_res, o_d);
+    flopCount += 3 * Nrows;
   } else {
-    o_res.copyFrom(o_r, Nrows);
+    // res = S(r-Ax)
+    if (!xIsZero) {
+      this->Ax(o_x, o_res);
+      platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
+      flopCount += 2 * Nrows;
+    } else {
+      o_res.copyFrom(o_r, Nrows);
+    }
+    this->smoother(o_res, o_res, xIsZero);
+
+    // d = invTheta*res
+    platform->linAlg->paxpby(Nrows, invTheta, o_res, zero, o_d);
+    flopCount += Nrows;
   }
-  this->smoother(o_res, o_res, xIsZero);
-
-  // d = invTheta*res
-  platform->linAlg->paxpby(Nrows, invTheta, o_res, zero, o_d);
-  flopCount += Nrows;
 
   for (int k = 1; k < ChebyshevDegree; k++) {
 
     // SAd_k
     this->Ax(o_d,o_Ad);
-    this->smoother(o_Ad, o_Ad, xIsZero);
+    if (!fuseJacobi)
+      this->smoother(o_Ad, o_Ad, xIsZero);
 
     // x_k+1 = x_k + d_k
     // r_k+1 = r_k - SAd_k
@@ -200,9 +212,13 @@ void pMGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZe
     const pfloat rCoeff = 2.0 * rho_n / delta;
     const pfloat dCoeff = rho_n * rhoSave;
 
-    elliptic->updateChebyshevKernel(Nrows, dCoeff, rCoeff, o_Ad, o_d, o_res, o_x);
-
-    flopCount += 5 * Nrows;
+    if (fuseJacobi) {
+      elliptic->updateJacobiChebyshevKernel(Nrows, dCoeff, rCoeff, o_invDiagA, o_Ad, o_d, o_res, o_x);
+      flopCount += 6 * Nrows;
+    } else {
+      elliptic->updateChebyshevKernel(Nrows, dCoeff, rCoeff, o_Ad, o_d, o_res, o_x);
+      flopCount += 5 * Nrows;
+    }
   }
   //x_k+1 = x_k + d_k
   platform->linAlg->paxpby(Nrows, one, o_d, one, o_x);
@@ -233,36 +249,64 @@ void pMGLevel::smoothFourthKindChebyshev (occa::memory &o_r, occa::memory &o_x,
 
   double flopCount = 0.0;
 
-  // r = b - Ax
-  if (xIsZero) {
+  const pfloat coeff = 4.0 / (3.0 * rho);
+
+  // Jacobi scaling needs the assembled Ax, fuse it into the vector updates following the operator
+  const bool fuseJacobi = (chebySmootherType == ChebyshevSmootherType::JACOBI);
+
+  if (xIsZero)
     platform->linAlg->pfill(Nrows, zero, o_x);
-    o_res.copyFrom(o_r, Nrows);
-  }
-  else {
-    this->Ax(o_x,o_res);
-    platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
-    flopCount += Nrows;
-  }
 
-  // d = \dfrac{4}{3} \dfrac{1}{\rho(SA)} Sr
-  this->smoother(o_res, o_Ad, xIsZero);
-  const pfloat coeff = 4.0 / (3.0 * rho);
-  platform->linAlg->paxpby(Nrows, coeff, o_Ad, zero, o_d);
+  if (fuseJacobi) {
+    // r = b - Ax, d = \dfrac{4}{3} \dfrac{1}{\rho(SA)} Sr
+    if (!xIsZero)
+      this->Ax(o_x, o_res);
+    elliptic->initJacobiChebyshevKernel(Nrows, static_cast<int>(xIsZero), 0, coeff, o_invDiagA, o_r, o_res, o_d);
+    flopCount += 3 * Nrows;
+  } else {
+    // r = b - Ax
+    if (xIsZero) {
+      o_res.copyFrom(o_r, Nrows);
+    } else {
+      this->Ax(o_x, o_res);
+      platform->linAlg->paxpby(Nrows, one, o_r, mone, o_res);
+      flopCount += Nrows;
+    }
+
+    // d = \dfrac{4}{3} \dfrac{1}{\rho(SA)} Sr
+    this->smoother(o_res, o_Ad, xIsZero);
+    platform->linAlg->paxpby(Nrows, coeff, o_Ad, zero, o_d);
+  }
 
   for (int k = 1; k < ChebyshevDegree; k++) {
 
     // Ad_k
     this->Ax(o_d, o_Ad);
 
+    // d_k+1 = \dfrac{2k-1}{2k+3} d_k + \dfrac{8k+4}{2k+3} \dfrac{1}{\rho(SA)} S r_k+1
+    const pfloat dCoeff = (2.0 * k - 1.0) / (2.0 * k + 3.0);
+    const pfloat rCoeff = (8.0 * k + 4.0) / ((2.0 * k + 3.0) * rho);
+
+    if (fuseJacobi) {
+      elliptic->updateJacobiFourthKindChebyshevKernel(Nrows,
+                                                      betas[k - 1],
+                                                      dCoeff,
+                                                      rCoeff,
+                                                      o_invDiagA,
+                                                      o_Ad,
+                                                      o_d,
+                                                      o_res,
+                                                      o_x);
+      flopCount += 7 * Nrows;
+      continue;
+    }
+
     // x_k+1 = x_k + \beta_k d_k
     // r_k+1 = r_k - Ad_k
     elliptic->updateFourthKindChebyshevKernel(Nrows, betas[k - 1], o_Ad, o_d, o_res, o_x);
 
     this->smoother(o_res, o_Ad, xIsZero);
 
-    // d_k+1 = \dfrac{2k-1}{2k+3} d_k + \dfrac{8k+4}{2k+3} \dfrac{1}{\rho(SA)} S r_k+1
-    const pfloat dCoeff = (2.0 * k - 1.0) / (2.0 * k + 3.0);
-    const pfloat rCoeff = (8.0 * k + 4.0) / ((2.0 * k + 3.0) * rho);
     platform->linAlg->paxpby(Nrows, rCoeff, o_Ad, dCoeff, o_d);
   }
 
@@ -37,6 +37,7 @@
 #include <array>
 
 #include "platform.hpp"
+#include "halfPrecision.hpp"
 
 struct ElementLengths {
   dfloat *length_left_x;
@@ -868,6 +869,40 @@ void pMGLevel::build(elliptic_t *pSolver)
   }
   for (dlong i = 0; i < Np_e * Nelements; ++i)
     casted_D[i] = static_cast<pfloat>(op->D[i]);
+
+  int fdmStorage = 0;
+  if (options.compareArgs("MULTIGRID SCHWARZ STORAGE", "FP16"))
+    fdmStorage = 1;
+  else if (options.compareArgs("MULTIGRID SCHWARZ STORAGE", "BF16"))
+    fdmStorage = 2;
+
+  // 16-bit operator storage: normalize the inverse eigenvalues of each element by their max s_e and
+  // fold s_e^(1/6) into the six 1D eigenvector applications to keep the data within the FP16 range
+  std::vector<uint16_t> Sx16, Sy16, Sz16, D16;
+  if (fdmStorage) {
+    auto convert = [&](double v) { return (fdmStorage == 1) ? floatToHalf(v) : floatToBfloat16(v); };
+    Sx16.resize(Nq_e * Nq_e * Nelements);
+    Sy16.resize(Nq_e * Nq_e * Nelements);
+    Sz16.resize(Nq_e * Nq_e * Nelements);
+    D16.resize(Np_e * Nelements);
+    for (dlong e = 0; e < Nelements; ++e) {
+      double s = 0;
+      for (int i = 0; i < Np_e; ++i)
+        s = std::max(s, std::abs(static_cast<double>(op->D[i + e * Np_e])));
+      if (s == 0)
+        s = 1;
+      const double c = std::pow(s, 1.0 / 6.0);
+      for (int i = 0; i < Nq_e * Nq_e; ++i) {
+        const dlong id = i + e * Nq_e * Nq_e;
+        Sx16[id] = convert(c * op->Sx[id]);
+        Sy16[id] = convert(c * op->Sy[id]);
+        Sz16[id] = convert(c * op->Sz[id]);
+      }
+      for (int i = 0; i < Np_e; ++i)
+        D16[i + e * Np_e] = convert(op->D[i + e * Np_e] / s);
+    }
+  }
+
   free(op->Sx);
   free(op->Sy);
   free(op->Sz);
@@ -886,20 +921,32 @@ void pMGLevel::build(elliptic_t *pSolver)
 
   const dlong weightSize = Np * Nelements;
   o_wts = platform->device.malloc<pfloat>(weightSize);
-  o_Sx = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
-  o_Sy = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
-  o_Sz = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
-  o_invL = platform->device.malloc<pfloat>(Nlocal_e);
+  if (fdmStorage) {
+    o_Sx = platform->device.malloc(Sx16.size() * sizeof(uint16_t), Sx16.data());
+    o_Sy = platform->device.malloc(Sy16.size() * sizeof(uint16_t), Sy16.data());
+    o_Sz = platform->device.malloc(Sz16.size() * sizeof(uint16_t), Sz16.data());
+    o_invL = platform->device.malloc(D16.size() * sizeof(uint16_t), D16.data());
+  }
+  else {
+    o_Sx = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
+    o_Sy = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
+    o_Sz = platform->device.malloc<pfloat>(Nq_e * Nq_e * Nelements);
+    o_invL = platform->device.malloc<pfloat>(Nlocal_e);
+    o_Sx.copyFrom(casted_Sx, Nq_e * Nq_e * Nelements);
+    o_Sy.copyFrom(casted_Sy, Nq_e * Nq_e * Nelements);
+    o_Sz.copyFrom(casted_Sz, Nq_e * Nq_e * Nelements);
+    o_invL.copyFrom(casted_D, Nlocal_e);
+  }
   o_work1 = platform->device.malloc<pfloat>(Nlocal_e);
   if (!options.compareArgs("MULTIGRID SMOOTHER", "RAS"))
     o_work2 = platform->device.malloc<pfloat>(Nlocal_e);
-  o_Sx.copyFrom(casted_Sx, Nq_e * Nq_e * Nelements);
-  o_Sy.copyFrom(casted_Sy, Nq_e * Nq_e * Nelements);
-  o_Sz.copyFrom(casted_Sz, Nq_e * Nq_e * Nelements);
-  o_invL.copyFrom(casted_D, Nlocal_e);
 
   {
-    const std::string suffix = std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat");
+    std::string storageSuffix;
+    if (fdmStorage)
+      storageSuffix = (fdmStorage == 1) ? "FP16" : "BF16";
+    const std::string suffix =
+        std::string("_") + std::to_string(Nq_e - 1) + std::string("pfloat") + storageSuffix;
     preFDMKernel = platform->kernels.get("preFDM" + suffix);
     fusedFDMKernel = platform->kernels.get("fusedFDM" + suffix);
     postFDMKernel = platform->kernels.get("postFDM" + suffix);
@@ -1012,8 +1059,8 @@ void pMGLevel::build(elliptic_t *pSolver)
         }
       }
 
-      o_u.free();
-      o_Su.free();
+      platform->device.free(o_u);
+      platform->device.free(o_Su);
 
       if (platform->comm.mpiRank == 0) {
         printf("testing overlap in smoothSchwarz: %.2es %.2es ", nonOverlappedTime, overlappedTime);
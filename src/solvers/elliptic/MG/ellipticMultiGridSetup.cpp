@@ -44,15 +44,15 @@ void pMGLevelAllocateStorage(pMGLevel *level, int k)
   const size_t N = level->Ncols;
 
   if (pMGLevel::o_smootherResidual.length() < N) {
-    pMGLevel::o_smootherResidual.free();
+    platform->device.free(pMGLevel::o_smootherResidual);
     pMGLevel::o_smootherResidual = platform->device.malloc<pfloat>(N);
   }
   if (pMGLevel::o_smootherResidual2.length() < N) {
-    pMGLevel::o_smootherResidual2.free();
+    platform->device.free(pMGLevel::o_smootherResidual2);
     pMGLevel::o_smootherResidual2 = platform->device.malloc<pfloat>(N);
   }
   if (pMGLevel::o_smootherUpdate.length() < N) {
-    pMGLevel::o_smootherUpdate.free();
+    platform->device.free(pMGLevel::o_smootherUpdate);
     pMGLevel::o_smootherUpdate = platform->device.malloc<pfloat>(N);
   }
 }
@@ -63,6 +63,8 @@ void ellipticMultiGridSetup(elliptic_t *elliptic_, precon_t *precon_)
     printf("building MG preconditioner ... \n");
   fflush(stdout);
 
+  memoryScope_t memoryScope(platform->device, memoryCategory_t::multigrid);
+
   precon_t *precon = precon_;
   // setup new object from fine grid but with constant coeff
   elliptic_t *elliptic = ellipticBuildMultigridLevelFine(elliptic_);
@@ -147,6 +147,17 @@ SEMFEMSolver_t::SEMFEMSolver_t(elliptic_t* elliptic_)
       std::stoi(getenv("NEKRS_GPU_MPI")),
       cfg);
   }
+  else if(elliptic->options.compareArgs("COARSE SOLVER", "SAAMG")){
+    SAAMG = new SAAMG_t(
+      numRows,
+      matrix->nnz,
+      matrix->Ai,
+      matrix->Aj,
+      matrix->Av,
+      (int) elliptic->allNeumann,
+      platform->comm.mpiComm,
+      verbose);
+  }
   else {
     std::string amgSolver;
     elliptic->options.getArgs("COARSE SOLVER", amgSolver);
@@ -168,6 +179,7 @@ SEMFEMSolver_t::~SEMFEMSolver_t()
       delete (hypreWrapper::boomerAMG_t*) this->boomerAMG;
   }
   if(AMGX) delete AMGX;
+  if(SAAMG) delete SAAMG;
 
   o_dofMap.free();
   o_SEMFEMBuffer1.free();
@@ -211,6 +223,10 @@ void SEMFEMSolver_t::run(occa::memory& o_r, occa::memory& o_z)
 
     AMGX->solve(o_bufr.ptr(), o_bufz.ptr());
 
+  } else if(elliptic->options.compareArgs("COARSE SOLVER", "SAAMG")){
+
+    SAAMG->solve(o_bufr, o_bufz);
+
   } else {
 
     nrsAbort(platform->comm.mpiComm, EXIT_FAILURE,
@@ -0,0 +1,816 @@
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <map>
+#include <unordered_map>
+
+#include "platform.hpp"
+#include "linAlg.hpp"
+#include "SAAMG.hpp"
+
+extern "C" {
+void dgetrf_(int *M, int *N, double *A, int *lda, int *IPIV, int *INFO);
+void dgetri_(int *N, double *A, int *lda, int *IPIV, double *WORK, int *lwork, int *INFO);
+}
+
+static occa::kernel spmvKernel;
+static occa::kernel residualKernel;
+static occa::kernel chebyshevUpdateKernel;
+static occa::kernel gatherKernel;
+
+namespace {
+
+constexpr int maxLevels = 20;
+// the dense inverse is replicated on every rank
+constexpr int maxDenseRows = 2000;
+
+struct entry_t {
+  hlong row;
+  hlong col;
+  double val;
+};
+
+// local rows of a distributed matrix in CSR format with global column ids
+struct hostMatrix_t {
+  hlong rowStart = 0;
+  dlong nRows = 0;
+  std::vector<dlong> rowPtr;
+  std::vector<hlong> cols;
+  std::vector<double> vals;
+};
+
+int owner(const std::vector<hlong> &starts, hlong id)
+{
+  return std::upper_bound(starts.begin(), starts.end(), id) - starts.begin() - 1;
+}
+
+std::vector<hlong> partitionStarts(dlong nLocal, MPI_Comm comm)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+  hlong n = nLocal;
+  std::vector<hlong> counts(size);
+  MPI_Allgather(&n, 1, MPI_HLONG, counts.data(), 1, MPI_HLONG, comm);
+  std::vector<hlong> starts(size + 1, 0);
+  for (int r = 0; r < size; ++r)
+    starts[r + 1] = starts[r] + counts[r];
+  return starts;
+}
+
+// opaque contiguous MPI type of T, counts and displacements are in elements of T
+template <typename T> MPI_Datatype mpiType()
+{
+  MPI_Datatype type;
+  MPI_Type_contiguous(sizeof(T), MPI_BYTE, &type);
+  MPI_Type_commit(&type);
+  return type;
+}
+
+// exclusive prefix sum of counts, aborts if a displacement does not fit into an int
+std::vector<int> displacements(const std::vector<int> &counts, MPI_Comm comm)
+{
+  std::vector<int> displs(counts.size() + 1, 0);
+  long long total = 0;
+  for (size_t r = 0; r < counts.size(); ++r) {
+    total += counts[r];
+    displs[r + 1] = (total > INT_MAX) ? INT_MAX : total;
+  }
+  nrsCheck(total > INT_MAX, comm, EXIT_FAILURE, "message of %lld entries exceeds INT_MAX!\n", total);
+  return displs;
+}
+
+template <typename T> std::vector<std::vector<T>> alltoallv(const std::vector<std::vector<T>> &send, MPI_Comm comm)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<int> sendCounts(size), recvCounts(size);
+  for (int r = 0; r < size; ++r) {
+    nrsCheck(send[r].size() > INT_MAX, MPI_COMM_SELF, EXIT_FAILURE, "%s\n", "send count exceeds INT_MAX!");
+    sendCounts[r] = send[r].size();
+  }
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+  const auto sendDispls = displacements(sendCounts, comm);
+  const auto recvDispls = displacements(recvCounts, comm);
+
+  std::vector<T> sendBuf(sendDispls[size]);
+  for (int r = 0; r < size; ++r)
+    std::copy(send[r].begin(), send[r].end(), sendBuf.begin() + sendDispls[r]);
+  std::vector<T> recvBuf(recvDispls[size]);
+
+  auto type = mpiType<T>();
+  MPI_Alltoallv(sendBuf.data(),
+                sendCounts.data(),
+                sendDispls.data(),
+                type,
+                recvBuf.data(),
+                recvCounts.data(),
+                recvDispls.data(),
+                type,
+                comm);
+  MPI_Type_free(&type);
+
+  std::vector<std::vector<T>> recv(size);
+  for (int r = 0; r < size; ++r)
+    recv[r].assign(recvBuf.begin() + recvDispls[r], recvBuf.begin() + recvDispls[r + 1]);
+  return recv;
+}
+
+// sort by (row,col) and sum duplicates
+void compress(std::vector<entry_t> &a)
+{
+  std::sort(a.begin(), a.end(), [](const entry_t &x, const entry_t &y) {
+    return (x.row < y.row) || (x.row == y.row && x.col < y.col);
+  });
+  size_t n = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (n > 0 && a[n - 1].row == a[i].row && a[n - 1].col == a[i].col)
+      a[n - 1].val += a[i].val;
+    else
+      a[n++] = a[i];
+  }
+  a.resize(n);
+}
+
+// send entries to the owner of their row
+hostMatrix_t assemble(std::vector<entry_t> &entries, const std::vector<hlong> &rowStarts, MPI_Comm comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  compress(entries);
+  std::vector<std::vector<entry_t>> send(size);
+  for (auto &&e : entries)
+    send[owner(rowStarts, e.row)].push_back(e);
+  entries.clear();
+
+  auto recv = alltoallv(send, comm);
+  std::vector<entry_t> local;
+  for (auto &&r : recv)
+    local.insert(local.end(), r.begin(), r.end());
+  compress(local);
+
+  hostMatrix_t A;
+  A.rowStart = rowStarts[rank];
+  A.nRows = rowStarts[rank + 1] - rowStarts[rank];
+  A.rowPtr.assign(A.nRows + 1, 0);
+  for (auto &&e : local) {
+    A.rowPtr[e.row - A.rowStart + 1]++;
+    A.cols.push_back(e.col);
+    A.vals.push_back(e.val);
+  }
+  for (dlong i = 0; i < A.nRows; ++i)
+    A.rowPtr[i + 1] += A.rowPtr[i];
+  return A;
+}
+
+// sorted unique column ids outside of [colStart, colEnd)
+std::vector<hlong> ghostColumns(const hostMatrix_t &A, hlong colStart, hlong colEnd)
+{
+  std::vector<hlong> ghosts;
+  for (auto &&c : A.cols)
+    if (c < colStart || c >= colEnd)
+      ghosts.push_back(c);
+  std::sort(ghosts.begin(), ghosts.end());
+  ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+  return ghosts;
+}
+
+// rows of a distributed matrix owned by other ranks, indexed by global row id
+struct remoteRows_t {
+  std::unordered_map<hlong, std::pair<size_t, size_t>> range;
+  std::vector<entry_t> entries;
+};
+
+remoteRows_t fetchRows(const hostMatrix_t &A, const std::vector<hlong> &rowStarts, const std::vector<hlong> &ids, MPI_Comm comm)
+{
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<std::vector<hlong>> request(size);
+  for (auto &&id : ids)
+    request[owner(rowStarts, id)].push_back(id);
+  auto incoming = alltoallv(request, comm);
+
+  std::vector<std::vector<entry_t>> reply(size);
+  for (int r = 0; r < size; ++r) {
+    for (auto &&id : incoming[r]) {
+      const dlong i = id - A.rowStart;
+      for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+        reply[r].push_back({id, A.cols[k], A.vals[k]});
+    }
+  }
+  auto recv = alltoallv(reply, comm);
+
+  remoteRows_t rows;
+  for (auto &&r : recv)
+    rows.entries.insert(rows.entries.end(), r.begin(), r.end());
+  for (size_t k = 0; k < rows.entries.size();) {
+    size_t end = k;
+    while (end < rows.entries.size() && rows.entries[end].row == rows.entries[k].row)
+      end++;
+    rows.range[rows.entries[k].row] = {k, end};
+    k = end;
+  }
+  return rows;
+}
+
+// calls f(col, val) for each entry of global row id, either local or fetched
+template <typename F> void forEachInRow(const hostMatrix_t &A, const remoteRows_t &remote, hlong id, F f)
+{
+  if (id >= A.rowStart && id < A.rowStart + A.nRows) {
+    const dlong i = id - A.rowStart;
+    for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+      f(A.cols[k], A.vals[k]);
+  } else {
+    auto it = remote.range.find(id);
+    if (it == remote.range.end())
+      return;
+    for (size_t k = it->second.first; k < it->second.second; ++k)
+      f(remote.entries[k].col, remote.entries[k].val);
+  }
+}
+
+std::vector<double> diagonal(const hostMatrix_t &A)
+{
+  std::vector<double> d(A.nRows, 0);
+  for (dlong i = 0; i < A.nRows; ++i)
+    for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+      if (A.cols[k] == A.rowStart + i)
+        d[i] = A.vals[k];
+  return d;
+}
+
+// Gershgorin bound of the spectral radius of D^{-1}A
+double lambdaMaxBound(const hostMatrix_t &A, const std::vector<double> &d, MPI_Comm comm)
+{
+  double lambda = 0;
+  for (dlong i = 0; i < A.nRows; ++i) {
+    double sum = 0;
+    for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+      sum += std::abs(A.vals[k]);
+    if (d[i] != 0)
+      lambda = std::max(lambda, sum / std::abs(d[i]));
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &lambda, 1, MPI_DOUBLE, MPI_MAX, comm);
+  return (lambda > 0) ? lambda : 1;
+}
+
+// rank local greedy aggregation based on strong connections |a_ij| >= theta sqrt(|a_ii a_jj|)
+// rows without strong connections stay unaggregated (-1)
+std::vector<dlong> aggregate(const hostMatrix_t &A, const std::vector<double> &d, double theta, dlong &nAgg)
+{
+  const dlong n = A.nRows;
+  std::vector<std::vector<dlong>> strong(n);
+  for (dlong i = 0; i < n; ++i) {
+    for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+      const hlong j = A.cols[k] - A.rowStart;
+      if (j < 0 || j >= n || j == i)
+        continue;
+      if (std::abs(A.vals[k]) >= theta * std::sqrt(std::abs(d[i] * d[j])))
+        strong[i].push_back(j);
+    }
+  }
+
+  std::vector<dlong> agg(n, -1);
+  nAgg = 0;
+
+  // phase 1: disjoint root neighborhoods
+  for (dlong i = 0; i < n; ++i) {
+    if (agg[i] >= 0 || strong[i].empty())
+      continue;
+    bool free = true;
+    for (auto &&j : strong[i])
+      free &= (agg[j] < 0);
+    if (!free)
+      continue;
+    agg[i] = nAgg;
+    for (auto &&j : strong[i])
+      agg[j] = nAgg;
+    nAgg++;
+  }
+
+  // phase 2: attach to a neighboring phase 1 aggregate
+  auto phase1 = agg;
+  for (dlong i = 0; i < n; ++i) {
+    if (agg[i] >= 0)
+      continue;
+    for (auto &&j : strong[i]) {
+      if (phase1[j] >= 0) {
+        agg[i] = phase1[j];
+        break;
+      }
+    }
+  }
+
+  // phase 3: aggregate the leftovers with their unaggregated neighbors
+  for (dlong i = 0; i < n; ++i) {
+    if (agg[i] >= 0 || strong[i].empty())
+      continue;
+    agg[i] = nAgg;
+    for (auto &&j : strong[i])
+      if (agg[j] < 0)
+        agg[j] = nAgg;
+    nAgg++;
+  }
+
+  return agg;
+}
+
+hostMatrix_t transpose(const hostMatrix_t &A, const std::vector<hlong> &colStarts, MPI_Comm comm)
+{
+  std::vector<entry_t> entries;
+  for (dlong i = 0; i < A.nRows; ++i)
+    for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+      entries.push_back({A.cols[k], A.rowStart + i, A.vals[k]});
+  return assemble(entries, colStarts, comm);
+}
+
+} // namespace
+
+const occa::memory &SAAMG_t::matrix_t::haloExchange(const occa::memory &o_x, MPI_Comm comm)
+{
+  if (nGhosts == 0 && sendRanks.empty())
+    return o_x;
+
+  if (nCols)
+    o_xHalo.copyFrom(o_x, nCols);
+
+  const dlong nSend = o_sendIds.isInitialized() ? sendOffsets.back() : 0;
+  if (nSend) {
+    gatherKernel(nSend, o_sendIds, o_x, o_sendBuffer);
+    o_sendBuffer.copyTo(h_sendBuffer, nSend);
+  }
+
+  auto sendBuf = (pfloat *)h_sendBuffer.ptr();
+  auto recvBuf = (pfloat *)h_recvBuffer.ptr();
+
+  std::vector<MPI_Request> requests(recvRanks.size() + sendRanks.size());
+  int nRequests = 0;
+  for (size_t r = 0; r < recvRanks.size(); ++r) {
+    MPI_Irecv(recvBuf + recvOffsets[r], recvCounts[r], MPI_PFLOAT, recvRanks[r], 0, comm, &requests[nRequests++]);
+  }
+  for (size_t r = 0; r < sendRanks.size(); ++r) {
+    MPI_Isend(sendBuf + sendOffsets[r], sendCounts[r], MPI_PFLOAT, sendRanks[r], 0, comm, &requests[nRequests++]);
+  }
+  MPI_Waitall(nRequests, requests.data(), MPI_STATUSES_IGNORE);
+
+  if (nGhosts)
+    o_xHalo.copyFrom(h_recvBuffer, nGhosts, nCols);
+
+  return o_xHalo;
+}
+
+SAAMG_t::SAAMG_t(const int nLocalRows,
+                 const int nnz,
+                 const long long *rows,
+                 const long long *cols,
+                 const double *values,
+                 const int nullSpace,
+                 const MPI_Comm comm_,
+                 const int verbose)
+    : comm(comm_)
+{
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  if (!spmvKernel.isInitialized()) {
+    spmvKernel = platform->kernels.get("amgSpMV");
+    residualKernel = platform->kernels.get("amgResidual");
+    chebyshevUpdateKernel = platform->kernels.get("amgChebyshevUpdate");
+    gatherKernel = platform->kernels.get("amgGather");
+  }
+
+  double theta = 0.08;
+  int coarsestSize = 500;
+  chebyshevDegree = 2;
+  chebyshevFraction = 0.3;
+  platform->options.getArgs("SAAMG STRONG THRESHOLD", theta);
+  platform->options.getArgs("SAAMG COARSEST SIZE", coarsestSize);
+  platform->options.getArgs("SAAMG CHEBYSHEV DEGREE", chebyshevDegree);
+  platform->options.getArgs("SAAMG CHEBYSHEV FRACTION", chebyshevFraction);
+
+  auto rowStarts = partitionStarts(nLocalRows, comm);
+
+  hostMatrix_t A;
+  {
+    std::vector<entry_t> entries(nnz);
+    for (int k = 0; k < nnz; ++k)
+      entries[k] = {static_cast<hlong>(rows[k]), static_cast<hlong>(cols[k]), values[k]};
+    A = assemble(entries, rowStarts, comm);
+  }
+
+  // device CSR with halo exchange pattern for columns distributed like colStarts
+  auto upload = [&](const hostMatrix_t &M, const std::vector<hlong> &colStarts, matrix_t &out) {
+    const hlong colStart = colStarts[rank];
+    const hlong colEnd = colStarts[rank + 1];
+    const auto ghosts = ghostColumns(M, colStart, colEnd);
+
+    out.nRows = M.nRows;
+    out.nCols = colEnd - colStart;
+    out.nGhosts = ghosts.size();
+
+    std::vector<dlong> localCols(M.cols.size());
+    for (size_t k = 0; k < M.cols.size(); ++k) {
+      const hlong c = M.cols[k];
+      localCols[k] = (c >= colStart && c < colEnd)
+                         ? c - colStart
+                         : out.nCols + (std::lower_bound(ghosts.begin(), ghosts.end(), c) - ghosts.begin());
+    }
+    std::vector<pfloat> vals(M.vals.begin(), M.vals.end());
+
+    out.o_rowStarts = platform->device.malloc<dlong>(M.nRows + 1, M.rowPtr.data());
+    out.o_cols = platform->device.malloc<dlong>(std::max<size_t>(localCols.size(), 1));
+    out.o_vals = platform->device.malloc<pfloat>(std::max<size_t>(vals.size(), 1));
+    if (localCols.size()) {
+      out.o_cols.copyFrom(localCols.data(), localCols.size());
+      out.o_vals.copyFrom(vals.data(), vals.size());
+    }
+
+    // ghosts are sorted, i.e. grouped by owner
+    std::vector<std::vector<hlong>> request(size);
+    for (auto &&g : ghosts)
+      request[owner(colStarts, g)].push_back(g);
+    for (int r = 0; r < size; ++r) {
+      if (request[r].empty())
+        continue;
+      out.recvRanks.push_back(r);
+      out.recvCounts.push_back(request[r].size());
+    }
+    out.recvOffsets.assign(1, 0);
+    for (auto &&c : out.recvCounts)
+      out.recvOffsets.push_back(out.recvOffsets.back() + c);
+
+    auto incoming = alltoallv(request, comm);
+    std::vector<hlong> sendIds;
+    out.sendOffsets.assign(1, 0);
+    for (int r = 0; r < size; ++r) {
+      if (incoming[r].empty())
+        continue;
+      out.sendRanks.push_back(r);
+      out.sendCounts.push_back(incoming[r].size());
+      out.sendOffsets.push_back(out.sendOffsets.back() + incoming[r].size());
+      for (auto &&id : incoming[r])
+        sendIds.push_back(id - colStart);
+    }
+
+    if (out.nGhosts || sendIds.size()) {
+      out.o_xHalo = platform->device.malloc<pfloat>(out.nCols + out.nGhosts);
+      out.h_recvBuffer = platform->device.mallocHost<pfloat>(std::max<dlong>(out.nGhosts, 1));
+      out.h_sendBuffer = platform->device.mallocHost<pfloat>(std::max<size_t>(sendIds.size(), 1));
+      if (sendIds.size()) {
+        out.o_sendIds = platform->device.malloc<hlong>(sendIds.size(), sendIds.data());
+        out.o_sendBuffer = platform->device.malloc<pfloat>(sendIds.size());
+      }
+    }
+  };
+
+  while (rowStarts.back() > coarsestSize && static_cast<int>(levels.size()) < maxLevels - 1) {
+    const auto d = diagonal(A);
+
+    dlong nAgg;
+    const auto agg = aggregate(A, d, theta, nAgg);
+    const auto coarseStarts = partitionStarts(nAgg, comm);
+    if (coarseStarts.back() == 0 || coarseStarts.back() > 0.8 * rowStarts.back())
+      break;
+
+    const hlong fineStart = rowStarts[rank];
+    const hlong coarseStart = coarseStarts[rank];
+
+    // tentative prolongator (constant on aggregates, preserves the constant null space)
+    hostMatrix_t P0;
+    P0.rowStart = fineStart;
+    P0.nRows = A.nRows;
+    P0.rowPtr.assign(A.nRows + 1, 0);
+    for (dlong i = 0; i < A.nRows; ++i) {
+      if (agg[i] >= 0) {
+        P0.cols.push_back(coarseStart + agg[i]);
+        P0.vals.push_back(1.0);
+      }
+      P0.rowPtr[i + 1] = P0.cols.size();
+    }
+
+    const auto ghosts = ghostColumns(A, fineStart, rowStarts[rank + 1]);
+    const auto lambdaMax = lambdaMaxBound(A, d, comm);
+
+    // P = (I - omega D^{-1} A) P0
+    hostMatrix_t P;
+    {
+      const auto P0ghost = fetchRows(P0, rowStarts, ghosts, comm);
+      const double omega = 4.0 / (3.0 * lambdaMax);
+
+      std::vector<entry_t> entries;
+      for (dlong i = 0; i < A.nRows; ++i) {
+        std::map<hlong, double> row;
+        if (agg[i] >= 0)
+          row[coarseStart + agg[i]] += 1.0;
+        const double scale = (d[i] != 0) ? omega / d[i] : 0;
+        for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+          const double aij = A.vals[k];
+          forEachInRow(P0, P0ghost, A.cols[k], [&](hlong c, double v) { row[c] -= scale * aij * v; });
+        }
+        for (auto &&e : row)
+          if (e.second != 0)
+            entries.push_back({fineStart + i, e.first, e.second});
+      }
+      P = assemble(entries, rowStarts, comm);
+    }
+
+    // Ac = P^T (A P)
+    hostMatrix_t Ac;
+    {
+      const auto Pghost = fetchRows(P, rowStarts, ghosts, comm);
+
+      std::vector<entry_t> entries;
+      for (dlong i = 0; i < A.nRows; ++i) {
+        std::map<hlong, double> AP;
+        for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+          const double aij = A.vals[k];
+          forEachInRow(P, Pghost, A.cols[k], [&](hlong c, double v) { AP[c] += aij * v; });
+        }
+        for (dlong k = P.rowPtr[i]; k < P.rowPtr[i + 1]; ++k) {
+          for (auto &&e : AP)
+            entries.push_back({P.cols[k], e.first, P.vals[k] * e.second});
+        }
+      }
+      Ac = assemble(entries, coarseStarts, comm);
+    }
+
+    levels.emplace_back();
+    auto &level = levels.back();
+    upload(A, rowStarts, level.A);
+    upload(P, coarseStarts, level.P);
+    upload(transpose(P, coarseStarts, comm), rowStarts, level.R);
+
+    std::vector<pfloat> invDiag(A.nRows);
+    for (dlong i = 0; i < A.nRows; ++i)
+      invDiag[i] = (d[i] != 0) ? 1 / d[i] : 0;
+    const size_t Nlocal = std::max<dlong>(A.nRows, 1);
+    level.o_invDiag = platform->device.malloc<pfloat>(Nlocal);
+    if (A.nRows)
+      level.o_invDiag.copyFrom(invDiag.data(), A.nRows);
+    level.o_x = platform->device.malloc<pfloat>(Nlocal);
+    level.o_b = platform->device.malloc<pfloat>(Nlocal);
+    level.o_r = platform->device.malloc<pfloat>(Nlocal);
+    level.o_d = platform->device.malloc<pfloat>(Nlocal);
+    level.lambdaMax = lambdaMax;
+
+    if (verbose && rank == 0)
+      printf("\n  SAAMG level %zu: rows %lld -> %lld", levels.size() - 1,
+             static_cast<long long>(rowStarts.back()),
+             static_cast<long long>(coarseStarts.back()));
+
+    A = std::move(Ac);
+    rowStarts = coarseStarts;
+  }
+  nLevels = levels.size() + 1;
+
+  // redundant dense solve on the coarsest level, Chebyshev iterations if it is too
+  // large (coarsening stalled) or the factorization fails
+  {
+    const hlong n = rowStarts.back();
+
+    coarseRowStart = rowStarts[rank];
+    coarseRows = A.nRows;
+    coarseDense = (n <= maxDenseRows);
+
+    int N = n;
+    std::string fallback = (coarseDense) ? "" : "too large for a dense solve";
+    std::vector<double> dense;
+    if (coarseDense) {
+      std::vector<entry_t> local;
+      for (dlong i = 0; i < A.nRows; ++i)
+        for (dlong k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+          local.push_back({A.rowStart + i, A.cols[k], A.vals[k]});
+
+      int nLocal = local.size();
+      std::vector<int> counts(size);
+      MPI_Allgather(&nLocal, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+      const auto displs = displacements(counts, comm);
+      std::vector<entry_t> global(displs[size]);
+      auto type = mpiType<entry_t>();
+      MPI_Allgatherv(local.data(), nLocal, type, global.data(), counts.data(), displs.data(), type, comm);
+      MPI_Type_free(&type);
+
+      dense.assign(static_cast<size_t>(N) * N, 0);
+      double diagAvg = 0;
+      for (auto &&e : global) {
+        dense[e.row + e.col * N] += e.val;
+        if (e.row == e.col)
+          diagAvg += e.val;
+      }
+      diagAvg /= std::max(N, 1);
+
+      // regularize the constant null space, the solution has zero mean
+      if (nullSpace) {
+        for (auto &&v : dense)
+          v += diagAvg / N;
+      }
+
+      int info = 0;
+      if (N) {
+        std::vector<int> ipiv(N);
+        dgetrf_(&N, &N, dense.data(), &N, ipiv.data(), &info);
+        if (info == 0) {
+          int lwork = N * N;
+          std::vector<double> work(lwork);
+          dgetri_(&N, dense.data(), &N, ipiv.data(), work.data(), &lwork, &info);
+        }
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &info, 1, MPI_INT, MPI_MAX, comm);
+      if (info != 0) {
+        fallback = "dense inversion failed (info = " + std::to_string(info) + ")";
+        coarseDense = false;
+      }
+    }
+
+    if (coarseDense) {
+      coarseInvA.resize(static_cast<size_t>(coarseRows) * N);
+      for (dlong i = 0; i < coarseRows; ++i)
+        for (int j = 0; j < N; ++j)
+          coarseInvA[j + i * N] = dense[(coarseRowStart + i) + j * N];
+
+      coarseCounts.resize(size);
+      coarseOffsets.assign(size + 1, 0);
+      for (int r = 0; r < size; ++r) {
+        coarseCounts[r] = rowStarts[r + 1] - rowStarts[r];
+        coarseOffsets[r + 1] = coarseOffsets[r] + coarseCounts[r];
+      }
+      coarseRhs.resize(std::max<dlong>(coarseRows, 1));
+      coarseX.resize(std::max<dlong>(coarseRows, 1));
+      coarseRhsGlobal.resize(std::max(N, 1));
+    } else {
+      const auto d = diagonal(A);
+      upload(A, rowStarts, coarseLevel.A);
+
+      std::vector<pfloat> invDiag(A.nRows);
+      for (dlong i = 0; i < A.nRows; ++i)
+        invDiag[i] = (d[i] != 0) ? 1 / d[i] : 0;
+      const size_t Nlocal = std::max<dlong>(A.nRows, 1);
+      coarseLevel.o_invDiag = platform->device.malloc<pfloat>(Nlocal);
+      if (A.nRows)
+        coarseLevel.o_invDiag.copyFrom(invDiag.data(), A.nRows);
+      coarseLevel.o_r = platform->device.malloc<pfloat>(Nlocal);
+      coarseLevel.o_d = platform->device.malloc<pfloat>(Nlocal);
+      coarseLevel.lambdaMax = lambdaMaxBound(A, d, comm);
+      coarseChebyshevDegree = std::max(4 * chebyshevDegree, 8);
+    }
+    o_coarseB = platform->device.malloc<pfloat>(std::max<dlong>(coarseRows, 1));
+    o_coarseX = platform->device.malloc<pfloat>(std::max<dlong>(coarseRows, 1));
+
+    if (verbose && rank == 0) {
+      if (coarseDense)
+        printf("\n  SAAMG coarsest level: rows %d (dense)\n", N);
+      else
+        printf("\n  SAAMG coarsest level: rows %d (Chebyshev degree %d, %s)\n", N, coarseChebyshevDegree, fallback.c_str());
+    } else if (!coarseDense && rank == 0) {
+      printf("SAAMG coarsest level with %d rows %s, using Chebyshev iterations\n", N, fallback.c_str());
+    }
+  }
+}
+
+SAAMG_t::~SAAMG_t()
+{
+  auto freeLevel = [](level_t &level) {
+    for (auto *M : {&level.A, &level.P, &level.R}) {
+      M->o_rowStarts.free();
+      M->o_cols.free();
+      M->o_vals.free();
+      M->o_sendIds.free();
+      M->o_sendBuffer.free();
+      M->h_sendBuffer.free();
+      M->h_recvBuffer.free();
+      M->o_xHalo.free();
+    }
+    level.o_invDiag.free();
+    level.o_x.free();
+    level.o_b.free();
+    level.o_r.free();
+    level.o_d.free();
+  };
+
+  for (auto &&level : levels)
+    freeLevel(level);
+  freeLevel(coarseLevel);
+  o_coarseB.free();
+  o_coarseX.free();
+}
+
+void SAAMG_t::spmv(matrix_t &A, pfloat beta, const occa::memory &o_x, occa::memory &o_y)
+{
+  const auto &o_xHalo = A.haloExchange(o_x, comm);
+  if (A.nRows)
+    spmvKernel(A.nRows, beta, A.o_rowStarts, A.o_cols, A.o_vals, o_xHalo, o_y);
+}
+
+void SAAMG_t::residual(level_t &level, const occa::memory &o_b, const occa::memory &o_x, occa::memory &o_r)
+{
+  auto &A = level.A;
+  const auto &o_xHalo = A.haloExchange(o_x, comm);
+  if (A.nRows)
+    residualKernel(A.nRows, A.o_rowStarts, A.o_cols, A.o_vals, o_xHalo, o_b, o_r);
+}
+
+// Chebyshev iteration preconditioned by the diagonal, see Saad, Alg. 12.1
+void SAAMG_t::smooth(level_t &level, const occa::memory &o_b, occa::memory &o_x, bool xIsZero, int degree)
+{
+  const dlong N = level.A.nRows;
+  const double lambdaMax = level.lambdaMax;
+  const double lambdaMin = chebyshevFraction * lambdaMax;
+
+  const double theta = 0.5 * (lambdaMax + lambdaMin);
+  const double delta = 0.5 * (lambdaMax - lambdaMin);
+  const double sigma = theta / delta;
+  double rho = 1 / sigma;
+
+  if (xIsZero && N)
+    platform->linAlg->pfill(N, 0.0, o_x);
+
+  // first step with the initial residual, r = b for a zero initial guess
+  if (!xIsZero)
+    residual(level, o_b, o_x, level.o_r);
+  if (N)
+    chebyshevUpdateKernel(N,
+                          static_cast<pfloat>(0),
+                          static_cast<pfloat>(1 / theta),
+                          level.o_invDiag,
+                          xIsZero ? o_b : level.o_r,
+                          level.o_d,
+                          o_x);
+
+  for (int k = 1; k < degree; ++k) {
+    residual(level, o_b, o_x, level.o_r);
+    const double rhoNew = 1 / (2 * sigma - rho);
+    if (N)
+      chebyshevUpdateKernel(N,
+                            static_cast<pfloat>(rhoNew * rho),
+                            static_cast<pfloat>(2 * rhoNew / delta),
+                            level.o_invDiag,
+                            level.o_r,
+                            level.o_d,
+                            o_x);
+    rho = rhoNew;
+  }
+}
+
+void SAAMG_t::coarseSolve(const occa::memory &o_b, occa::memory &o_x)
+{
+  if (!coarseDense) {
+    smooth(coarseLevel, o_b, o_x, true, coarseChebyshevDegree);
+    return;
+  }
+
+  const int N = coarseOffsets.back();
+
+  if (coarseRows)
+    o_b.copyTo(coarseRhs.data(), coarseRows);
+  MPI_Allgatherv(coarseRhs.data(),
+                 coarseRows,
+                 MPI_PFLOAT,
+                 coarseRhsGlobal.data(),
+                 coarseCounts.data(),
+                 coarseOffsets.data(),
+                 MPI_PFLOAT,
+                 comm);
+
+  for (dlong i = 0; i < coarseRows; ++i) {
+    double sum = 0;
+    for (int j = 0; j < N; ++j)
+      sum += coarseInvA[j + i * N] * coarseRhsGlobal[j];
+    coarseX[i] = sum;
+  }
+
+  if (coarseRows)
+    o_x.copyFrom(coarseX.data(), coarseRows);
+}
+
+void SAAMG_t::vcycle(int lev, const occa::memory &o_b, occa::memory &o_x)
+{
+  if (lev == nLevels - 1) {
+    coarseSolve(o_b, o_x);
+    return;
+  }
+
+  auto &level = levels[lev];
+  const bool coarsest = (lev + 1 == nLevels - 1);
+  auto &o_bc = coarsest ? o_coarseB : levels[lev + 1].o_b;
+  auto &o_xc = coarsest ? o_coarseX : levels[lev + 1].o_x;
+
+  smooth(level, o_b, o_x, true, chebyshevDegree);
+
+  residual(level, o_b, o_x, level.o_r);
+  spmv(level.R, 0.0, level.o_r, o_bc);
+
+  vcycle(lev + 1, o_bc, o_xc);
+
+  spmv(level.P, 1.0, o_xc, o_x);
+
+  smooth(level, o_b, o_x, false, chebyshevDegree);
+}
+
+void SAAMG_t::solve(const occa::memory &o_b, occa::memory &o_x)
+{
+  vcycle(0, o_b, o_x);
+}
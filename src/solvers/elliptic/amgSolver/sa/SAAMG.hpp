@@ -0,0 +1,83 @@
+#ifndef SAAMG_H
+#define SAAMG_H
+
+#include <mpi.h>
+#include <vector>
+
+#include "nrssys.hpp"
+
+// smoothed aggregation AMG running on the nekRS device
+//   setup:  decoupled (rank local) aggregation, Jacobi smoothed piecewise constant prolongator,
+//           Galerkin coarse operators, all assembled on the host in double precision
+//   solve:  V-cycle with device resident CSR SpMV and Chebyshev(Jacobi) smoothing,
+//           redundant dense solve on the coarsest level, Chebyshev iterations if it is
+//           too large or singular
+class SAAMG_t
+{
+public:
+  ~SAAMG_t();
+
+  SAAMG_t(const int nLocalRows,
+          const int nnz,
+          const long long *rows,
+          const long long *cols,
+          const double *values, /* COO */
+          const int nullSpace,
+          const MPI_Comm comm,
+          const int verbose);
+
+  void solve(const occa::memory &o_b, occa::memory &o_x);
+
+private:
+  // row distributed CSR matrix, columns [0,nCols) are owned and [nCols,nCols+nGhosts) are halo entries
+  struct matrix_t {
+    dlong nRows = 0;
+    dlong nCols = 0;
+    dlong nGhosts = 0;
+    occa::memory o_rowStarts;
+    occa::memory o_cols;
+    occa::memory o_vals;
+
+    std::vector<int> sendRanks, sendCounts, sendOffsets;
+    std::vector<int> recvRanks, recvCounts, recvOffsets;
+    occa::memory o_sendIds;
+    occa::memory o_sendBuffer;
+    occa::memory h_sendBuffer, h_recvBuffer;
+    occa::memory o_xHalo;
+
+    const occa::memory &haloExchange(const occa::memory &o_x, MPI_Comm comm);
+  };
+
+  struct level_t {
+    matrix_t A, P, R;
+    occa::memory o_invDiag;
+    occa::memory o_x, o_b, o_r, o_d;
+    double lambdaMax;
+  };
+
+  MPI_Comm comm;
+  int nLevels;
+  std::vector<level_t> levels;
+
+  int chebyshevDegree;
+  double chebyshevFraction; // smooth on [fraction*lambdaMax, lambdaMax]
+
+  // coarsest level
+  bool coarseDense;
+  level_t coarseLevel; // A, invDiag and work vectors, only used if !coarseDense
+  int coarseChebyshevDegree;
+  hlong coarseRowStart;
+  dlong coarseRows;
+  std::vector<int> coarseCounts, coarseOffsets;
+  std::vector<double> coarseInvA; // local rows of the dense inverse
+  std::vector<pfloat> coarseRhs, coarseRhsGlobal, coarseX;
+  occa::memory o_coarseB, o_coarseX;
+
+  void spmv(matrix_t &A, pfloat beta, const occa::memory &o_x, occa::memory &o_y);
+  void residual(level_t &level, const occa::memory &o_b, const occa::memory &o_x, occa::memory &o_r);
+  void smooth(level_t &level, const occa::memory &o_b, occa::memory &o_x, bool xIsZero, int degree);
+  void coarseSolve(const occa::memory &o_b, occa::memory &o_x);
+  void vcycle(int lev, const occa::memory &o_b, occa::memory &o_x);
+};
+
+#endif
@@ -31,6 +31,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <array>
+#include <vector>
 
 #include "nrssys.hpp"
 #include "mesh3D.h"
@@ -68,6 +70,19 @@ struct GmresData{
   dfloat* cs;
   dfloat* s;
   dfloat* scratch;
+
+  // low-synch Arnoldi
+  occa::memory o_coeffs;
+  dfloat* coeffs;
+  dfloat* Hraw;
+
+  // Krylov subspace recycling (GCRO-DR), persists across solves
+  int nRecycleVectors;
+  int nRecycled;
+  occa::memory o_U;  // recycled solution space
+  occa::memory o_CV; // [C V] with C = A U orthonormal, C stored right aligned
+  dfloat* B;         // C^T A Z
+  std::array<double, 2> recycleSignature; // operator coefficients C = A U was built for
 };
 
 struct elliptic_t
@@ -83,11 +98,21 @@ struct elliptic_t
 
   bool mgLevel = false;
 
+  // Ax integrated on the cubature points (mesh->cubNq) instead of the GLL points
+  bool cubatureAx = false;
+
+  // Nfields independent scalar systems solved together (loffset separates the coefficients)
+  bool batched = false;
+
   std::string name;
 
   int Niter;
   dfloat res00Norm, res0Norm, resNorm;
 
+  // per field statistics of a batched solve
+  std::vector<int> NiterField;
+  std::vector<dfloat> res0NormField, resNormField;
+
   dlong fieldOffset; 
 
   mesh_t* mesh;
@@ -127,6 +152,7 @@ struct elliptic_t
   occa::memory o_res;
   occa::memory o_Ap; // A*search direction
   occa::memory o_v;  // work array for combined PCG iteration
+  std::array<occa::memory, 6> o_pipelinedPCG; // work arrays for pipelined PCG iteration
   occa::memory o_invDegree;
   occa::memory o_interp;
 
@@ -145,10 +171,17 @@ struct elliptic_t
   // fourth kind Chebyshev iteration
   occa::kernel updateFourthKindChebyshevKernel;
 
+  // Chebyshev updates with fused Jacobi scaling
+  occa::kernel initJacobiChebyshevKernel;
+  occa::kernel updateJacobiChebyshevKernel;
+  occa::kernel updateJacobiFourthKindChebyshevKernel;
+
   occa::kernel updatePGMRESSolutionKernel;
   occa::kernel fusedResidualAndNormKernel;
 
   occa::kernel gramSchmidtOrthogonalizationKernel;
+  occa::kernel lowSyncGMRESReductionsKernel;
+  occa::kernel lowSyncGMRESOrthogonalizationKernel;
 
   dfloat resNormFactor;
 
@@ -168,6 +201,16 @@ struct elliptic_t
   occa::kernel combinedPCGPostMatVecKernel;
   occa::kernel combinedPCGUpdateConvergedSolutionKernel;
 
+  // specialized kernels needed for pipelined PCG iteration
+  occa::kernel pipelinedPCGReductionsKernel;
+  occa::kernel pipelinedPCGUpdateKernel;
+
+  // batched PCG iteration with per field coefficients
+  occa::kernel batchedPCGInnerProdKernel;
+  occa::kernel batchedPCGUpdatePKernel;
+  occa::kernel batchedPCGUpdateKernel;
+  occa::memory o_batchedPCGCoeffs;
+
   occa::memory o_lambda0;
   dfloat lambda0Avg;
   occa::memory o_lambda1;
@@ -208,10 +251,19 @@ struct CombinedPCGId {
   static constexpr int f = 6;
 };
 
+// indices used in pipelinedPCG routines
+struct PipelinedPCGId {
+  static constexpr int nReduction = 3;
+  static constexpr int gamma = 0;
+  static constexpr int delta = 1;
+  static constexpr int rdotr = 2;
+};
+
 int pcg(elliptic_t* elliptic, const dfloat tol, const int MAXIT, dfloat &res, occa::memory &o_r, occa::memory &o_x);
 
 void initializeGmresData(elliptic_t*);
 int pgmres(elliptic_t* elliptic, const dfloat tol, const int MAXIT, dfloat &res, occa::memory &o_r, occa::memory &o_x);
+int gcrodr(elliptic_t* elliptic, const dfloat tol, const int MAXIT, dfloat &res, occa::memory &o_r, occa::memory &o_x);
 
 void ellipticOperator(elliptic_t* elliptic,
                       const occa::memory &o_q,
@@ -263,6 +315,11 @@ static void ellipticAllocateWorkspace(elliptic_t* elliptic)
   if (elliptic->options.compareArgs("SOLVER", "PCG+COMBINED")) {
     elliptic->o_v = platform->o_memPool.reserve<dfloat>(elliptic->Nfields * elliptic->fieldOffset);
   }
+
+  if (elliptic->options.compareArgs("SOLVER", "PCG+PIPELINED")) {
+    for (auto &o_work : elliptic->o_pipelinedPCG)
+      o_work = platform->o_memPool.reserve<dfloat>(elliptic->Nfields * elliptic->fieldOffset);
+  }
 }
 
 static void ellipticFreeWorkspace(elliptic_t* elliptic)
@@ -277,6 +334,11 @@ static void ellipticFreeWorkspace(elliptic_t* elliptic)
   if (elliptic->options.compareArgs("SOLVER", "PCG+COMBINED")) {
     elliptic->o_v.free();
   }
+
+  if (elliptic->options.compareArgs("SOLVER", "PCG+PIPELINED")) {
+    for (auto &o_work : elliptic->o_pipelinedPCG)
+      o_work.free();
+  }
 }
 
  
@@ -53,6 +53,11 @@ void ellipticBuildPreconditionerKernels(elliptic_t* elliptic)
     kernelName = "updateFourthKindChebyshev";
     elliptic->updateFourthKindChebyshevKernel = platform->kernels.get(kernelName + orderSuffix);
 
+    elliptic->initJacobiChebyshevKernel = platform->kernels.get("initJacobiChebyshev" + orderSuffix);
+    elliptic->updateJacobiChebyshevKernel = platform->kernels.get("updateJacobiChebyshev" + orderSuffix);
+    elliptic->updateJacobiFourthKindChebyshevKernel =
+      platform->kernels.get("updateJacobiFourthKindChebyshev" + orderSuffix);
+
     kernelName = "ellipticBlockBuildDiagonalHex3D";
     const std::string poissonPrefix = elliptic->poisson ? "poisson-" : "";
     elliptic->ellipticBlockBuildDiagonalKernel =
@@ -77,17 +77,31 @@ void ellipticAx(elliptic_t* elliptic,
 
   occa::kernel &AxKernel = elliptic->AxKernel;
 
-  AxKernel(NelementsList,
-           elliptic->fieldOffset,
-           elliptic->loffset,
-           o_elementsList,
-           o_geom_factors,
-           o_D,
-           o_DT,
-           o_lambda0,
-           o_lambda1,
-           o_q,
-           o_Aq);
+  if (elliptic->cubatureAx) {
+    AxKernel(NelementsList,
+             elliptic->fieldOffset,
+             elliptic->loffset,
+             o_elementsList,
+             mesh->o_cubvgeo,
+             mesh->o_cubInterpT,
+             mesh->o_cubD,
+             o_lambda0,
+             o_lambda1,
+             o_q,
+             o_Aq);
+  } else {
+    AxKernel(NelementsList,
+             elliptic->fieldOffset,
+             elliptic->loffset,
+             o_elementsList,
+             o_geom_factors,
+             o_D,
+             o_DT,
+             o_lambda0,
+             o_lambda1,
+             o_q,
+             o_Aq);
+  }
 
   double flopCount = mesh->Np * 12 * mesh->Nq + 15 * mesh->Np;
   if(coeffField)
@@ -101,6 +115,16 @@ void ellipticAx(elliptic_t* elliptic,
   if (elliptic->stressForm)
     flopCount += (15 + 6) * mesh->Np;
 
+  if (elliptic->cubatureAx) {
+    const int NcubFields = coeffField ? (elliptic->poisson ? 2 : 3) : 1;
+    const double interpFlops = 2.0 * (mesh->Np * mesh->cubNq + mesh->Nq * mesh->Nq * mesh->cubNq * mesh->cubNq +
+                                      mesh->cubNp * mesh->Nq);
+    flopCount = (NcubFields + 1) * interpFlops;
+    flopCount += 12.0 * mesh->cubNp * mesh->cubNq + 37 * mesh->cubNp;
+    if (!elliptic->poisson)
+      flopCount += 3 * mesh->cubNp;
+  }
+
   flopCount *= elliptic->Nfields * static_cast<double>(NelementsList);
 
   const double factor = (mixedPrecision) ? 0.5 : 1.0;
@@ -83,7 +83,48 @@ void checkConfig(elliptic_t *elliptic)
     err++;
   }
 
-  if (elliptic->Nfields < 1 || elliptic->Nfields > 3) {
+  if (elliptic->batched) {
+    if (!options.compareArgs("SOLVER", "PCG+BATCHED")) {
+      if (platform->comm.mpiRank == 0)
+        printf("Batched solve requires batched PCG solver\n");
+      err++;
+    }
+    if (!options.compareArgs("PRECONDITIONER", "JACOBI") && !options.compareArgs("PRECONDITIONER", "NONE")) {
+      if (platform->comm.mpiRank == 0)
+        printf("Batched solve only supports Jacobi or no preconditioner\n");
+      err++;
+    }
+    if (options.compareArgs("INITIAL GUESS", "PROJECTION")) {
+      if (platform->comm.mpiRank == 0)
+        printf("Batched solve does not support projection\n");
+      err++;
+    }
+    if (platform->options.compareArgs("ELEMENT MAP", "TRILINEAR")) {
+      if (platform->comm.mpiRank == 0)
+        printf("Batched solve does not support trilinear element map\n");
+      err++;
+    }
+  }
+
+  if (options.compareArgs("ELLIPTIC INTEGRATION", "CUBATURE")) {
+    if (mesh->cubNq <= mesh->Nq) {
+      if (platform->comm.mpiRank == 0)
+        printf("Cubature integration requires cubaturePolynomialOrder > polynomialOrder\n");
+      err++;
+    }
+    if (elliptic->blockSolver || elliptic->batched) {
+      if (platform->comm.mpiRank == 0)
+        printf("Cubature integration does not support block or batched solvers\n");
+      err++;
+    }
+    if (platform->options.compareArgs("ELEMENT MAP", "TRILINEAR")) {
+      if (platform->comm.mpiRank == 0)
+        printf("Cubature integration does not support trilinear element map\n");
+      err++;
+    }
+  }
+
+  if (elliptic->Nfields < 1 || (elliptic->Nfields > 3 && !elliptic->batched)) {
     if (platform->comm.mpiRank == 0)
       printf("Invalid Nfields = %d!", elliptic->Nfields);
     err++;
@@ -179,6 +220,11 @@ void ellipticSolveSetup(elliptic_t *elliptic)
         platform->kernels.get(sectionIdentifier + "gramSchmidtOrthogonalization");
     elliptic->updatePGMRESSolutionKernel = platform->kernels.get(sectionIdentifier + "updatePGMRESSolution");
     elliptic->fusedResidualAndNormKernel = platform->kernels.get(sectionIdentifier + "fusedResidualAndNorm");
+    if (options.compareArgs("SOLVER", "LOWSYNC")) {
+      elliptic->lowSyncGMRESReductionsKernel = platform->kernels.get(sectionIdentifier + "lowSyncGMRESReductions");
+      elliptic->lowSyncGMRESOrthogonalizationKernel =
+          platform->kernels.get(sectionIdentifier + "lowSyncGMRESOrthogonalization");
+    }
   }
 
   if (options.compareArgs("SOLVER", "PCG+COMBINED")) {
@@ -190,15 +236,35 @@ void ellipticSolveSetup(elliptic_t *elliptic)
         platform->kernels.get(sectionIdentifier + "combinedPCGUpdateConvergedSolution");
   }
 
+  if (options.compareArgs("SOLVER", "PCG+PIPELINED")) {
+    const std::string sectionIdentifier = std::to_string(elliptic->Nfields) + "-";
+    elliptic->pipelinedPCGReductionsKernel = platform->kernels.get(sectionIdentifier + "pipelinedPCGReductions");
+    elliptic->pipelinedPCGUpdateKernel = platform->kernels.get(sectionIdentifier + "pipelinedPCGUpdate");
+  }
+
   mesh->maskKernel = platform->kernels.get("mask");
   mesh->maskPfloatKernel = platform->kernels.get("maskPfloat");
  
   ellipticAllocateWorkspace(elliptic);
 
+  if (elliptic->batched) {
+    const std::string sectionIdentifier = "batch" + std::to_string(elliptic->Nfields) + "-";
+    elliptic->batchedPCGInnerProdKernel = platform->kernels.get(sectionIdentifier + "batchedPCGInnerProd");
+    elliptic->batchedPCGUpdatePKernel = platform->kernels.get(sectionIdentifier + "batchedPCGUpdateP");
+    elliptic->batchedPCGUpdateKernel = platform->kernels.get(sectionIdentifier + "batchedPCGUpdate");
+    elliptic->o_batchedPCGCoeffs = platform->device.malloc<dfloat>(elliptic->Nfields);
+  }
+
   int Nreductions = 1;
   if (options.compareArgs("SOLVER", "PCG+COMBINED")) {
     Nreductions = CombinedPCGId::nReduction;
   }
+  if (options.compareArgs("SOLVER", "PCG+PIPELINED")) {
+    Nreductions = PipelinedPCGId::nReduction;
+  }
+  if (elliptic->batched) {
+    Nreductions = elliptic->Nfields;
+  }
 
   elliptic->h_tmpHostScalars = platform->device.mallocHost<dfloat>(Nreductions * Nblocks);
   elliptic->tmpHostScalars = elliptic->h_tmpHostScalars.ptr<dfloat>();
@@ -249,7 +315,8 @@ void ellipticSolveSetup(elliptic_t *elliptic)
     std::string kernelName;
     const std::string suffix = "Hex3D";
 
-    const std::string sectionIdentifier = std::to_string(elliptic->Nfields) + "-";
+    const std::string sectionIdentifier =
+        (elliptic->batched ? "batch" : "") + std::to_string(elliptic->Nfields) + "-";
     kernelName = "ellipticBlockBuildDiagonal" + suffix;
     elliptic->ellipticBlockBuildDiagonalKernel = platform->kernels.get(sectionIdentifier + kernelName);
 
@@ -263,13 +330,18 @@ void ellipticSolveSetup(elliptic_t *elliptic)
     if (elliptic->blockSolver)
       kernelNamePrefix += (elliptic->stressForm) ? "Stress" : "Block";
 
+    elliptic->cubatureAx = options.compareArgs("ELLIPTIC INTEGRATION", "CUBATURE");
+
     kernelName = "Ax";
-    kernelName += "Coeff";
+    kernelName += (elliptic->cubatureAx) ? "Cubature" : "Coeff";
     if (platform->options.compareArgs("ELEMENT MAP", "TRILINEAR"))
       kernelName += "Trilinear";
     kernelName += suffix;
 
-    elliptic->AxKernel = platform->kernels.get(kernelNamePrefix + "Partial" + kernelName);
+    if (elliptic->batched)
+      elliptic->AxKernel = platform->kernels.get(sectionIdentifier + "ellipticBatchPartial" + kernelName);
+    else
+      elliptic->AxKernel = platform->kernels.get(kernelNamePrefix + "Partial" + kernelName);
 
     elliptic->updatePCGKernel = platform->kernels.get(sectionIdentifier + "ellipticBlockUpdatePCG");
   }
@@ -339,7 +411,9 @@ void ellipticSolveSetup(elliptic_t *elliptic)
     else if (options.compareArgs("INITIAL GUESS", "PROJECTION"))
       type = SolutionProjection::ProjectionType::CLASSIC;
 
-    elliptic->solutionProjection = new SolutionProjection(*elliptic, type, nVecsProject, nStepsStart);
+    const bool adaptive = options.compareArgs("RESIDUAL PROJECTION ADAPTIVE", "TRUE");
+
+    elliptic->solutionProjection = new SolutionProjection(*elliptic, type, nVecsProject, nStepsStart, adaptive);
   }
 
   ellipticFreeWorkspace(elliptic);
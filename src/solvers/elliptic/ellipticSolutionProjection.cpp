@@ -27,6 +27,8 @@
 #include "elliptic.h"
 #include "ellipticSolutionProjection.h"
 #include <iostream>
+#include <cmath>
+#include <limits>
 #include "timer.hpp"
 #include "platform.hpp"
 #include "linAlg.hpp"
@@ -201,7 +203,7 @@ void SolutionProjection::computePostProjection(occa::memory &o_x)
     numVecsProjection = 1;
     o_xx.copyFrom(o_x, Nfields * fieldOffset);
   }
-  else if (numVecsProjection == maxNumVecsProjection) {
+  else if (numVecsProjection >= activeMaxNumVecsProjection) {
     numVecsProjection = 1;
     platform->linAlg->axpbyMany(Nlocal, Nfields, fieldOffset, one, o_xbar, one, o_x);
     o_xx.copyFrom(o_x, Nfields * fieldOffset);
@@ -232,12 +234,16 @@ void SolutionProjection::computePostProjection(occa::memory &o_x)
 SolutionProjection::SolutionProjection(elliptic_t &elliptic,
                                        const ProjectionType _type,
                                        const dlong _maxNumVecsProjection,
-                                       const dlong _numTimeSteps)
-    : maxNumVecsProjection(_maxNumVecsProjection), numTimeSteps(_numTimeSteps), type(_type),
+                                       const dlong _numTimeSteps,
+                                       const bool _adaptive)
+    : adaptive(_adaptive), activeMaxNumVecsProjection(_maxNumVecsProjection),
+      gain(_maxNumVecsProjection + 1, -1.0), timeVector(0), timeSolvePerLog(0), timeMarker(-1),
+      timeProjection(0), costPerSolve(0), numSamples(0),
+      maxNumVecsProjection(_maxNumVecsProjection), numTimeSteps(_numTimeSteps), type(_type),
       alpha((dfloat *)calloc(maxNumVecsProjection, sizeof(dfloat))), numVecsProjection(0),
       prevNumVecsProjection(0), Nlocal(elliptic.mesh->Np * elliptic.mesh->Nelements),
       fieldOffset(elliptic.fieldOffset), Nfields(elliptic.Nfields), timestep(0),
-      verbose(platform->options.compareArgs("VERBOSE", "TRUE")), o_invDegree(elliptic.mesh->ogs->o_invDegree),
+      verbose(platform->options.compareArgs("VERBOSE", "TRUE")), elliptic(elliptic), o_invDegree(elliptic.mesh->ogs->o_invDegree),
       o_rtmp(elliptic.o_z), o_Ap(elliptic.o_Ap)
 {
   solverName = elliptic.name;
@@ -272,22 +278,131 @@ SolutionProjection::SolutionProjection(elliptic_t &elliptic,
   maskOperator = [&](occa::memory &o_x) { ellipticApplyMask(&elliptic, o_x, dfloatString); };
 }
 
+void SolutionProjection::sampleCost()
+{
+  const int m = prevNumVecsProjection;
+  if (m <= 0 || m > maxNumVecsProjection)
+    return;
+  if (elliptic.res0Norm <= 0 || elliptic.resNorm <= 0)
+    return;
+
+  platform->device.finish();
+  const double timeSolve = MPI_Wtime() - timeMarker;
+
+  // exponential moving averages to follow slowly changing flow conditions
+  constexpr double w = 0.3;
+  auto average = [&](double avg, double sample) { return (avg > 0) ? (1 - w) * avg + w * sample : sample; };
+
+  const double g = std::max(std::log(static_cast<double>(elliptic.res00Norm) / elliptic.res0Norm), 0.0);
+  gain[m] = (gain[m] >= 0) ? (1 - w) * gain[m] + w * g : g;
+
+  timeVector = average(timeVector, timeProjection / m);
+
+  const double logReduction = std::log(elliptic.res0Norm / elliptic.resNorm);
+  if (elliptic.Niter > 0 && logReduction > 0)
+    timeSolvePerLog = average(timeSolvePerLog, timeSolve / logReduction);
+
+  numSamples++;
+}
+
+// The space is filled one vector per solve and restarted once full, so a cycle of an
+// M dimensional space visits m = 1..M and costs per solve on average
+//
+//   C(M) = 1/M sum_{m=1}^{M} (m * timeVector - gain(m) * timeSolvePerLog)
+//
+// The cycle length minimizing C(M) becomes the new space dimension. If the optimum is the
+// current dimension we grow by one vector to probe whether a larger space pays off.
+void SolutionProjection::adaptProjectionSpace()
+{
+  double times[2] = {timeVector, timeSolvePerLog};
+  MPI_Allreduce(MPI_IN_PLACE, times, 2, MPI_DOUBLE, MPI_MAX, platform->comm.mpiComm);
+  const double tVec = times[0];
+  const double tSolvePerLog = times[1];
+
+  if (tSolvePerLog <= 0)
+    return;
+
+  dlong bestM = 1;
+  double bestCost = std::numeric_limits<double>::max();
+  double sum = 0;
+  for (dlong M = 1; M <= activeMaxNumVecsProjection; M++) {
+    if (gain[M] < 0)
+      break;
+    sum += M * tVec - gain[M] * tSolvePerLog;
+    if (sum / M < bestCost) {
+      bestCost = sum / M;
+      bestM = M;
+    }
+  }
+  costPerSolve = bestCost;
+
+  dlong newMaxNumVecs = bestM;
+  if (bestM == activeMaxNumVecsProjection)
+    newMaxNumVecs = std::min(bestM + 1, maxNumVecsProjection);
+
+  if (newMaxNumVecs != activeMaxNumVecsProjection && verbose && platform->comm.mpiRank == 0) {
+    std::cout << "solutionProjection " << solverName << ": adapt nVector " << activeMaxNumVecsProjection
+              << " -> " << newMaxNumVecs << "\n";
+  }
+  activeMaxNumVecsProjection = newMaxNumVecs;
+}
+
+void SolutionProjection::printAdaptiveInfo() const
+{
+  printf("           adaptive nVector %d  tVec %.2e  tSolve/log %.2e  cost/solve %.2e  samples %d\n",
+         activeMaxNumVecsProjection,
+         timeVector,
+         timeSolvePerLog,
+         costPerSolve,
+         numSamples);
+}
+
 void SolutionProjection::pre(occa::memory &o_r)
 {
   ++timestep;
+  timeMarker = -1;
   if (timestep < numTimeSteps)
     return;
 
   if (numVecsProjection <= 0)
     return;
 
+  if (adaptive) {
+    platform->device.finish();
+    timeMarker = MPI_Wtime();
+  }
+
   prevNumVecsProjection = numVecsProjection;
   computePreProjection(o_r);
+
+  if (adaptive) {
+    platform->device.finish();
+    const double now = MPI_Wtime();
+    // post projection of the previous solve is accounted here as well
+    timeProjection += now - timeMarker;
+    timeMarker = now;
+  }
 }
 
 void SolutionProjection::post(occa::memory &o_x)
 {
   if (timestep < numTimeSteps)
     return;
+
+  if (adaptive) {
+    if (timeMarker > 0)
+      sampleCost();
+    // space is about to be restarted
+    if (numVecsProjection >= activeMaxNumVecsProjection)
+      adaptProjectionSpace();
+    platform->device.finish();
+    timeProjection = -MPI_Wtime();
+  }
+
   computePostProjection(o_x);
+
+  if (adaptive) {
+    platform->device.finish();
+    timeProjection += MPI_Wtime();
+  }
 }
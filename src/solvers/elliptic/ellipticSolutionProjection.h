@@ -41,17 +41,34 @@ public:
   SolutionProjection(elliptic_t& _elliptic,
                      const ProjectionType _type,
                      const dlong _maxNumVecsProjection = 8,
-                     const dlong _numTimeSteps = 5);
+                     const dlong _numTimeSteps = 5,
+                     const bool _adaptive = false);
   void pre(occa::memory& o_r);
   void post(occa::memory& o_x);
   dlong getNumVecsProjection() const { return numVecsProjection; }
   dlong getPrevNumVecsProjection() const { return prevNumVecsProjection; }
-  dlong getMaxNumVecsProjection() const { return maxNumVecsProjection; }
+  dlong getMaxNumVecsProjection() const { return activeMaxNumVecsProjection; }
+  bool isAdaptive() const { return adaptive; }
+  void printAdaptiveInfo() const;
 private:
   void computePreProjection(occa::memory& o_r);
   void computePostProjection(occa::memory& o_x);
   void updateProjectionSpace();
   void matvec(occa::memory& o_Ax, const dlong Ax_offset, const occa::memory& o_x, const dlong x_offset);
+
+  // adaptive sizing, see adaptProjectionSpace()
+  void sampleCost();
+  void adaptProjectionSpace();
+  const bool adaptive;
+  dlong activeMaxNumVecsProjection;
+  std::vector<double> gain; // log(res00Norm/res0Norm) for a given number of vectors
+  double timeVector;        // projection time per basis vector
+  double timeSolvePerLog;   // linear solver time per unit log residual reduction
+  double timeMarker;
+  double timeProjection;
+  double costPerSolve;      // modelled cost of the active space
+  int numSamples;
+
   const dlong maxNumVecsProjection;
   const dlong numTimeSteps;
   const ProjectionType type;
@@ -59,6 +76,7 @@ private:
   bool verbose;
 
   std::string solverName;
+  elliptic_t& elliptic;
 
   occa::memory o_xbar;
   occa::memory o_xx;
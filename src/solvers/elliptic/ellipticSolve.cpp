@@ -162,6 +162,7 @@ void ellipticSolve(elliptic_t* elliptic, const occa::memory& o_rhs, occa::memory
   }
 
   if(!options.compareArgs("SOLVER", "NONBLOCKING")) {
+    timer::scope_t scope(platform->timer, name + " linear solver");
     elliptic->resNorm = elliptic->res0Norm;
 
     if(options.compareArgs("SOLVER", "PCG")) {
@@ -38,16 +38,33 @@ void ellipticUpdateJacobi(elliptic_t *elliptic, occa::memory &o_invDiagA)
                 elliptic->ellipticBlockBuildDiagonalPfloatKernel :
                 elliptic->ellipticBlockBuildDiagonalKernel;
 
-  kernel(mesh->Nelements,
-         elliptic->Nfields,
-         elliptic->fieldOffset,
-         elliptic->loffset,
-         mesh->o_ggeo,
-         mesh->o_D,
-         mesh->o_DT,
-         elliptic->o_lambda0,
-         elliptic->o_lambda1,
-         o_invDiagA);
+  if (elliptic->batched) {
+    // field count of the block kernel is bounded, assemble one field at a time
+    for (int fld = 0; fld < elliptic->Nfields; fld++) {
+      auto o_diag = o_invDiagA + fld * elliptic->fieldOffset;
+      kernel(mesh->Nelements,
+             1,
+             elliptic->fieldOffset,
+             elliptic->loffset,
+             mesh->o_ggeo,
+             mesh->o_D,
+             mesh->o_DT,
+             elliptic->o_lambda0 + fld * elliptic->loffset,
+             elliptic->o_lambda1 + fld * elliptic->loffset,
+             o_diag);
+    }
+  } else {
+    kernel(mesh->Nelements,
+           elliptic->Nfields,
+           elliptic->fieldOffset,
+           elliptic->loffset,
+           mesh->o_ggeo,
+           mesh->o_D,
+           mesh->o_DT,
+           elliptic->o_lambda0,
+           elliptic->o_lambda1,
+           o_invDiagA);
+  }
 
   flopCount += 12 * mesh->Nq + 12;
   flopCount += (elliptic->poisson) ? 0.0 : 2.0;
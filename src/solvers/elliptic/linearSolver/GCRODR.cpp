@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <numeric>
+
+#include "elliptic.h"
+#include "linAlg.hpp"
+
+// GCRO-DR: flexible GMRES augmented with a recycled subspace U, C = A U (C orthonormal) which
+// survives restarts and subsequent solves. Each cycle runs Arnoldi on (I - C C^T) A M^{-1}
+//   A [U Z] = [C V] G,  G = | I  B  |
+//                           | 0  H  |
+// and replaces U, C by the harmonic Ritz vectors of G belonging to the k smallest harmonic
+// Ritz values. In the flexible setting [C V]^T [U Z] is approximated by the identity (see
+// FGMRES-DR, Giraud et al. 2010), i.e. the small eigenproblem does not need additional reductions.
+
+extern "C" {
+void dggev_(char *JOBVL,
+            char *JOBVR,
+            int *N,
+            double *A,
+            int *LDA,
+            double *B,
+            int *LDB,
+            double *ALPHAR,
+            double *ALPHAI,
+            double *BETA,
+            double *VL,
+            int *LDVL,
+            double *VR,
+            int *LDVR,
+            double *WORK,
+            int *LWORK,
+            int *INFO);
+}
+
+namespace {
+
+const dfloat tiny = 10 * std::numeric_limits<dfloat>::min();
+
+dfloat reduceScratch(elliptic_t *elliptic, int Nblock)
+{
+  auto gmresData = elliptic->gmresData;
+  const bool serial = platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP";
+
+  dfloat sum = 0;
+  if (serial) {
+    sum = *((dfloat *)gmresData->o_scratch.ptr());
+  } else {
+    gmresData->o_scratch.copyTo(gmresData->scratch, Nblock);
+    for (int n = 0; n < Nblock; ++n)
+      sum += gmresData->scratch[n];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+  return sum;
+}
+
+std::array<double, 2> operatorSignature(elliptic_t *elliptic)
+{
+  mesh_t *mesh = elliptic->mesh;
+  const dlong N = mesh->Nlocal;
+  auto &linAlg = *(platform->linAlg);
+
+  std::array<double, 2> sig = {0, 0};
+  for (int fld = 0; fld < elliptic->Nfields; ++fld) {
+    auto o_lambda0 = elliptic->o_lambda0 + fld * elliptic->loffset;
+    sig[0] += linAlg.innerProd(N, mesh->o_LMM, o_lambda0, platform->comm.mpiComm);
+    if (!elliptic->poisson) {
+      auto o_lambda1 = elliptic->o_lambda1 + fld * elliptic->loffset;
+      sig[1] += linAlg.innerProd(N, mesh->o_LMM, o_lambda1, platform->comm.mpiComm);
+    }
+  }
+  return sig;
+}
+
+// rebuild C = A U (and orthonormalize U accordingly) after the operator has changed
+void refreshRecycleSpace(elliptic_t *elliptic)
+{
+  mesh_t *mesh = elliptic->mesh;
+  auto gmresData = elliptic->gmresData;
+  auto &linAlg = *(platform->linAlg);
+
+  const int k = gmresData->nRecycleVectors;
+  const int kk = gmresData->nRecycled;
+  const auto offset = elliptic->fieldOffset * elliptic->Nfields;
+  const int Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  auto o_C = gmresData->o_CV + (k - kk) * offset;
+  auto &o_U = gmresData->o_U;
+  auto &o_coeffs = gmresData->o_coeffs;
+  auto coeffs = gmresData->coeffs;
+
+  for (int j = 0; j < kk; ++j) {
+    auto o_Cj = o_C + j * offset;
+    auto o_Uj = o_U + j * offset;
+    ellipticOperator(elliptic, static_cast<const occa::memory>(o_Uj), o_Cj, dfloatString);
+
+    if (j > 0) {
+      linAlg.weightedInnerProdMulti(mesh->Nlocal,
+                                    j,
+                                    elliptic->Nfields,
+                                    elliptic->fieldOffset,
+                                    elliptic->o_invDegree,
+                                    o_C,
+                                    o_Cj,
+                                    platform->comm.mpiComm,
+                                    coeffs);
+      o_coeffs.copyFrom(coeffs, j);
+    }
+
+    elliptic->gramSchmidtOrthogonalizationKernel(Nblock,
+                                                 mesh->Nlocal,
+                                                 elliptic->fieldOffset,
+                                                 j,
+                                                 elliptic->o_invDegree,
+                                                 o_coeffs,
+                                                 o_C,
+                                                 o_Cj,
+                                                 gmresData->o_scratch);
+    const dfloat nc = sqrt(reduceScratch(elliptic, Nblock));
+
+    if (j > 0) {
+      for (int l = 0; l < j; ++l)
+        coeffs[l] = -coeffs[l];
+      o_coeffs.copyFrom(coeffs, j);
+      elliptic->updatePGMRESSolutionKernel(mesh->Nlocal, elliptic->fieldOffset, j, o_coeffs, o_U, o_Uj);
+    }
+
+    if (nc < 100 * tiny) {
+      gmresData->nRecycled = 0;
+      return;
+    }
+
+    linAlg.axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->fieldOffset, 1 / nc, o_Cj, 0.0, o_Cj);
+    linAlg.axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->fieldOffset, 1 / nc, o_Uj, 0.0, o_Uj);
+  }
+}
+
+// x := x + U C^T r, r := r - C C^T r
+dfloat deflate(elliptic_t *elliptic, occa::memory &o_r, occa::memory &o_x)
+{
+  mesh_t *mesh = elliptic->mesh;
+  auto gmresData = elliptic->gmresData;
+
+  const int k = gmresData->nRecycleVectors;
+  const int kk = gmresData->nRecycled;
+  const auto offset = elliptic->fieldOffset * elliptic->Nfields;
+  const int Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  auto o_C = gmresData->o_CV + (k - kk) * offset;
+
+  platform->linAlg->weightedInnerProdMulti(mesh->Nlocal,
+                                           kk,
+                                           elliptic->Nfields,
+                                           elliptic->fieldOffset,
+                                           elliptic->o_invDegree,
+                                           o_C,
+                                           o_r,
+                                           platform->comm.mpiComm,
+                                           gmresData->coeffs);
+  gmresData->o_coeffs.copyFrom(gmresData->coeffs, kk);
+
+  elliptic->updatePGMRESSolutionKernel(mesh->Nlocal,
+                                       elliptic->fieldOffset,
+                                       kk,
+                                       gmresData->o_coeffs,
+                                       gmresData->o_U,
+                                       o_x);
+  elliptic->gramSchmidtOrthogonalizationKernel(Nblock,
+                                               mesh->Nlocal,
+                                               elliptic->fieldOffset,
+                                               kk,
+                                               elliptic->o_invDegree,
+                                               gmresData->o_coeffs,
+                                               o_C,
+                                               o_r,
+                                               gmresData->o_scratch);
+
+  {
+    double flopCount = 4 * kk * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+    platform->flopCounter->add("gcrodr deflate", flopCount);
+  }
+
+  return sqrt(reduceScratch(elliptic, Nblock));
+}
+
+// replace U, C by the harmonic Ritz vectors of the last cycle (mi Arnoldi steps)
+void updateRecycleSpace(elliptic_t *elliptic, int mi)
+{
+  mesh_t *mesh = elliptic->mesh;
+  auto gmresData = elliptic->gmresData;
+  auto &linAlg = *(platform->linAlg);
+
+  const int k = gmresData->nRecycleVectors;
+  const int kk = gmresData->nRecycled;
+  const int m = gmresData->nRestartVectors;
+  const int ld = m + 1;
+  const auto offset = elliptic->fieldOffset * elliptic->Nfields;
+
+  int n = kk + mi;
+  int ldG = n + 1;
+
+  std::vector<double> G(ldG * n, 0.0);
+  for (int c = 0; c < kk; ++c)
+    G[c + c * ldG] = 1;
+  for (int c = 0; c < mi; ++c) {
+    for (int l = 0; l < kk; ++l)
+      G[l + (kk + c) * ldG] = gmresData->B[l + c * k];
+    for (int l = 0; l <= c + 1; ++l)
+      G[kk + l + (kk + c) * ldG] = gmresData->Hraw[l + c * ld];
+  }
+
+  // G^T G p = theta G(0:n,0:n)^T p
+  std::vector<double> GtG(n * n, 0.0);
+  std::vector<double> GtopT(n * n);
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i < n; ++i) {
+      double sum = 0;
+      for (int l = 0; l < ldG; ++l)
+        sum += G[l + i * ldG] * G[l + j * ldG];
+      GtG[i + j * n] = sum;
+      GtopT[i + j * n] = G[j + i * ldG];
+    }
+  }
+
+  std::vector<double> alphar(n), alphai(n), beta(n), VR(n * n);
+  {
+    char JOBVL = 'N';
+    char JOBVR = 'V';
+    int LDVL = 1;
+    double VL;
+    int LWORK = -1;
+    int INFO;
+    double WORKSIZE;
+    dggev_(&JOBVL, &JOBVR, &n, GtG.data(), &n, GtopT.data(), &n, alphar.data(), alphai.data(), beta.data(),
+           &VL, &LDVL, VR.data(), &n, &WORKSIZE, &LWORK, &INFO);
+    LWORK = static_cast<int>(WORKSIZE);
+    std::vector<double> WORK(LWORK);
+    dggev_(&JOBVL, &JOBVR, &n, GtG.data(), &n, GtopT.data(), &n, alphar.data(), alphai.data(), beta.data(),
+           &VL, &LDVL, VR.data(), &n, WORK.data(), &LWORK, &INFO);
+    if (INFO != 0)
+      return;
+  }
+
+  std::vector<double> absTheta(n);
+  for (int j = 0; j < n; ++j) {
+    const double absAlpha = std::hypot(alphar[j], alphai[j]);
+    absTheta[j] = (std::abs(beta[j]) > 0) ? absAlpha / std::abs(beta[j]) : std::numeric_limits<double>::max();
+  }
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return absTheta[a] < absTheta[b]; });
+
+  // complex pairs contribute real and imaginary part
+  const int kTarget = std::min(k, n);
+  std::vector<double> P;
+  std::vector<bool> used(n, false);
+  int kn = 0;
+  for (auto &&j : order) {
+    if (kn == kTarget)
+      break;
+    if (used[j] || absTheta[j] == std::numeric_limits<double>::max())
+      continue;
+    if (alphai[j] == 0) {
+      P.insert(P.end(), VR.begin() + j * n, VR.begin() + (j + 1) * n);
+      used[j] = true;
+      kn++;
+    } else {
+      const int first = (alphai[j] > 0) ? j : j - 1;
+      used[first] = used[first + 1] = true;
+      if (kTarget - kn < 2)
+        continue;
+      P.insert(P.end(), VR.begin() + first * n, VR.begin() + (first + 2) * n);
+      kn += 2;
+    }
+  }
+  if (kn == 0)
+    return;
+
+  // G P = Q R, kn drops to the numerical rank if G P is rank deficient
+  const int ldR = kn;
+  std::vector<double> Q(ldG * ldR, 0.0);
+  std::vector<double> R(ldR * ldR, 0.0);
+  for (int j = 0; j < kn; ++j) {
+    for (int i = 0; i < ldG; ++i) {
+      double sum = 0;
+      for (int l = 0; l < n; ++l)
+        sum += G[i + l * ldG] * P[l + j * n];
+      Q[i + j * ldG] = sum;
+    }
+    for (int l = 0; l < j; ++l) {
+      double dot = 0;
+      for (int i = 0; i < ldG; ++i)
+        dot += Q[i + l * ldG] * Q[i + j * ldG];
+      R[l + j * ldR] = dot;
+      for (int i = 0; i < ldG; ++i)
+        Q[i + j * ldG] -= dot * Q[i + l * ldG];
+    }
+    double nrm = 0;
+    for (int i = 0; i < ldG; ++i)
+      nrm += Q[i + j * ldG] * Q[i + j * ldG];
+    nrm = sqrt(nrm);
+    if (nrm <= 1e-12 * std::max(R[0], nrm)) {
+      kn = j;
+      break;
+    }
+    R[j + j * ldR] = nrm;
+    for (int i = 0; i < ldG; ++i)
+      Q[i + j * ldG] /= nrm;
+  }
+  if (kn == 0)
+    return;
+
+  // P R^{-1}
+  std::vector<double> PR(n * kn);
+  for (int j = 0; j < kn; ++j) {
+    for (int i = 0; i < n; ++i) {
+      double sum = P[i + j * n];
+      for (int l = 0; l < j; ++l)
+        sum -= PR[i + l * n] * R[l + j * ldR];
+      PR[i + j * n] = sum / R[j + j * ldR];
+    }
+  }
+
+  // U = [U Z] P R^{-1}, C = [C V] Q
+  auto o_Unew = platform->o_memPool.reserve<dfloat>(kn * offset);
+  auto o_Cnew = platform->o_memPool.reserve<dfloat>(kn * offset);
+
+  auto coeffs = gmresData->coeffs;
+  auto &o_coeffs = gmresData->o_coeffs;
+  auto o_CVhat = gmresData->o_CV + (k - kk) * offset;
+
+  for (int j = 0; j < kn; ++j) {
+    for (int i = 0; i < ldG; ++i)
+      coeffs[i + j * ldG] = Q[i + j * ldG];
+  }
+  o_coeffs.copyFrom(coeffs, ldG * kn);
+  linAlg.fill(kn * offset, 0.0, o_Cnew);
+  for (int j = 0; j < kn; ++j) {
+    auto o_Cj = o_Cnew + j * offset;
+    elliptic->updatePGMRESSolutionKernel(mesh->Nlocal, elliptic->fieldOffset, ldG, o_coeffs + j * ldG, o_CVhat, o_Cj);
+  }
+
+  for (int j = 0; j < kn; ++j) {
+    for (int i = 0; i < n; ++i)
+      coeffs[i + j * n] = PR[i + j * n];
+  }
+  o_coeffs.copyFrom(coeffs, n * kn);
+  linAlg.fill(kn * offset, 0.0, o_Unew);
+  for (int j = 0; j < kn; ++j) {
+    auto o_Uj = o_Unew + j * offset;
+    if (kk)
+      elliptic->updatePGMRESSolutionKernel(mesh->Nlocal, elliptic->fieldOffset, kk, o_coeffs + j * n, gmresData->o_U, o_Uj);
+    elliptic->updatePGMRESSolutionKernel(mesh->Nlocal,
+                                         elliptic->fieldOffset,
+                                         mi,
+                                         o_coeffs + j * n + kk,
+                                         gmresData->o_Z,
+                                         o_Uj);
+  }
+
+  gmresData->o_U.copyFrom(o_Unew, kn * offset);
+  gmresData->o_CV.copyFrom(o_Cnew, kn * offset, (k - kn) * offset);
+  gmresData->nRecycled = kn;
+
+  o_Unew.free();
+  o_Cnew.free();
+
+  {
+    double flopCount = 2 * kn * (n + ldG) * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+    platform->flopCounter->add("gcrodr update recycle space", flopCount);
+  }
+}
+
+void applyGivens(GmresData *gmresData, int i)
+{
+  const int ld = gmresData->nRestartVectors + 1;
+  dfloat *H = gmresData->H;
+  dfloat *cs = gmresData->cs;
+  dfloat *sn = gmresData->sn;
+  dfloat *s = gmresData->s;
+
+  for (int k = 0; k <= i + 1; ++k)
+    H[k + i * ld] = gmresData->Hraw[k + i * ld];
+
+  for (int k = 0; k < i; ++k) {
+    const dfloat h1 = H[k + i * ld];
+    const dfloat h2 = H[k + 1 + i * ld];
+
+    H[k + i * ld] = cs[k] * h1 + sn[k] * h2;
+    H[k + 1 + i * ld] = -sn[k] * h1 + cs[k] * h2;
+  }
+
+  const dfloat h1 = H[i + i * ld];
+  const dfloat h2 = H[i + 1 + i * ld];
+  const dfloat hr = sqrt(h1 * h1 + h2 * h2) + tiny;
+  cs[i] = h1 / hr;
+  sn[i] = h2 / hr;
+
+  H[i + i * ld] = cs[i] * h1 + sn[i] * h2;
+  H[i + 1 + i * ld] = 0;
+
+  s[i + 1] = -sn[i] * s[i];
+  s[i] = cs[i] * s[i];
+}
+
+} // namespace
+
+// Ax=r
+int gcrodr(elliptic_t *elliptic,
+           const dfloat tol,
+           const int MAXIT,
+           dfloat &rdotr,
+           occa::memory &o_r,
+           occa::memory &o_x)
+{
+  mesh_t *mesh = elliptic->mesh;
+  auto gmresData = elliptic->gmresData;
+  linAlg_t &linAlg = *(platform->linAlg);
+
+  const int m = gmresData->nRestartVectors;
+  const int k = gmresData->nRecycleVectors;
+  const int ld = m + 1;
+  const bool verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+
+  const auto offset = elliptic->fieldOffset * elliptic->Nfields;
+  const int Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  gmresData->o_Z = platform->o_memPool.reserve<dfloat>(static_cast<size_t>(offset) * m);
+
+  auto &o_w = elliptic->o_p;
+  auto &o_Ax = elliptic->o_Ap;
+  auto &o_Z = gmresData->o_Z;
+  auto &o_coeffs = gmresData->o_coeffs;
+  auto &o_weight = elliptic->o_invDegree;
+  auto o_V = gmresData->o_CV + k * offset;
+
+  auto &o_b = elliptic->o_z;
+  o_b.copyFrom(o_r, offset);
+
+  auto s = gmresData->s;
+  auto coeffs = gmresData->coeffs;
+
+  if (gmresData->nRecycled) {
+    const auto signature = operatorSignature(elliptic);
+    if (platform->options.compareArgs("MOVING MESH", "TRUE") || signature != gmresData->recycleSignature) {
+      refreshRecycleSpace(elliptic);
+    }
+    gmresData->recycleSignature = signature;
+  } else {
+    gmresData->recycleSignature = operatorSignature(elliptic);
+  }
+
+  if (verbose && (platform->comm.mpiRank == 0)) {
+    printf("PFGMRES+RECYCLE ");
+    printf("%s: initial res norm %.15e WE NEED TO GET TO %e (recycled %d)\n",
+           elliptic->name.c_str(),
+           rdotr,
+           tol,
+           gmresData->nRecycled);
+  }
+
+  dfloat nr = rdotr / sqrt(elliptic->resNormFactor);
+  dfloat error = rdotr;
+  const dfloat TOL = tol;
+  std::vector<dfloat> y(k + m + 1);
+
+  int iter = 0;
+  while (iter < MAXIT) {
+    const int kk = gmresData->nRecycled;
+    auto o_CV = gmresData->o_CV + (k - kk) * offset;
+
+    if (kk) {
+      nr = deflate(elliptic, o_r, o_x);
+      error = nr * sqrt(elliptic->resNormFactor);
+      rdotr = error;
+      if (error < TOL)
+        break;
+    }
+
+    s[0] = nr;
+
+    // V(:,0) = r/nr
+    linAlg.axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->fieldOffset, 1. / (nr + tiny), o_r, 0.0, o_V);
+
+    bool done = false;
+    int mi = 0;
+    for (int i = 0; i < m; ++i) {
+      auto o_Zi = o_Z + i * offset;
+
+      // z := M^{-1} V(:,i)
+      ellipticPreconditioner(elliptic, o_V + i * offset, o_Zi);
+
+      // w := A z
+      ellipticOperator(elliptic, static_cast<const occa::memory>(o_Zi), o_w, dfloatString);
+
+      // orthogonalize against [C V(:,0:i)] with a single reduction for all inner products
+      const int nBasis = kk + i + 1;
+      linAlg.weightedInnerProdMulti(mesh->Nlocal,
+                                    nBasis,
+                                    elliptic->Nfields,
+                                    elliptic->fieldOffset,
+                                    o_weight,
+                                    o_CV,
+                                    o_w,
+                                    platform->comm.mpiComm,
+                                    y.data());
+      o_coeffs.copyFrom(y.data(), nBasis);
+
+      elliptic->gramSchmidtOrthogonalizationKernel(Nblock,
+                                                   mesh->Nlocal,
+                                                   elliptic->fieldOffset,
+                                                   nBasis,
+                                                   o_weight,
+                                                   o_coeffs,
+                                                   o_CV,
+                                                   o_w,
+                                                   gmresData->o_scratch);
+      const dfloat nw = sqrt(reduceScratch(elliptic, Nblock));
+
+      {
+        double flopCount = 5 * nBasis * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+        platform->flopCounter->add("gramSchmidt", flopCount);
+      }
+
+      for (int l = 0; l < kk; ++l)
+        gmresData->B[l + i * k] = y[l];
+      for (int l = 0; l <= i; ++l)
+        gmresData->Hraw[l + i * ld] = y[kk + l];
+      gmresData->Hraw[i + 1 + i * ld] = nw;
+
+      // V(:,i+1) = w/nw, the last one is needed for the recycle space update
+      auto o_Vi = o_V + (i + 1) * offset;
+      linAlg.axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->fieldOffset, 1. / (nw + tiny), o_w, 0.0, o_Vi);
+
+      applyGivens(gmresData, i);
+
+      iter++;
+      mi = i + 1;
+      error = fabs(s[i + 1]) * sqrt(elliptic->resNormFactor);
+      rdotr = error;
+
+      if (platform->comm.mpiRank == 0)
+        nrsCheck(std::isnan(error),
+                 MPI_COMM_SELF,
+                 EXIT_FAILURE,
+                 "%s\n",
+                 "Detected invalid resiual norm while running linear solver!");
+
+      if (verbose && (platform->comm.mpiRank == 0))
+        printf("it %d r norm %.15e\n", iter, rdotr);
+
+      if (error < TOL || iter == MAXIT) {
+        done = true;
+        break;
+      }
+    }
+
+    // x := x + Z y - U B y
+    for (int l = mi - 1; l >= 0; --l) {
+      y[l] = s[l];
+      for (int j = l + 1; j < mi; ++j)
+        y[l] -= gmresData->H[l + j * ld] * y[j];
+      y[l] /= (gmresData->H[l + l * ld] + tiny);
+    }
+    for (int l = 0; l < kk; ++l) {
+      coeffs[mi + l] = 0;
+      for (int j = 0; j < mi; ++j)
+        coeffs[mi + l] -= gmresData->B[l + j * k] * y[j];
+    }
+    std::copy(y.begin(), y.begin() + mi, coeffs);
+    o_coeffs.copyFrom(coeffs, mi + kk);
+
+    elliptic->updatePGMRESSolutionKernel(mesh->Nlocal, elliptic->fieldOffset, mi, o_coeffs, o_Z, o_x);
+    if (kk)
+      elliptic->updatePGMRESSolutionKernel(mesh->Nlocal, elliptic->fieldOffset, kk, o_coeffs + mi, gmresData->o_U, o_x);
+
+    {
+      double flopCount = 2 * (mi + kk) * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+      platform->flopCounter->add("gmresUpdate", flopCount);
+    }
+
+    if (k)
+      updateRecycleSpace(elliptic, mi);
+
+    if (done)
+      break;
+
+    // restart with the true residual
+    ellipticOperator(elliptic, o_x, o_Ax, dfloatString);
+
+    elliptic->fusedResidualAndNormKernel(Nblock,
+                                         mesh->Nlocal,
+                                         elliptic->fieldOffset,
+                                         elliptic->o_invDegree,
+                                         o_b,
+                                         o_Ax,
+                                         o_r,
+                                         gmresData->o_scratch);
+    nr = sqrt(reduceScratch(elliptic, Nblock));
+
+    {
+      double flopCount = 4 * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+      platform->flopCounter->add("gmres evaluate residual and norm", flopCount);
+    }
+
+    error = nr * sqrt(elliptic->resNormFactor);
+    rdotr = error;
+    if (error <= TOL)
+      break;
+  }
+
+  o_Z.free();
+  return iter;
+}
@@ -26,6 +26,7 @@
 
 #include <limits>
 #include <array>
+#include <algorithm>
 #include "elliptic.h"
 #include "ellipticPrecon.h"
 #include "timer.hpp"
@@ -386,6 +387,357 @@ static int combinedPCG(elliptic_t *elliptic,
   return iter;
 }
 
+// copies the block partials to the host and starts their global sum
+static void startPipelinedPCGReductions(elliptic_t *elliptic,
+                                        std::array<dfloat, PipelinedPCGId::nReduction> &reductions,
+                                        MPI_Request &request)
+{
+  constexpr auto nRed = PipelinedPCGId::nReduction;
+  auto mesh = elliptic->mesh;
+
+  if (platform->serial) {
+    auto ptr = elliptic->o_tmpHostScalars.ptr<dfloat>();
+    std::copy(ptr, ptr + nRed, reductions.begin());
+  } else {
+    const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+    elliptic->o_tmpHostScalars.copyTo(elliptic->tmpHostScalars, nRed * Nblock);
+    std::fill(reductions.begin(), reductions.end(), 0.0);
+    for (int red = 0; red < nRed; ++red) {
+      for (int n = 0; n < Nblock; ++n) {
+        reductions[red] += elliptic->tmpHostScalars[n + Nblock * red];
+      }
+    }
+  }
+
+  MPI_Iallreduce(MPI_IN_PLACE, reductions.data(), nRed, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm, &request);
+}
+
+// Alg. 4 from Ghysels and Vanroose, Parallel Computing 40 (2014)
+// the global reduction of iteration i is hidden behind m = M w and n = A m
+static int pipelinedPCG(elliptic_t *elliptic,
+                        const dfloat tol,
+                        const int MAXIT,
+                        dfloat &rdotr,
+                        occa::memory &o_r,
+                        occa::memory &o_x)
+{
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  const int verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+
+  // recurrences drift from the true residual, recompute it periodically
+  int replacementInterval = 0;
+  options.getArgs("PCG RESIDUAL REPLACEMENT", replacementInterval);
+
+  constexpr auto tiny = 10 * std::numeric_limits<dfloat>::min();
+  const dlong Nlocal = elliptic->Nfields * elliptic->fieldOffset;
+
+  /*aux variables */
+  auto &o_p = elliptic->o_p;
+  auto &o_z = elliptic->o_z;
+  auto &o_n = elliptic->o_Ap;
+  auto &o_u = elliptic->o_pipelinedPCG[0];
+  auto &o_w = elliptic->o_pipelinedPCG[1];
+  auto &o_s = elliptic->o_pipelinedPCG[2];
+  auto &o_q = elliptic->o_pipelinedPCG[3];
+  auto &o_m = elliptic->o_pipelinedPCG[4];
+  auto &o_b = elliptic->o_pipelinedPCG[5];
+  auto &o_weight = elliptic->o_invDegree;
+
+  // initial guess is zero, r is the right hand side
+  o_b.copyFrom(o_r, Nlocal);
+  for (auto o_work : {o_p, o_z, o_s, o_q})
+    platform->linAlg->fill(Nlocal, 0.0, o_work);
+
+  auto computeReductions = [&]() {
+    elliptic->pipelinedPCGReductionsKernel(mesh->Nlocal,
+                                           elliptic->fieldOffset,
+                                           o_weight,
+                                           o_r,
+                                           o_u,
+                                           o_w,
+                                           elliptic->o_tmpHostScalars);
+  };
+
+  ellipticPreconditioner(elliptic, o_r, o_u);
+  ellipticOperator(elliptic, o_u, o_w, dfloatString);
+  computeReductions();
+
+  if (platform->comm.mpiRank == 0 && verbose) {
+    printf("PPCG ");
+    printf("%s: initial res norm %.15e WE NEED TO GET TO %e \n", elliptic->name.c_str(), rdotr, tol);
+  }
+
+  dfloat alpha = 0;
+  dfloat gammaPrev = 0;
+
+  int iter = 0;
+  while (true) {
+    std::array<dfloat, PipelinedPCGId::nReduction> reductions;
+    MPI_Request request;
+    startPipelinedPCGReductions(elliptic, reductions, request);
+
+    ellipticPreconditioner(elliptic, o_w, o_m);
+    ellipticOperator(elliptic, o_m, o_n, dfloatString);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    const auto gamma = reductions[PipelinedPCGId::gamma];
+    const auto delta = reductions[PipelinedPCGId::delta];
+
+    rdotr = sqrt(reductions[PipelinedPCGId::rdotr] * elliptic->resNormFactor);
+#ifdef DEBUG
+    printf("rdotr: %.15e\n", rdotr);
+#endif
+    if (platform->comm.mpiRank == 0) {
+      nrsCheck(std::isnan(rdotr),
+               MPI_COMM_SELF,
+               EXIT_FAILURE,
+               "%s\n",
+               "Detected invalid resiual norm while running linear solver!");
+    }
+    if (iter > 0 && verbose && (platform->comm.mpiRank == 0)) {
+      printf("it %d r norm %.15e\n", iter, rdotr);
+    }
+
+    if (rdotr <= tol || iter >= MAXIT)
+      break;
+
+    iter++;
+
+    dfloat beta = 0;
+    if (iter > 1) {
+      beta = gamma / gammaPrev;
+      alpha = gamma / (delta - beta * gamma / alpha + tiny);
+    } else {
+      alpha = gamma / (delta + tiny);
+    }
+    gammaPrev = gamma;
+
+#ifdef DEBUG
+    printf("alpha: %.15e\n", alpha);
+    printf("beta: %.15e\n", beta);
+#endif
+
+#ifdef TIMERS
+    platform->timer.tic("pipelinedPCGUpdate", 1);
+#endif
+    elliptic->pipelinedPCGUpdateKernel(mesh->Nlocal,
+                                       elliptic->fieldOffset,
+                                       alpha,
+                                       beta,
+                                       o_weight,
+                                       o_m,
+                                       o_n,
+                                       o_z,
+                                       o_q,
+                                       o_s,
+                                       o_p,
+                                       o_x,
+                                       o_r,
+                                       o_u,
+                                       o_w,
+                                       elliptic->o_tmpHostScalars);
+#ifdef TIMERS
+    platform->timer.toc("pipelinedPCGUpdate");
+#endif
+
+    platform->flopCounter->add(elliptic->name + " pipelinedPCGUpdate",
+                               elliptic->Nfields * static_cast<double>(mesh->Nlocal) * 22 + 3 * mesh->Nlocal);
+
+    // residual replacement, r = b - A x, u = M r, w = A u, s = A p, q = M s, z = A q
+    if (replacementInterval > 0 && iter % replacementInterval == 0) {
+      ellipticOperator(elliptic, o_x, o_n, dfloatString);
+      platform->linAlg->axpbyzMany(mesh->Nlocal,
+                                   elliptic->Nfields,
+                                   elliptic->fieldOffset,
+                                   -1.0,
+                                   o_n,
+                                   1.0,
+                                   o_b,
+                                   o_r);
+      if (elliptic->allNeumann)
+        ellipticZeroMean(elliptic, o_r);
+
+      ellipticPreconditioner(elliptic, o_r, o_u);
+      ellipticOperator(elliptic, o_u, o_w, dfloatString);
+      ellipticOperator(elliptic, o_p, o_s, dfloatString);
+      ellipticPreconditioner(elliptic, o_s, o_q);
+      ellipticOperator(elliptic, o_q, o_z, dfloatString);
+      computeReductions();
+    }
+  }
+
+  return iter;
+}
+
+// Nfields independent PCG iterations sharing operator application, gather-scatter and
+// global reductions. Converged fields are frozen by zero step lengths.
+static int batchedPCG(elliptic_t *elliptic,
+                      const dfloat tol,
+                      const int MAXIT,
+                      dfloat &rdotr,
+                      occa::memory &o_r,
+                      occa::memory &o_x)
+{
+  mesh_t *mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+  const bool serial = platform->serial;
+  const int verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+
+  const int Nfields = elliptic->Nfields;
+  const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  auto &o_p = elliptic->o_p;
+  auto &o_z = (!options.compareArgs("PRECONDITIONER", "NONE")) ? elliptic->o_z : o_r;
+  auto &o_Ap = elliptic->o_Ap;
+  auto &o_weight = elliptic->o_invDegree;
+  auto &o_coeffs = elliptic->o_batchedPCGCoeffs;
+
+  // sum block partials and batch all fields into a single all-reduce
+  auto reduce = [&](std::vector<dfloat> &reductions) {
+    if (serial) {
+      auto ptr = elliptic->o_tmpHostScalars.ptr<dfloat>();
+      std::copy(ptr, ptr + Nfields, reductions.begin());
+    } else {
+      elliptic->o_tmpHostScalars.copyTo(elliptic->tmpHostScalars, Nfields * Nblock);
+      std::fill(reductions.begin(), reductions.end(), 0.0);
+      for (int fld = 0; fld < Nfields; ++fld) {
+        for (int n = 0; n < Nblock; ++n) {
+          reductions[fld] += elliptic->tmpHostScalars[n + Nblock * fld];
+        }
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, reductions.data(), Nfields, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+  };
+
+  auto innerProd = [&](const occa::memory &o_a, const occa::memory &o_b, std::vector<dfloat> &reductions) {
+    elliptic->batchedPCGInnerProdKernel(Nblock,
+                                        mesh->Nlocal,
+                                        elliptic->fieldOffset,
+                                        o_weight,
+                                        o_a,
+                                        o_b,
+                                        elliptic->o_tmpHostScalars);
+    reduce(reductions);
+    platform->flopCounter->add(elliptic->name + " batchedPCGInnerProd",
+                               3 * Nfields * static_cast<double>(mesh->Nlocal));
+  };
+
+  std::vector<dfloat> rdotz(Nfields), rdotzPrev(Nfields), pAp(Nfields), rdotrField(Nfields);
+  std::vector<dfloat> alpha(Nfields), beta(Nfields), tolField(Nfields);
+  std::vector<int> active(Nfields, 1);
+
+  elliptic->NiterField.assign(Nfields, 0);
+  elliptic->res0NormField.resize(Nfields);
+  elliptic->resNormField.resize(Nfields);
+
+  // per field tolerances follow the same rules as for a single field
+  innerProd(o_r, o_r, rdotrField);
+  for (int fld = 0; fld < Nfields; ++fld) {
+    const dfloat res0Norm = sqrt(rdotrField[fld] * elliptic->resNormFactor);
+    elliptic->res0NormField[fld] = res0Norm;
+    elliptic->resNormField[fld] = res0Norm;
+
+    dfloat absTol = 1e-6;
+    options.getArgs("SOLVER TOLERANCE", absTol);
+    tolField[fld] = absTol;
+    if (!options.getArgs("SOLVER RELATIVE TOLERANCE").empty()) {
+      dfloat relTol;
+      options.getArgs("SOLVER RELATIVE TOLERANCE", relTol);
+      tolField[fld] = std::max(relTol * res0Norm, absTol);
+    } else if (options.compareArgs("LINEAR SOLVER STOPPING CRITERION", "RELATIVE")) {
+      tolField[fld] *= res0Norm;
+    }
+
+    active[fld] = res0Norm > tolField[fld];
+  }
+
+  platform->linAlg->fill(Nfields * elliptic->fieldOffset, 0.0, o_p);
+
+  if (platform->comm.mpiRank == 0 && verbose) {
+    printf("PCG+BATCHED %s: initial res norm %.15e WE NEED TO GET TO %e \n", elliptic->name.c_str(), rdotr, tol);
+  }
+
+  auto anyActive = [&]() { return std::any_of(active.begin(), active.end(), [](int a) { return a; }); };
+
+  int iter = 0;
+  while (anyActive() && iter < MAXIT) {
+    iter++;
+    rdotzPrev = rdotz;
+
+    if (!options.compareArgs("PRECONDITIONER", "NONE")) {
+      ellipticPreconditioner(elliptic, o_r, o_z);
+      innerProd(o_r, o_z, rdotz);
+    } else {
+      rdotz = rdotrField;
+    }
+
+    for (int fld = 0; fld < Nfields; ++fld)
+      beta[fld] = (iter > 1 && active[fld]) ? rdotz[fld] / rdotzPrev[fld] : 0;
+
+    o_coeffs.copyFrom(beta.data(), Nfields);
+    elliptic->batchedPCGUpdatePKernel(mesh->Nlocal, elliptic->fieldOffset, o_coeffs, o_z, o_p);
+
+    ellipticOperator(elliptic, o_p, o_Ap, dfloatString);
+    innerProd(o_p, o_Ap, pAp);
+
+    for (int fld = 0; fld < Nfields; ++fld)
+      alpha[fld] = (active[fld]) ? rdotz[fld] / (pAp[fld] + 10 * std::numeric_limits<dfloat>::min()) : 0;
+
+    //  x <= x + alpha*p
+    //  r <= r - alpha*A*p
+    //  dot(r,r)
+    o_coeffs.copyFrom(alpha.data(), Nfields);
+    elliptic->batchedPCGUpdateKernel(Nblock,
+                                     mesh->Nlocal,
+                                     elliptic->fieldOffset,
+                                     o_weight,
+                                     o_coeffs,
+                                     o_p,
+                                     o_Ap,
+                                     o_x,
+                                     o_r,
+                                     elliptic->o_tmpHostScalars);
+    reduce(rdotrField);
+    platform->flopCounter->add(elliptic->name + " batchedPCGUpdate",
+                               Nfields * static_cast<double>(mesh->Nlocal) * 7);
+
+    rdotr = 0;
+    for (int fld = 0; fld < Nfields; ++fld) {
+      if (!active[fld])
+        continue;
+
+      const dfloat resNorm = sqrt(rdotrField[fld] * elliptic->resNormFactor);
+      elliptic->resNormField[fld] = resNorm;
+      elliptic->NiterField[fld] = iter;
+      rdotr = std::max(rdotr, resNorm);
+      if (resNorm <= tolField[fld])
+        active[fld] = 0;
+    }
+
+    if (platform->comm.mpiRank == 0) {
+      nrsCheck(std::isnan(rdotr),
+               MPI_COMM_SELF,
+               EXIT_FAILURE,
+               "%s\n",
+               "Detected invalid resiual norm while running linear solver!");
+    }
+
+    if (verbose && (platform->comm.mpiRank == 0)) {
+      printf("it %d r norm %.15e (%d active fields)\n",
+             iter,
+             rdotr,
+             static_cast<int>(std::count(active.begin(), active.end(), 1)));
+    }
+  }
+
+  rdotr = *std::max_element(elliptic->resNormField.begin(), elliptic->resNormField.end());
+
+  return iter;
+}
+
 int pcg(elliptic_t *elliptic,
         const dfloat tol,
         const int MAXIT,
@@ -394,8 +746,12 @@ int pcg(elliptic_t *elliptic,
         occa::memory &o_x)
 {
   setupAide &options = elliptic->options;
-  if (options.compareArgs("SOLVER", "PCG+COMBINED")) {
+  if (elliptic->batched) {
+    return batchedPCG(elliptic, tol, MAXIT, rdotr, o_r, o_x);
+  } else if (options.compareArgs("SOLVER", "PCG+COMBINED")) {
     return combinedPCG(elliptic, tol, MAXIT, rdotr, o_r, o_x);
+  } else if (options.compareArgs("SOLVER", "PCG+PIPELINED")) {
+    return pipelinedPCG(elliptic, tol, MAXIT, rdotr, o_r, o_x);
   } else {
     return standardPCG(elliptic, tol, MAXIT, rdotr, o_r, o_x);
   }
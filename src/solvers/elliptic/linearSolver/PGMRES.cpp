@@ -44,8 +44,12 @@ GmresData::GmresData(elliptic_t *elliptic)
 {
   tiny = 10*std::numeric_limits<dfloat>::min();
 
+  const bool lowSync = elliptic->options.compareArgs("SOLVER", "LOWSYNC");
+  const bool recycle = elliptic->options.compareArgs("SOLVER", "RECYCLE");
+
   int Nblock = (elliptic->mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
-  const size_t N = nRestartVectors * Nblock;
+  // low-synch variant reduces 2j+3 values per iteration j
+  const size_t N = ((lowSync) ? 2 * nRestartVectors + 3 : nRestartVectors) * Nblock;
   {
     h_scratch = platform->device.mallocHost<dfloat>(N);
     scratch = (dfloat *)h_scratch.ptr();
@@ -54,6 +58,31 @@ GmresData::GmresData(elliptic_t *elliptic)
     y = (dfloat *)h_y.ptr();
   }
   o_scratch = platform->device.malloc<dfloat>(N);
+
+  coeffs = nullptr;
+  Hraw = nullptr;
+  if (lowSync) {
+    o_coeffs = platform->device.malloc<dfloat>(2 * nRestartVectors + 1);
+    coeffs = (dfloat *)calloc(2 * nRestartVectors + 1, sizeof(dfloat));
+    Hraw = (dfloat *)calloc((nRestartVectors + 1) * (nRestartVectors + 1), sizeof(dfloat));
+  }
+
+  nRecycleVectors = 0;
+  nRecycled = 0;
+  B = nullptr;
+  recycleSignature = {0, 0};
+  if (recycle) {
+    elliptic->options.getArgs("PGMRES RECYCLE DIMENSION", nRecycleVectors);
+    const int nVectors = nRecycleVectors + nRestartVectors + 1;
+    const size_t offset = static_cast<size_t>(elliptic->fieldOffset) * elliptic->Nfields;
+
+    o_U = platform->device.malloc<dfloat>(nRecycleVectors * offset);
+    o_CV = platform->device.malloc<dfloat>(nVectors * offset);
+    o_coeffs = platform->device.malloc<dfloat>(nVectors * std::max(nRecycleVectors, 1));
+    coeffs = (dfloat *)calloc(nVectors * std::max(nRecycleVectors, 1), sizeof(dfloat));
+    Hraw = (dfloat *)calloc((nRestartVectors + 1) * (nRestartVectors + 1), sizeof(dfloat));
+    B = (dfloat *)calloc(std::max(nRecycleVectors, 1) * nRestartVectors, sizeof(dfloat));
+  }
 }
 
 void initializeGmresData(elliptic_t *elliptic)
@@ -110,6 +139,334 @@ void free(elliptic_t *elliptic)
   elliptic->gmresData->o_Z.free();
 }
 
+namespace {
+// copy column i of the unrotated Hessenberg matrix, apply the previous rotations,
+// form the i-th rotation and update the residual vector entries s(i), s(i+1)
+void applyGivens(GmresData *gmresData, int i)
+{
+  const int ld = gmresData->nRestartVectors + 1;
+  dfloat *H = gmresData->H;
+  dfloat *Hraw = gmresData->Hraw;
+  dfloat *cs = gmresData->cs;
+  dfloat *sn = gmresData->sn;
+  dfloat *s = gmresData->s;
+
+  for (int k = 0; k <= i + 1; ++k)
+    H[k + i * ld] = Hraw[k + i * ld];
+
+  for (int k = 0; k < i; ++k) {
+    const dfloat h1 = H[k + i * ld];
+    const dfloat h2 = H[k + 1 + i * ld];
+
+    H[k + i * ld] = cs[k] * h1 + sn[k] * h2;
+    H[k + 1 + i * ld] = -sn[k] * h1 + cs[k] * h2;
+  }
+
+  const dfloat h1 = H[i + i * ld];
+  const dfloat h2 = H[i + 1 + i * ld];
+  const dfloat hr = sqrt(h1 * h1 + h2 * h2) + tiny;
+  cs[i] = h1 / hr;
+  sn[i] = h2 / hr;
+
+  H[i + i * ld] = cs[i] * h1 + sn[i] * h2;
+  H[i + 1 + i * ld] = 0;
+
+  s[i + 1] = -sn[i] * s[i];
+  s[i] = cs[i] * s[i];
+}
+
+// one-reduce Arnoldi (DCGS2 with lagged normalization and reorthogonalization)
+// iteration j computes all inner products involving the unnormalized candidate u = V(:,j)
+// and w = A M^{-1} u in a single global reduction. The second Gram-Schmidt pass and the
+// norm of u are therefore only available one iteration later, i.e. column j-1 of the
+// Hessenberg matrix is corrected after the fact and column j is estimated from the
+// identities below (weighted inner products, Q = V(:,0:j-1) orthonormal)
+//   a = Q'u, c = Q'w, beta = ||u - Qa||, v = (u - Qa)/beta
+//   A M^{-1} v = (w - V g)/beta with g = Hraw(0:j,0:j-1) a
+// The last column of a cycle, or the one whose estimate meets the tolerance, gets its
+// correction from one extra reduction. Convergence is decided on the corrected column.
+int lowSyncPgmres(elliptic_t *elliptic,
+                  const dfloat tol,
+                  const int MAXIT,
+                  dfloat &rdotr,
+                  occa::memory &o_r,
+                  occa::memory &o_x)
+{
+  mesh_t *mesh = elliptic->mesh;
+  auto gmresData = elliptic->gmresData;
+
+  const int nRestartVectors = gmresData->nRestartVectors;
+  const int ld = nRestartVectors + 1;
+  const bool verbose = platform->options.compareArgs("VERBOSE", "TRUE");
+  const bool serial = platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP";
+  const int flexible = elliptic->options.compareArgs("SOLVER", "FLEXIBLE");
+
+  // one extra column for the candidate correcting the last Hessenberg column
+  gmresData->o_V = platform->o_memPool.reserve<dfloat>(static_cast<size_t>(elliptic->fieldOffset) * elliptic->Nfields * (nRestartVectors + 1));
+  gmresData->o_Z = platform->o_memPool.reserve<dfloat>(static_cast<size_t>(elliptic->fieldOffset) * elliptic->Nfields * ((flexible) ? nRestartVectors : 1));
+
+  auto &o_w = elliptic->o_p;
+  auto &o_Ax = elliptic->o_Ap;
+  auto &o_V = gmresData->o_V;
+  auto &o_Z = gmresData->o_Z;
+  auto &o_weight = elliptic->o_invDegree;
+  auto &o_coeffs = gmresData->o_coeffs;
+
+  auto &o_b = elliptic->o_z;
+  o_b.copyFrom(o_r, elliptic->fieldOffset * elliptic->Nfields);
+
+  auto H = gmresData->H;
+  auto Hraw = gmresData->Hraw;
+  auto s = gmresData->s;
+  auto coeffs = gmresData->coeffs;
+  auto scratch = gmresData->scratch;
+
+  const auto offset = elliptic->fieldOffset * elliptic->Nfields;
+  const int Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+
+  std::vector<dfloat> red(2 * nRestartVectors + 3);
+  std::vector<dfloat> g(nRestartVectors + 1);
+  std::vector<dfloat> h(nRestartVectors + 1);
+
+  // all inner products of step j, see lowSyncGMRESReductions
+  auto reduce = [&](int j, occa::memory &o_x) {
+    const int nRed = 2 * j + 3;
+    elliptic->lowSyncGMRESReductionsKernel(Nblock,
+                                           mesh->Nlocal,
+                                           elliptic->fieldOffset,
+                                           j,
+                                           o_weight,
+                                           o_V,
+                                           o_x,
+                                           gmresData->o_scratch);
+    if (serial) {
+      gmresData->o_scratch.copyTo(red.data(), nRed);
+    } else {
+      gmresData->o_scratch.copyTo(scratch, nRed * Nblock);
+      for (int v = 0; v < nRed; ++v) {
+        red[v] = 0;
+        for (int k = 0; k < Nblock; ++k)
+          red[v] += scratch[k + v * Nblock];
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, red.data(), nRed, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+
+    double flopCount = 2 * nRed * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+    platform->flopCounter->add("lowSyncGMRESReductions", flopCount);
+  };
+
+  dfloat error = rdotr;
+  const dfloat TOL = tol;
+
+  if (verbose && (platform->comm.mpiRank == 0)) {
+    if (flexible)
+      printf("PFGMRES+LOWSYNC ");
+    else
+      printf("PGMRES+LOWSYNC ");
+    printf("%s: initial res norm %.15e WE NEED TO GET TO %e \n", elliptic->name.c_str(), rdotr, tol);
+  }
+
+  int iter = 0;
+
+  for (iter = 0; iter < MAXIT;) {
+
+    // V(:,0) = r, normalized in the first iteration
+    o_V.copyFrom(o_r, offset);
+
+    bool done = false;
+    bool corrected = false;
+    dfloat sTentative = 0;
+
+    for (int j = 0; j < nRestartVectors; ++j) {
+
+      auto o_Mv = flexible ? o_Z + j * offset : o_Z;
+      // z := M^{-1} V(:,j)
+      ellipticPreconditioner(elliptic, o_V + j * offset, o_Mv);
+
+      // w := A z
+      ellipticOperator(elliptic, static_cast<const occa::memory>(o_Mv), o_w, dfloatString);
+
+      reduce(j, o_w);
+
+      const dfloat *a = red.data();
+      const dfloat *c = red.data() + j;
+      const dfloat utu = red[2 * j];
+      const dfloat utw = red[2 * j + 1];
+      const dfloat wtw = red[2 * j + 2];
+
+      dfloat ata = 0;
+      dfloat atc = 0;
+      for (int k = 0; k < j; ++k) {
+        ata += a[k] * a[k];
+        atc += a[k] * c[k];
+      }
+      const dfloat beta = sqrt(std::max(utu - ata, tiny));
+
+      if (j == 0) {
+        s[0] = beta;
+      } else if (!corrected) {
+        // finalize column j-1 with the reorthogonalization coefficients and the exact norm
+        for (int k = 0; k < j; ++k)
+          Hraw[k + (j - 1) * ld] += a[k];
+        Hraw[j + (j - 1) * ld] = beta;
+
+        s[j - 1] = sTentative;
+        applyGivens(gmresData, j - 1);
+      }
+
+      // g = Hraw(0:j,0:j-1) a
+      for (int r = 0; r <= j; ++r) {
+        g[r] = 0;
+        for (int k = std::max(r - 1, 0); k < j; ++k)
+          g[r] += Hraw[r + k * ld] * a[k];
+      }
+
+      // estimate of column j from the lagged quantities
+      const dfloat vtw = (utw - atc) / beta;
+      dfloat wPrimeNorm2 = wtw + g[j] * (g[j] - 2 * vtw);
+      for (int k = 0; k < j; ++k) {
+        h[k] = (c[k] - g[k]) / beta;
+        wPrimeNorm2 += g[k] * (g[k] - 2 * c[k]);
+      }
+      h[j] = (vtw - g[j]) / beta;
+      wPrimeNorm2 /= beta * beta;
+
+      dfloat hth = 0;
+      for (int k = 0; k <= j; ++k) {
+        hth += h[k] * h[k];
+        Hraw[k + j * ld] = h[k];
+      }
+      Hraw[j + 1 + j * ld] = sqrt(std::max(wPrimeNorm2 - hth, static_cast<dfloat>(0)));
+
+      sTentative = s[j];
+      applyGivens(gmresData, j);
+
+      iter++;
+      error = fabs(s[j + 1]) * sqrt(elliptic->resNormFactor);
+      rdotr = error;
+
+      if (platform->comm.mpiRank == 0)
+        nrsCheck(std::isnan(error),
+                 MPI_COMM_SELF,
+                 EXIT_FAILURE,
+                 "%s\n",
+                 "Detected invalid resiual norm while running linear solver!");
+
+      if (verbose && (platform->comm.mpiRank == 0))
+        printf("it %d r norm %.15e\n", iter, rdotr);
+
+      // tentative, confirmed below with the corrected column
+      done = (error < TOL || iter == MAXIT);
+
+      // V(:,j) = (u - Qa)/beta, V(:,j+1) = (w - V y)/beta with y = g + beta h
+      for (int k = 0; k < j; ++k)
+        coeffs[k] = a[k];
+      for (int k = 0; k <= j; ++k)
+        coeffs[j + k] = g[k] + beta * h[k];
+      o_coeffs.copyFrom(coeffs, 2 * j + 1);
+
+      elliptic->lowSyncGMRESOrthogonalizationKernel(mesh->Nlocal,
+                                                    elliptic->fieldOffset,
+                                                    j,
+                                                    static_cast<dfloat>(1 / beta),
+                                                    static_cast<dlong>(1),
+                                                    o_coeffs,
+                                                    o_coeffs + j,
+                                                    o_w,
+                                                    o_V);
+      if (flexible) {
+        elliptic->lowSyncGMRESOrthogonalizationKernel(mesh->Nlocal,
+                                                      elliptic->fieldOffset,
+                                                      j,
+                                                      static_cast<dfloat>(1 / beta),
+                                                      static_cast<dlong>(0),
+                                                      o_coeffs,
+                                                      o_coeffs + j,
+                                                      o_w,
+                                                      o_Z);
+      }
+
+      {
+        double flopCount = 2 * (2 * j + 1) * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+        platform->flopCounter->add("lowSyncGMRESOrthogonalization", flopCount);
+      }
+
+      // column j is only an estimate, correct it with the reorthogonalization
+      // coefficients of the next candidate before updating the solution
+      // w is stale at this point, pass the new candidate instead (only its dots are used)
+      corrected = done || j == nRestartVectors - 1;
+      if (corrected) {
+        auto o_u = o_V + (j + 1) * offset;
+        reduce(j + 1, o_u);
+
+        dfloat ata = 0;
+        for (int k = 0; k <= j; ++k) {
+          Hraw[k + j * ld] += red[k];
+          ata += red[k] * red[k];
+        }
+        Hraw[j + 1 + j * ld] = sqrt(std::max(red[2 * (j + 1)] - ata, tiny));
+
+        s[j] = sTentative;
+        applyGivens(gmresData, j);
+
+        error = fabs(s[j + 1]) * sqrt(elliptic->resNormFactor);
+        rdotr = error;
+        done = (error < TOL || iter == MAXIT);
+      }
+
+      if (done) {
+        gmresUpdate(elliptic, o_x, j + 1);
+        break;
+      }
+    }
+
+    if (done)
+      break;
+
+    // update approximation
+    gmresUpdate(elliptic, o_x, nRestartVectors);
+
+    // restart with the true residual
+    ellipticOperator(elliptic, o_x, o_Ax, dfloatString);
+
+    elliptic->fusedResidualAndNormKernel(Nblock,
+                                         mesh->Nlocal,
+                                         elliptic->fieldOffset,
+                                         elliptic->o_invDegree,
+                                         o_b,
+                                         o_Ax,
+                                         o_r,
+                                         gmresData->o_scratch);
+
+    dfloat nr = 0.0;
+    if (serial) {
+      nr = *((dfloat *)gmresData->o_scratch.ptr());
+    }
+    else {
+      gmresData->o_scratch.copyTo(scratch, Nblock);
+      for (dlong n = 0; n < Nblock; ++n)
+        nr += scratch[n];
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &nr, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+    nr = sqrt(nr);
+
+    {
+      double flopCount = 4 * elliptic->Nfields * static_cast<double>(mesh->Nlocal);
+      platform->flopCounter->add("gmres evaluate residual and norm", flopCount);
+    }
+
+    error = nr * sqrt(elliptic->resNormFactor);
+    rdotr = error;
+    if (error <= TOL)
+      break;
+  }
+
+  free(elliptic);
+  return iter;
+}
+} // namespace
+
 // Ax=r
 int pgmres(elliptic_t *elliptic,
            const dfloat tol,
@@ -118,6 +475,10 @@ int pgmres(elliptic_t *elliptic,
            occa::memory &o_r,
            occa::memory &o_x)
 {
+  if (elliptic->options.compareArgs("SOLVER", "LOWSYNC"))
+    return lowSyncPgmres(elliptic, tol, MAXIT, rdotr, o_r, o_x);
+  if (elliptic->options.compareArgs("SOLVER", "RECYCLE"))
+    return gcrodr(elliptic, tol, MAXIT, rdotr, o_r, o_x);
 
   mesh_t *mesh = elliptic->mesh;
   linAlg_t &linAlg = *(platform->linAlg);
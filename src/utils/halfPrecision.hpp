@@ -0,0 +1,59 @@
+#ifndef HALFPRECISION_HPP
+#define HALFPRECISION_HPP
+
+#include <cstdint>
+#include <cstring>
+
+// IEEE binary16 with round to nearest even, overflow maps to inf
+inline uint16_t floatToHalf(float f)
+{
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(float));
+
+  const uint16_t sign = (x >> 16) & 0x8000;
+  const int32_t exponent = static_cast<int32_t>((x >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = x & 0x7fffff;
+
+  if (((x >> 23) & 0xff) == 0xff) {
+    return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+  }
+  if (exponent >= 31) {
+    return sign | 0x7c00;
+  }
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const int shift = 14 - exponent;
+    uint32_t h = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (h & 1))) {
+      h++;
+    }
+    return sign | h;
+  }
+
+  uint32_t h = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (h & 1))) {
+    h++; // a carry into the exponent is the correct rounding
+  }
+  return sign | h;
+}
+
+// bfloat16 (upper half of binary32) with round to nearest even
+inline uint16_t floatToBfloat16(float f)
+{
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(float));
+
+  if ((x & 0x7fffffff) > 0x7f800000) {
+    return (x >> 16) | 0x40; // quiet NaN
+  }
+  x += 0x7fff + ((x >> 16) & 1);
+  return x >> 16;
+}
+
+#endif